@@ -10,6 +10,7 @@ var kmap_components = // Curiously, failure occurs if `const` used instead of `v
 ,   "database"
 ,   "database.filesystem"
 ,   "database.filesystem.command"
+,   "database.option"
 ,   "event_store"
 ,   "filesystem"
 ,   "jump_stack"
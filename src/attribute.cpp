@@ -14,7 +14,6 @@
 #include "path/node_view2.hpp"
 #include "utility.hpp"
 
-#include <range/v3/algorithm/count.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/join.hpp>
 #include <range/v3/view/remove.hpp>
@@ -77,27 +76,12 @@ auto is_in_order( Kmap const& kmap
 {
     KM_RESULT_PROLOG();
 
-    auto rv = false;
     auto const nw = KTRYE( kmap.fetch_component< com::Network >() );
+    auto const db = KTRYE( kmap.fetch_component< com::Database >() );
     auto const rparent = nw->resolve( parent );
     auto const rchild = nw->resolve( child );
 
-    if( auto const ordern = anchor::node( rparent )
-                          | view2::attr
-                          | view2::child( "order" )
-                          | act2::fetch_node( kmap ) )
-    {
-        if( auto const ob = nw->fetch_body( ordern.value() )
-          ; ob )
-        {
-            auto const split = ob.value()
-                             | views::split( '\n' )
-                             | to< std::vector< std::string > >();
-            rv = ( 0 != ranges::count( split, to_string( rchild ) ) );
-        }
-    }
-
-    return rv;
+    return db->fetch_order_position( rparent, rchild ).has_value();
 }
 
 auto push_genesis( Kmap& kmap
@@ -40,6 +40,7 @@
 #include <sqlpp11/sqlite3/insert_or.h>
 #include <sqlpp11/sqlpp11.h>
 
+#include <charconv>
 #include <map>
 
 namespace fs = boost::filesystem;
@@ -52,6 +53,68 @@ namespace kmap::repair {
 
 namespace {
 
+/**
+ * @brief Renders a stored UUID as text, the form repair reasons in. A malformed BLOB is rendered as "0x"-prefixed hex, so it can still be reported and erased.
+ */
+auto as_text( db::Blob const& blob )
+    -> std::string
+{
+    if( auto const id = db::uuid_from_blob( blob )
+      ; id )
+    {
+        return to_string( id.value() );
+    }
+    else
+    {
+        auto rv = std::string{ "0x" };
+
+        for( auto const b : blob )
+        {
+            rv += fmt::format( "{:02x}", b );
+        }
+
+        return rv;
+    }
+}
+
+/**
+ * @brief Inverse of as_text. Text that is neither a UUID nor hex maps to an empty BLOB, which matches no stored UUID.
+ */
+auto as_blob( std::string const& id )
+    -> db::Blob
+{
+    if( auto const uid = uuid_from_string( id )
+      ; uid )
+    {
+        return db::to_blob( uid.value() );
+    }
+    else if( id.starts_with( "0x" ) && id.size() % 2 == 0 )
+    {
+        auto rv = db::Blob{};
+
+        for( auto i = std::size_t{ 2 }
+           ; i < id.size()
+           ; i += 2 )
+        {
+            auto byte = std::uint8_t{};
+
+            if( auto const [ ptr, ec ] = std::from_chars( id.data() + i, id.data() + i + 2, byte, 16 )
+              ; ec != std::errc{} )
+            {
+                return {};
+            }
+
+            rv.emplace_back( byte );
+        }
+
+        return rv;
+    }
+    else
+    {
+        return {};
+    }
+}
+
 template< typename CheckFn
         , typename RepairFn >
 auto repair_missing_entry( com::Database& db
@@ -224,51 +287,51 @@ auto check_ids_for_valid_format( sql::connection& con
     check( headings::headings{}
          , "headings"
          , std::set< std::string >{}
-         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( e.uuid ); }
-         , [ & ]( auto const& e ){ return check_id( e.uuid ); }
-         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.uuid == e ) ); } );
+         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( as_text( e.uuid.value() ) ); }
+         , [ & ]( auto const& e ){ return check_id( as_text( e.uuid.value() ) ); }
+         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.uuid == as_blob( e ) ) ); } );
     check( titles::titles{}
          , "titles"
          , std::set< std::string >{}
-         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( e.uuid ); }
-         , [ & ]( auto const& e ){ return check_id( e.uuid ); }
-         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.uuid == e ) ); } );
+         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( as_text( e.uuid.value() ) ); }
+         , [ & ]( auto const& e ){ return check_id( as_text( e.uuid.value() ) ); }
+         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.uuid == as_blob( e ) ) ); } );
     check( bodies::bodies{}
          , "bodies"
          , std::set< std::string >{}
-         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( e.uuid ); }
-         , [ & ]( auto const& e ){ return check_id( e.uuid ); }
-         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.uuid == e ) ); } );
+         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( as_text( e.uuid.value() ) ); }
+         , [ & ]( auto const& e ){ return check_id( as_text( e.uuid.value() ) ); }
+         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.uuid == as_blob( e ) ) ); } );
     check( children::children{}
          , "children"
          , std::set< std::pair< std::string, std::string > >{}
-         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( std::pair{ e.parent_uuid, e.child_uuid } ); }
-         , [ & ]( auto const& e ){ return check_id( e.parent_uuid ) && check_id( e.child_uuid ); }
-         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.parent_uuid == e.first && table.child_uuid == e.second ) ); } );
+         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( std::pair{ as_text( e.parent_uuid.value() ), as_text( e.child_uuid.value() ) } ); }
+         , [ & ]( auto const& e ){ return check_id( as_text( e.parent_uuid.value() ) ) && check_id( as_text( e.child_uuid.value() ) ); }
+         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.parent_uuid == as_blob( e.first ) && table.child_uuid == as_blob( e.second ) ) ); } );
     check( aliases::aliases{}
          , "aliases"
          , std::set< std::pair< std::string, std::string > >{}
-         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( std::pair{ e.src_uuid, e.dst_uuid } ); }
-         , [ & ]( auto const& e ){ return check_id( e.src_uuid ) && check_id( e.dst_uuid ); }
-         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.src_uuid == e.first && table.dst_uuid == e.second ) ); } );
+         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( std::pair{ as_text( e.src_uuid.value() ), as_text( e.dst_uuid.value() ) } ); }
+         , [ & ]( auto const& e ){ return check_id( as_text( e.src_uuid.value() ) ) && check_id( as_text( e.dst_uuid.value() ) ); }
+         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.src_uuid == as_blob( e.first ) && table.dst_uuid == as_blob( e.second ) ) ); } );
     check( attributes::attributes{}
          , "attributes"
          , std::set< std::pair< std::string, std::string > >{}
-         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( std::pair{ e.parent_uuid, e.child_uuid } ); }
-         , [ & ]( auto const& e ){ return check_id( e.parent_uuid ) && check_id( e.child_uuid ); }
-         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.parent_uuid == e.first && table.child_uuid == e.second ) ); } );
+         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( std::pair{ as_text( e.parent_uuid.value() ), as_text( e.child_uuid.value() ) } ); }
+         , [ & ]( auto const& e ){ return check_id( as_text( e.parent_uuid.value() ) ) && check_id( as_text( e.child_uuid.value() ) ); }
+         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.parent_uuid == as_blob( e.first ) && table.child_uuid == as_blob( e.second ) ) ); } );
     check( resources::resources{}
          , "resources"
          , std::set< std::string >{}
-         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( e.uuid ); }
-         , [ & ]( auto const& e ){ return check_id( e.uuid ); }
-         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.uuid == e ) ); } );
+         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( as_text( e.uuid.value() ) ); }
+         , [ & ]( auto const& e ){ return check_id( as_text( e.uuid.value() ) ); }
+         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.uuid == as_blob( e ) ) ); } );
     check( nodes::nodes{}
          , "nodes"
          , std::set< std::string >{}
-         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( e.uuid ); }
-         , [ & ]( auto const& e ){ return check_id( e.uuid ); }
-         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.uuid == e ) ); } );
+         , [ & ]( auto& fs, auto const& e ){ return fs.emplace( as_text( e.uuid.value() ) ); }
+         , [ & ]( auto const& e ){ return check_id( as_text( e.uuid.value() ) ); }
+         , [ & ]( auto table, auto e ) mutable { con( remove_from( table ).where( table.uuid == as_blob( e ) ) ); } );
 
     if( alls_well )
     {
@@ -301,7 +364,7 @@ auto check_all_against_node_table( sql::connection& con
                             . unconditionally() )
            ; auto const& e : rows )
         {
-            rv.emplace( std::string{ e.uuid } );
+            rv.emplace( as_text( e.uuid.value() ) );
         }
         return rv;
     }();
@@ -311,14 +374,14 @@ auto check_all_against_node_table( sql::connection& con
         for( auto rows = con( select( all_of( tbl ) ).from( tbl ).unconditionally() )
            ; auto const& e : rows )
         {
-            if( !( all_nodes.contains( std::string{ e.uuid } ) ) )
+            if( !( all_nodes.contains( as_text( e.uuid.value() ) ) ) )
             {
                 io::print( "[log][error] Abnormality detected: ({}) does not correspond to any entry in nodes table\n"
-                         , std::string{ e.uuid } );
+                         , as_text( e.uuid.value() ) );
 
                 if( fix )
                 {
-                    repair_set.emplace( e.uuid );
+                    repair_set.emplace( as_text( e.uuid.value() ) );
                 }
                 else
                 {
@@ -341,28 +404,28 @@ auto check_all_against_node_table( sql::connection& con
         for( auto rows = con( select( all_of( tbl ) ).from( tbl ).unconditionally() )
            ; auto const& e : rows )
         {
-            if( !( all_nodes.contains( std::string{ e.parent_uuid } ) ) )
+            if( !( all_nodes.contains( as_text( e.parent_uuid.value() ) ) ) )
             {
                 io::print( "[log][error] Abnormality detected: child:({}) does not correspond to any entry in nodes table\n"
-                         , std::string{ e.parent_uuid } );
+                         , as_text( e.parent_uuid.value() ) );
 
                 if( fix )
                 {
-                    repair_set.emplace( e.parent_uuid );
+                    repair_set.emplace( as_text( e.parent_uuid.value() ) );
                 }
                 else
                 {
                     alls_well = false;
                 }
             }
-            if( !( all_nodes.contains( std::string{ e.child_uuid } ) ) )
+            if( !( all_nodes.contains( as_text( e.child_uuid.value() ) ) ) )
             {
                 io::print( "[log][error] Abnormality detected: child:({}) does not correspond to any entry in nodes table\n"
-                         , std::string{ e.child_uuid } );
+                         , as_text( e.child_uuid.value() ) );
 
                 if( fix )
                 {
-                    repair_set.emplace( e.child_uuid );
+                    repair_set.emplace( as_text( e.child_uuid.value() ) );
                 }
                 else
                 {
@@ -379,28 +442,28 @@ auto check_all_against_node_table( sql::connection& con
         for( auto rows = con( select( all_of( tbl ) ).from( tbl ).unconditionally() )
            ; auto const& e : rows )
         {
-            if( !( all_nodes.contains( std::string{ e.src_uuid } ) ) )
+            if( !( all_nodes.contains( as_text( e.src_uuid.value() ) ) ) )
             {
                 io::print( "[log][error] Abnormality detected: alias src:({}) does not correspond to any entry in nodes table\n"
-                         , std::string{ e.src_uuid } );
+                         , as_text( e.src_uuid.value() ) );
 
                 if( fix )
                 {
-                    repair_set.emplace( e.src_uuid );
+                    repair_set.emplace( as_text( e.src_uuid.value() ) );
                 }
                 else
                 {
                     alls_well = false;
                 }
             }
-            if( !( all_nodes.contains( std::string{ e.dst_uuid } ) ) )
+            if( !( all_nodes.contains( as_text( e.dst_uuid.value() ) ) ) )
             {
                 io::print( "[log][error] Abnormality detected: alias dst:({}) does not correspond to any entry in nodes table\n"
-                         , std::string{ e.dst_uuid } );
+                         , as_text( e.dst_uuid.value() ) );
 
                 if( fix )
                 {
-                    repair_set.emplace( e.dst_uuid );
+                    repair_set.emplace( as_text( e.dst_uuid.value() ) );
                 }
                 else
                 {
@@ -418,28 +481,28 @@ auto check_all_against_node_table( sql::connection& con
         for( auto rows = con( select( all_of( tbl ) ).from( tbl ).unconditionally() )
            ; auto const& e : rows )
         {
-            if( !( all_nodes.contains( std::string{ e.parent_uuid } ) ) )
+            if( !( all_nodes.contains( as_text( e.parent_uuid.value() ) ) ) )
             {
                 io::print( "[log][error] Abnormality detected: attribute parent:({}) does not correspond to any entry in nodes table\n"
-                         , std::string{ e.parent_uuid } );
+                         , as_text( e.parent_uuid.value() ) );
 
                 if( fix )
                 {
-                    repair_set.emplace( e.parent_uuid );
+                    repair_set.emplace( as_text( e.parent_uuid.value() ) );
                 }
                 else
                 {
                     alls_well = false;
                 }
             }
-            if( !( all_nodes.contains( std::string{ e.child_uuid } ) ) )
+            if( !( all_nodes.contains( as_text( e.child_uuid.value() ) ) ) )
             {
                 io::print( "[log][error] Abnormality detected: attribute child:({}) does not correspond to any entry in nodes table\n"
-                         , std::string{ e.child_uuid } );
+                         , as_text( e.child_uuid.value() ) );
 
                 if( fix )
                 {
-                    repair_set.emplace( e.child_uuid );
+                    repair_set.emplace( as_text( e.child_uuid.value() ) );
                 }
                 else
                 {
@@ -482,7 +545,7 @@ auto fetch_unbegotten_nodes( sql::connection& con )
                             . unconditionally() )
             ; auto const& e : rows )
         {
-            all_nodes.emplace( KTRY( uuid_from_string( std::string{ e.uuid } ) ) );
+            all_nodes.emplace( KTRY( db::uuid_from_blob( e.uuid.value() ) ) );
         }
     }
     {
@@ -492,7 +555,7 @@ auto fetch_unbegotten_nodes( sql::connection& con )
                             . unconditionally() )
             ; auto const& e : rows )
         {
-            all_children.emplace( KTRY( uuid_from_string( std::string{ e.child_uuid } ) ) );
+            all_children.emplace( KTRY( db::uuid_from_blob( e.child_uuid.value() ) ) );
         }
     }
     {
@@ -502,7 +565,7 @@ auto fetch_unbegotten_nodes( sql::connection& con )
                             . unconditionally() )
             ; auto const& e : rows )
         {
-            all_attrs.emplace( KTRY( uuid_from_string( std::string{ e.child_uuid } ) ) );
+            all_attrs.emplace( KTRY( db::uuid_from_blob( e.child_uuid.value() ) ) );
         }
     }
 
@@ -536,11 +599,11 @@ auto erase_node( sql::connection& con
     {
         auto attrs = [ & ]
         {
-            auto rows = con( select( all_of( att ) ).from( att ).where( att.parent_uuid == node ) );
+            auto rows = con( select( all_of( att ) ).from( att ).where( att.parent_uuid == as_blob( node ) ) );
             auto rs = std::set< std::string >{};
             for( auto const& row : rows )
             {
-                rs.emplace( row.child_uuid );
+                rs.emplace( as_text( row.child_uuid.value() ) );
             }
             return rs;
         }();
@@ -554,11 +617,11 @@ auto erase_node( sql::connection& con
     {
         auto children = [ & ]
         {
-            auto rows = con( select( all_of( ct ) ).from( ct ).where( ct.parent_uuid == node ) );
+            auto rows = con( select( all_of( ct ) ).from( ct ).where( ct.parent_uuid == as_blob( node ) ) );
             auto rs = std::set< std::string >{};
             for( auto const& row : rows )
             {
-                rs.emplace( row.child_uuid );
+                rs.emplace( as_text( row.child_uuid.value() ) );
             }
             return rs;
         }();
@@ -571,17 +634,17 @@ auto erase_node( sql::connection& con
 
     // Erase node from all tables.
     // We are erasing leaves here. So that needs to be kept in mind when considering which table entries to erase.
-    con( remove_from( bt ).where( bt.uuid == node ) );
-    con( remove_from( ht ).where( ht.uuid == node ) );
-    con( remove_from( rt ).where( rt.uuid == node ) );
-    con( remove_from( tt ).where( tt.uuid == node ) );
-    con( remove_from( at ).where( at.src_uuid == node ) );
-    con( remove_from( at ).where( at.dst_uuid == node ) );
-    con( remove_from( ct ).where( ct.child_uuid == node ) );
-    con( remove_from( ct ).where( ct.parent_uuid == node ) );
-    con( remove_from( att ).where( att.child_uuid == node ) );
-    con( remove_from( att ).where( att.parent_uuid == node ) );
-    con( remove_from( nt ).where( nt.uuid == node ) );
+    con( remove_from( bt ).where( bt.uuid == as_blob( node ) ) );
+    con( remove_from( ht ).where( ht.uuid == as_blob( node ) ) );
+    con( remove_from( rt ).where( rt.uuid == as_blob( node ) ) );
+    con( remove_from( tt ).where( tt.uuid == as_blob( node ) ) );
+    con( remove_from( at ).where( at.src_uuid == as_blob( node ) ) );
+    con( remove_from( at ).where( at.dst_uuid == as_blob( node ) ) );
+    con( remove_from( ct ).where( ct.child_uuid == as_blob( node ) ) );
+    con( remove_from( ct ).where( ct.parent_uuid == as_blob( node ) ) );
+    con( remove_from( att ).where( att.child_uuid == as_blob( node ) ) );
+    con( remove_from( att ).where( att.parent_uuid == as_blob( node ) ) );
+    con( remove_from( nt ).where( nt.uuid == as_blob( node ) ) );
 
     // Note: What about relation info, such as <parent>.$.order? I think this can all be accounted for when traversal is done.
     // Such as to leave the map a corrupted state which will be automatically fixed later.
@@ -657,7 +720,7 @@ auto check_multiparent( sql::connection& con
     // TODO: This should combine children and attributes, as a node can't legally be in both.
     // children
     {
-        auto rows = con( select( all_of( ct ) ).from( ct ).where( ct.child_uuid == node ) );
+        auto rows = con( select( all_of( ct ) ).from( ct ).where( ct.child_uuid == as_blob( node ) ) );
 
         if( std::distance( rows.begin(), rows.end() ) > 1 )
         {
@@ -669,7 +732,7 @@ auto check_multiparent( sql::connection& con
     }
     // attributes
     {
-        auto rows = con( select( all_of( att ) ).from( att ).where( att.child_uuid == node ) );
+        auto rows = con( select( all_of( att ) ).from( att ).where( att.child_uuid == as_blob( node ) ) );
 
         if( std::distance( rows.begin(), rows.end() ) > 1 )
         {
@@ -689,6 +752,7 @@ auto check_multiparent( sql::connection& con
 }
 
 auto check_heading( sql::connection& con
+                  , db::StatementCache& stmts
                   , std::string const& node
                   , bool fix )
     -> Result< void >
@@ -701,7 +765,7 @@ auto check_heading( sql::connection& con
     
     // Heading exists
     {
-        auto rows = con( select( all_of( ht ) ).from( ht ).where( ht.uuid == node ) );
+        auto rows = con( select( all_of( ht ) ).from( ht ).where( ht.uuid == as_blob( node ) ) );
 
         if( std::distance( rows.begin(), rows.end() ) != 1 )
         {
@@ -713,7 +777,7 @@ auto check_heading( sql::connection& con
         else
         {
             // Heading had valid format
-            auto const heading = KTRYE( com::db::select_heading( con, node ) );
+            auto const heading = KTRYE( com::db::select_heading( con, stmts, node ) );
 
             if( !is_valid_heading( heading ) )
             {
@@ -728,7 +792,7 @@ auto check_heading( sql::connection& con
                                 , heading 
                                 , fixed_heading );
                     
-                    con( insert_or_replace_into( ht ).set( ht.uuid = node, ht.heading = fixed_heading ) );
+                    con( insert_or_replace_into( ht ).set( ht.uuid = as_blob( node ), ht.heading = fixed_heading ) );
                 }
                 else
                 {
@@ -747,6 +811,7 @@ auto check_heading( sql::connection& con
 }
 
 auto check_heading_conflict( sql::connection& con
+                           , db::StatementCache& stmts
                            , std::string const& node
                            , bool fix )
     -> Result< void >
@@ -763,29 +828,29 @@ auto check_heading_conflict( sql::connection& con
         {
             auto rmap = std::multimap< std::string, std::string >{};
 
-            if( auto const parent = com::db::select_parent( con, node )
+            if( auto const parent = com::db::select_parent( con, stmts, node )
               ; parent )
             {
-                for( auto const siblings = KTRYE( com::db::select_children( con, parent.value() ) )
+                for( auto const siblings = KTRYE( com::db::select_children( con, stmts, parent.value() ) )
                    ; auto const& sibling : siblings )
                 {
-                    for( auto rows = con( select( all_of( ht ) ).from( ht ).where( ht.uuid == sibling ) )
+                    for( auto rows = con( select( all_of( ht ) ).from( ht ).where( ht.uuid == as_blob( sibling ) ) )
                        ; auto const& row : rows )
                     {
-                        rmap.emplace( row.heading, row.uuid );
+                        rmap.emplace( row.heading, as_text( row.uuid.value() ) );
                     }
                 }
             }
-            else if( auto const parent = com::db::select_attr_parent( con, node )
+            else if( auto const parent = com::db::select_attr_parent( con, stmts, node )
                    ; parent )
             {
-                for( auto const siblings = KTRYE( com::db::select_attributes( con, parent.value() ) )
+                for( auto const siblings = KTRYE( com::db::select_attributes( con, stmts, parent.value() ) )
                    ; auto const& sibling : siblings )
                 {
-                    for( auto rows = con( select( all_of( ht ) ).from( ht ).where( ht.uuid == sibling ) )
+                    for( auto rows = con( select( all_of( ht ) ).from( ht ).where( ht.uuid == as_blob( sibling ) ) )
                        ; auto const& row : rows )
                     {
-                        rmap.emplace( row.heading, row.uuid );
+                        rmap.emplace( row.heading, as_text( row.uuid.value() ) );
                     }
                 }
             }
@@ -796,7 +861,7 @@ auto check_heading_conflict( sql::connection& con
 
             return rmap;
         }();
-        auto const node_heading = KTRYE( com::db::select_heading( con, node ) );
+        auto const node_heading = KTRYE( com::db::select_heading( con, stmts, node ) );
         auto const& [ rb, re ] = headings.equal_range( node_heading );
 
         if( std::distance( rb, re ) != 1 )
@@ -819,7 +884,7 @@ auto check_heading_conflict( sql::connection& con
                                                         , node_heading
                                                         , dist );
 
-                    con( insert_or_replace_into( ht ).set( ht.uuid = it->second, ht.heading = new_heading ) );
+                    con( insert_or_replace_into( ht ).set( ht.uuid = as_blob( it->second ), ht.heading = new_heading ) );
                 }
             }
             else
@@ -851,7 +916,7 @@ auto check_body( sql::connection& con
     
     {
         // No specific formatting for title, so just ensure that the node has a title.
-        auto rows = con( select( all_of( bt ) ).from( bt ).where( bt.uuid == node ) );
+        auto rows = con( select( all_of( bt ) ).from( bt ).where( bt.uuid == as_blob( node ) ) );
 
         if( std::distance( rows.begin(), rows.end() ) > 1 )
         {
@@ -882,7 +947,7 @@ auto check_title( sql::connection& con
     auto tt = titles::titles{};
     
     {
-        auto rows = con( select( all_of( tt ) ).from( tt ).where( tt.uuid == node ) );
+        auto rows = con( select( all_of( tt ) ).from( tt ).where( tt.uuid == as_blob( node ) ) );
 
         if( auto const count = std::distance( rows.begin(), rows.end() )
           ; count != 1 )
@@ -904,6 +969,7 @@ auto check_title( sql::connection& con
 }
 
 auto check_has_no_attr( sql::connection& con
+                      , db::StatementCache& stmts
                       , std::string const& node
                       , bool fix )
     -> Result< void >
@@ -913,7 +979,7 @@ auto check_has_no_attr( sql::connection& con
     auto rv = result::make_result< void >();
     auto alls_well = true;
 
-    if( auto const attrs = com::db::select_attributes( con, node )
+    if( auto const attrs = com::db::select_attributes( con, stmts, node )
       ; attrs && attrs.value().size() > 0 )
     {
         io::print( "[log][error] Abnormality detected: attribute node has attribute for node: '{}'\n"
@@ -944,6 +1010,7 @@ auto check_has_no_attr( sql::connection& con
 }
 
 auto push_attr( sql::connection& con
+              , db::StatementCache& stmts
               , std::string const& node
               , std::string const& attrn )
     -> Result< void >
@@ -953,10 +1020,10 @@ auto push_attr( sql::connection& con
     auto rv = result::make_result< void >();
     auto ct = children::children{};
 
-    if( auto const attroot = com::db::select_attribute_root( con, node )
+    if( auto const attroot = com::db::select_attribute_root( con, stmts, node )
       ; attroot )
     {
-        con( insert_into( ct ).set( ct.parent_uuid = attroot.value(), ct.child_uuid = attrn ) );
+        con( insert_into( ct ).set( ct.parent_uuid = as_blob( attroot.value() ), ct.child_uuid = as_blob( attrn ) ) );
     }
     else
     {
@@ -965,10 +1032,10 @@ auto push_attr( sql::connection& con
         auto tt = titles::titles{};
         auto const nattroot = to_string( gen_uuid() );
 
-        con( insert_into( att ).set( att.parent_uuid = node, att.child_uuid = nattroot ) );
-        con( insert_into( ht ).set( ht.uuid = nattroot, ht.heading = "$" ) );
-        con( insert_into( tt ).set( tt.uuid = nattroot, tt.title = "$" ) );
-        con( insert_into( ct ).set( ct.parent_uuid = nattroot, ct.child_uuid = attrn ) );
+        con( insert_into( att ).set( att.parent_uuid = as_blob( node ), att.child_uuid = as_blob( nattroot ) ) );
+        con( insert_into( ht ).set( ht.uuid = as_blob( nattroot ), ht.heading = "$" ) );
+        con( insert_into( tt ).set( tt.uuid = as_blob( nattroot ), tt.title = "$" ) );
+        con( insert_into( ct ).set( ct.parent_uuid = as_blob( nattroot ), ct.child_uuid = as_blob( attrn ) ) );
     }
 
     rv = outcome::success();
@@ -978,6 +1045,7 @@ auto push_attr( sql::connection& con
 
 // TODO: I believe this is the last remaining thing to impl. for repair.
 auto check_genesis( sql::connection& con
+                  , db::StatementCache& stmts
                   , std::string const& node
                   , bool fix )
     -> Result< void >
@@ -990,11 +1058,11 @@ auto check_genesis( sql::connection& con
     auto tt = titles::titles{};
     auto bt = bodies::bodies{};
     auto alls_well = true;
-    auto const attrs = KTRYE( com::db::select_attributes( con, node ) );
+    auto const attrs = KTRYE( com::db::select_attributes( con, stmts, node ) );
     auto const attr_headings = attrs
-                             | rvs::transform( [ & ]( auto const& e ){ return std::pair{ KTRYE( com::db::select_heading( con, e ) ), e }; } )
+                             | rvs::transform( [ & ]( auto const& e ){ return std::pair{ KTRYE( com::db::select_heading( con, stmts, e ) ), e }; } )
                              | ranges::to< std::map< std::string, std::string > >();
-    auto const children = KTRYE( com::db::select_children( con, node ) );
+    auto const children = KTRYE( com::db::select_children( con, stmts, node ) );
 
     // $.genesis
     if( !attr_headings.contains( "genesis" ) )
@@ -1009,12 +1077,12 @@ auto check_genesis( sql::connection& con
 
             auto const genesisn = to_string( gen_uuid() );
 
-            con( insert_into( nt ).set( nt.uuid = genesisn ) );
-            con( insert_into( ht ).set( ht.uuid = genesisn, ht.heading = "genesis" ) );
-            con( insert_into( tt ).set( tt.uuid = genesisn, tt.title = "Genesis" ) );
-            con( insert_into( bt ).set( bt.uuid = genesisn, bt.body = std::to_string( present_time() ) ) );
+            con( insert_into( nt ).set( nt.uuid = as_blob( genesisn ) ) );
+            con( insert_into( ht ).set( ht.uuid = as_blob( genesisn ), ht.heading = "genesis" ) );
+            con( insert_into( tt ).set( tt.uuid = as_blob( genesisn ), tt.title = "Genesis" ) );
+            con( insert_into( bt ).set( bt.uuid = as_blob( genesisn ), bt.body = std::to_string( present_time() ) ) );
 
-            KTRY( push_attr( con, node, genesisn ) );
+            KTRY( push_attr( con, stmts, node, genesisn ) );
         }
         else
         {
@@ -1031,6 +1099,7 @@ auto check_genesis( sql::connection& con
 }
 
 auto check_order( sql::connection& con
+                , db::StatementCache& stmts
                 , std::string const& node
                 , bool fix )
     -> Result< void >
@@ -1043,14 +1112,14 @@ auto check_order( sql::connection& con
     auto bt = bodies::bodies{};
     auto tt = titles::titles{};
     auto alls_well = true;
-    auto const attrs = KTRYE( com::db::select_attributes( con, node ) );
+    auto const attrs = KTRYE( com::db::select_attributes( con, stmts, node ) );
     auto const attr_headings = attrs
-                             | rvs::transform( [ & ]( auto const& e ){ return std::pair{ KTRYE( com::db::select_heading( con, e ) ), e }; } )
+                             | rvs::transform( [ & ]( auto const& e ){ return std::pair{ KTRYE( com::db::select_heading( con, stmts, e ) ), e }; } )
                              | ranges::to< std::map< std::string, std::string > >();
     auto const children = [ & ]
     {
-        auto as = KTRYE( com::db::select_aliases( con, node ) );
-        auto cs = KTRYE( com::db::select_children( con, node ) );
+        auto as = KTRYE( com::db::select_aliases( con, stmts, node ) );
+        auto cs = KTRYE( com::db::select_children( con, stmts, node ) );
         cs.insert( as.begin(), as.end() );
         return cs;
     }();
@@ -1070,12 +1139,12 @@ auto check_order( sql::connection& con
             auto const body = children | rvs::join( '\n' ) | ranges::to< std::string >(); //[ & ]
             auto const ordern = to_string( gen_uuid() );
 
-            con( insert_into( nt ).set( nt.uuid = ordern ) );
-            con( insert_into( ht ).set( ht.uuid = ordern, ht.heading = "order" ) );
-            con( insert_into( tt ).set( tt.uuid = ordern, tt.title = "Order" ) );
-            con( insert_into( bt ).set( bt.uuid = ordern, bt.body = body ) );
+            con( insert_into( nt ).set( nt.uuid = as_blob( ordern ) ) );
+            con( insert_into( ht ).set( ht.uuid = as_blob( ordern ), ht.heading = "order" ) );
+            con( insert_into( tt ).set( tt.uuid = as_blob( ordern ), tt.title = "Order" ) );
+            con( insert_into( bt ).set( bt.uuid = as_blob( ordern ), bt.body = body ) );
 
-            KTRY( push_attr( con, node, ordern ) );
+            KTRY( push_attr( con, stmts, node, ordern ) );
         }
         else
         {
@@ -1104,14 +1173,14 @@ auto check_order( sql::connection& con
         auto const order_set = [ & ]
         {
             auto rs = std::set< std::string >{};
-            auto const aliases = KTRYE( com::db::select_aliases( con, node ) );
+            auto const aliases = KTRYE( com::db::select_aliases( con, stmts, node ) );
 
             rs.insert( children.begin(), children.end() );
             rs.insert( aliases.begin(), aliases.end() );
 
             return rs;
         }();
-        auto const body = KTRYE( com::db::select_body( con, attr_headings.at( "order" ) ) );
+        auto const body = KTRYE( com::db::select_body( con, stmts, attr_headings.at( "order" ) ) );
         auto const body_set = body
                             | rvs::split( '\n' )
                             | ranges::to< std::set< std::string > >();
@@ -1135,7 +1204,7 @@ auto check_order( sql::connection& con
 
                 auto const new_body = [ & ]
                 {
-                    if( auto const tbody = KTRYE( com::db::select_body( con, attr_headings.at( "order" ) ) )
+                    if( auto const tbody = KTRYE( com::db::select_body( con, stmts, attr_headings.at( "order" ) ) )
                       ; tbody.empty() )
                     {
                         return d;
@@ -1146,7 +1215,7 @@ auto check_order( sql::connection& con
                     }
                 }();
 
-                con( insert_or_replace_into( bt ).set( bt.uuid = attr_headings.at( "order" ), bt.body = new_body ) );
+                con( insert_or_replace_into( bt ).set( bt.uuid = as_blob( attr_headings.at( "order" ) ), bt.body = new_body ) );
             }
             else
             {
@@ -1169,7 +1238,7 @@ auto check_order( sql::connection& con
                                     | rvs::join( '\n' )
                                     | ranges::to< std::string >();
 
-                con( insert_or_replace_into( bt ).set( bt.uuid = attr_headings.at( "order" ), bt.body = new_body ) );
+                con( insert_or_replace_into( bt ).set( bt.uuid = as_blob( attr_headings.at( "order" ) ), bt.body = new_body ) );
             }
             else
             {
@@ -1187,6 +1256,7 @@ auto check_order( sql::connection& con
 }
 
 auto traverse_check_attr_node( sql::connection& con
+                             , db::StatementCache& stmts
                              , std::string const& node
                              , bool fix )
     -> Result< void >
@@ -1196,16 +1266,16 @@ auto traverse_check_attr_node( sql::connection& con
     auto rv = result::make_result< void >();
 
     KTRY( check_multiparent( con, node, fix ) );
-    KTRY( check_heading( con, node, fix ) );
-    KTRY( check_heading_conflict( con, node, fix ) );
+    KTRY( check_heading( con, stmts, node, fix ) );
+    KTRY( check_heading_conflict( con, stmts, node, fix ) );
     KTRY( check_body( con, node, fix ) );
     KTRY( check_title( con, node, fix ) );
-    KTRY( check_has_no_attr( con, node, fix ) );
+    KTRY( check_has_no_attr( con, stmts, node, fix ) );
 
-    for( auto const children = KTRYE( com::db::select_children( con, node ) )
+    for( auto const children = KTRYE( com::db::select_children( con, stmts, node ) )
        ; auto const& child : children )
     {
-        KTRY( traverse_check_attr_node( con, child, fix ) );
+        KTRY( traverse_check_attr_node( con, stmts, child, fix ) );
     }
 
     rv = outcome::success();
@@ -1214,6 +1284,7 @@ auto traverse_check_attr_node( sql::connection& con
 }
 
 auto traverse_check_node( sql::connection& con
+                        , db::StatementCache& stmts
                         , std::string const& node
                         , bool fix )
     -> Result< void >
@@ -1223,22 +1294,22 @@ auto traverse_check_node( sql::connection& con
     auto rv = result::make_result< void >();
 
     KTRY( check_multiparent( con, node, fix ) );
-    KTRY( check_heading( con, node, fix ) );
-    KTRY( check_heading_conflict( con, node, fix ) );
+    KTRY( check_heading( con, stmts, node, fix ) );
+    KTRY( check_heading_conflict( con, stmts, node, fix ) );
     KTRY( check_body( con, node, fix ) );
     KTRY( check_title( con, node, fix ) );
-    KTRY( check_genesis( con, node, fix ) );
-    KTRY( check_order( con, node, fix ) );
+    KTRY( check_genesis( con, stmts, node, fix ) );
+    KTRY( check_order( con, stmts, node, fix ) );
 
-    for( auto const children = KTRYE( com::db::select_children( con, node ) )
+    for( auto const children = KTRYE( com::db::select_children( con, stmts, node ) )
        ; auto const& child : children )
     {
-        KTRY( traverse_check_node( con, child, fix ) );
+        KTRY( traverse_check_node( con, stmts, child, fix ) );
     }
-    for( auto const attrs = KTRYE( com::db::select_attributes( con, node ) )
+    for( auto const attrs = KTRYE( com::db::select_attributes( con, stmts, node ) )
        ; auto const& attr : attrs )
     {
-        KTRY( traverse_check_attr_node( con, attr, fix ) );
+        KTRY( traverse_check_attr_node( con, stmts, attr, fix ) );
     }
 
     rv = outcome::success();
@@ -1247,6 +1318,7 @@ auto traverse_check_node( sql::connection& con
 }
 
 auto traverse_check_root( sql::connection& con
+                        , db::StatementCache& stmts
                         , std::string const& node
                         , bool fix )
     -> Result< void >
@@ -1255,21 +1327,21 @@ auto traverse_check_root( sql::connection& con
 
     auto rv = result::make_result< void >();
 
-    KTRY( check_heading( con, node, fix ) );
+    KTRY( check_heading( con, stmts, node, fix ) );
     KTRY( check_body( con, node, fix ) );
     KTRY( check_title( con, node, fix ) );
-    KTRY( check_genesis( con, node, fix ) );
-    KTRY( check_order( con, node, fix ) );
+    KTRY( check_genesis( con, stmts, node, fix ) );
+    KTRY( check_order( con, stmts, node, fix ) );
 
-    for( auto const children = KTRYE( com::db::select_children( con, node ) )
+    for( auto const children = KTRYE( com::db::select_children( con, stmts, node ) )
        ; auto const& child : children )
     {
-        KTRY( traverse_check_node( con, child, fix ) );
+        KTRY( traverse_check_node( con, stmts, child, fix ) );
     }
-    for( auto const attrs = KTRYE( com::db::select_attributes( con, node ) )
+    for( auto const attrs = KTRYE( com::db::select_attributes( con, stmts, node ) )
        ; auto const& attr : attrs )
     {
-        KTRY( traverse_check_attr_node( con, attr, fix ) );
+        KTRY( traverse_check_attr_node( con, stmts, attr, fix ) );
     }
 
     rv = outcome::success();
@@ -1278,15 +1350,17 @@ auto traverse_check_root( sql::connection& con
 }
 
 auto traverse_check_root( sql::connection& con
+                        , db::StatementCache& stmts
                         , Uuid const& node
                         , bool fix )
     -> Result< void >
 {
-    return traverse_check_root( con, to_string( node ), fix );
+    return traverse_check_root( con, stmts, to_string( node ), fix );
 }
 
 // TODO: Should be renamed check_map, as the fix is a toggle switch.
 auto check_map( sql::connection& con
+              , db::StatementCache& stmts
               , Uuid const& root
               , bool fix )
     -> Result< void >
@@ -1300,7 +1374,156 @@ auto check_map( sql::connection& con
     KTRY( check_ids_for_valid_format( con, fix ) );
     KTRY( check_orphaned_nodes( con, root, fix ) );
     KTRY( check_all_against_node_table( con, fix ) );
-    KTRY( traverse_check_root( con, root, fix ) );
+    KTRY( traverse_check_root( con, stmts, root, fix ) );
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+/**
+ * @brief Rebuilds `table` under the current schema, converting text UUIDs of the legacy (v0) table to BLOBs.
+ *        Rows bearing a malformed UUID are dropped, as repair would erase them anyway.
+ */
+auto migrate_table( sql::connection& con
+                  , db::StatementCache& stmts
+                  , std::string const& table
+                  , std::string const& create_sql )
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_STR( "table", table );
+
+    auto rv = result::make_result< void >();
+    auto const legacy = fmt::format( "{}_v0", table );
+    auto const exists = !com::execute_raw( con, fmt::format( "SELECT name FROM sqlite_master WHERE type='table' AND name='{}';", table ) ).empty();
+
+    if( exists )
+    {
+        con.execute( fmt::format( "ALTER TABLE {} RENAME TO {};", table, legacy ) );
+    }
+
+    con.execute( create_sql );
+
+    if( exists )
+    {
+        auto batch = db::RowBatch{ .table = table };
+
+        {
+            auto const info = KTRY( db::prepare( con, fmt::format( "PRAGMA table_info( {} );", table ) ) );
+
+            while( sqlite3_step( info.get() ) == SQLITE_ROW )
+            {
+                auto const name = std::string{ reinterpret_cast< char const* >( sqlite3_column_text( info.get(), 1 ) ) };
+                auto const type = std::string{ reinterpret_cast< char const* >( sqlite3_column_text( info.get(), 2 ) ) };
+
+                batch.columns.emplace_back( db::RowBatch::Column{ .name = name, .blob = ( type == "BLOB" ) } );
+            }
+        }
+
+        auto cols = std::string{};
+
+        for( auto const& col : batch.columns )
+        {
+            cols += ( cols.empty() ? col.name : "," + col.name );
+        }
+
+        auto const rows = KTRY( db::prepare( con, fmt::format( "SELECT {} FROM {};", cols, legacy ) ) );
+        auto const stmt = rows.get();
+        auto rc = sqlite3_step( stmt );
+
+        while( rc == SQLITE_ROW )
+        {
+            auto row = std::vector< std::string >{};
+
+            for( auto i = 0
+               ; i < static_cast< int >( batch.columns.size() )
+               ; ++i )
+            {
+                auto const data = static_cast< char const* >( sqlite3_column_blob( stmt, i ) );
+                auto const value = std::string( data == nullptr ? "" : data, static_cast< std::size_t >( sqlite3_column_bytes( stmt, i ) ) );
+
+                if( db::is_uuid_column( batch.columns[ i ].name ) )
+                {
+                    if( auto const id = uuid_from_string( value )
+                      ; id )
+                    {
+                        row.emplace_back( db::uuid_bytes( id.value() ) );
+                    }
+                    else
+                    {
+                        io::print( "[log][migrate] Dropping row with invalid ID ('{}') from '{}'\n", value, table );
+
+                        row.clear();
+
+                        break;
+                    }
+                }
+                else
+                {
+                    row.emplace_back( value );
+                }
+            }
+
+            batch.values.insert( batch.values.end(), row.begin(), row.end() );
+
+            rc = sqlite3_step( stmt );
+        }
+
+        KMAP_ENSURE_MSG( rc == SQLITE_DONE, error_code::common::uncategorized, sqlite3_errmsg( con.native_handle() ) );
+
+        KTRY( db::insert_rows( con, stmts, batch ) );
+
+        con.execute( fmt::format( "DROP TABLE {};", legacy ) );
+    }
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+auto migrate_map( FsPath const& fp )
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH( "path", fp.string() );
+
+    auto rv = result::make_result< void >();
+
+    KMAP_ENSURE( fs::exists( fp ), error_code::filesystem::file_not_found );
+
+    auto con = db::open_connection( fp, SQLITE_OPEN_READWRITE, false );
+    auto const version = KTRY( db::fetch_schema_version( con ) );
+
+    KMAP_ENSURE_MSG( version <= db::schema_version, error_code::db::schema_mismatch, fmt::format( "map schema v{} is newer than supported v{}", version, db::schema_version ) );
+
+    if( version == db::schema_version )
+    {
+        io::print( "[log][migrate] Map already at schema v{}: {}\n", version, fp.string() );
+    }
+    else
+    {
+        KTRY( back_up_state( fp ) );
+
+        io::print( "[log][migrate] Migrating map from schema v{} to v{}: {}\n", version, db::schema_version, fp.string() );
+
+        {
+            auto stmts = db::StatementCache{};
+            auto tx = sqlpp::start_transaction( con );
+
+            for( auto const& [ table, create_sql ] : db::table_map )
+            {
+                KTRY( migrate_table( con, stmts, table, create_sql ) );
+            }
+
+            KTRY( db::update_schema_version( con, db::schema_version ) );
+
+            tx.commit();
+        }
+
+        // Reclaims the pages freed by the narrower keys; not permitted within a transaction.
+        con.execute( "VACUUM;" );
+    }
 
     rv = outcome::success();
 
@@ -1312,6 +1535,26 @@ namespace binding {
 
 using namespace emscripten;
 
+/**
+ * @brief Refuses maps of another schema: check and repair read UUIDs in their current, BLOB, form, so would mistake legacy text UUIDs for corruption.
+ */
+auto ensure_current_schema( sql::connection& con )
+    -> kmap::Result< void >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< void >();
+    auto const version = KTRY( db::fetch_schema_version( con ) );
+
+    KMAP_ENSURE_MSG( version == db::schema_version
+                   , error_code::db::schema_mismatch
+                   , fmt::format( "map schema v{} found, v{} expected; upgrade via kmap.migrate_map( path ) before checking or repairing", version, db::schema_version ) );
+
+    rv = outcome::success();
+
+    return rv;
+}
+
 auto check_map( std::string const& fs_path )
     -> kmap::Result< void >
 {
@@ -1323,6 +1566,10 @@ auto check_map( std::string const& fs_path )
     KMAP_ENSURE( fs::exists( fp ), error_code::filesystem::file_not_found );
 
     auto con = db::open_connection( fp, SQLITE_OPEN_READWRITE, false );
+
+    KTRY( ensure_current_schema( con ) );
+
+    auto stmts = db::StatementCache{};
     auto const unbegotten_set = KTRY( fetch_unbegotten_nodes( con ) );
 
     if( unbegotten_set.size() == 0 )
@@ -1336,6 +1583,7 @@ auto check_map( std::string const& fs_path )
     else
     {
         return repair::check_map( con
+                                , stmts
                                 , *unbegotten_set.begin()
                                 , false );
     }
@@ -1354,7 +1602,12 @@ auto check_map_root( std::string const& fs_path
 
     auto con = db::open_connection( fp, SQLITE_OPEN_READWRITE, false );
 
+    KTRY( ensure_current_schema( con ) );
+
+    auto stmts = db::StatementCache{};
+
     return repair::check_map( con
+                            , stmts
                             , KTRY( uuid_from_string( root_id ) )
                             , false );
 }
@@ -1372,6 +1625,8 @@ auto erase_node( std::string const& fs_path
 
     auto con = db::open_connection( fp, SQLITE_OPEN_READWRITE, false );
 
+    KTRY( ensure_current_schema( con ) );
+
     return repair::erase_node( con, node_id );
 }
 
@@ -1385,9 +1640,12 @@ auto repair_map( std::string const& fs_path )
 
     KMAP_ENSURE( fs::exists( fp ), error_code::filesystem::file_not_found );
 
+    auto con = db::open_connection( fp, SQLITE_OPEN_READWRITE, false );
+
+    KTRY( ensure_current_schema( con ) );
     KTRY( back_up_state( fp ) );
 
-    auto con = db::open_connection( fp, SQLITE_OPEN_READWRITE, false );
+    auto stmts = db::StatementCache{};
     auto const unbegotten_set = KTRY( fetch_unbegotten_nodes( con ) );
 
     if( unbegotten_set.size() == 0 )
@@ -1401,6 +1659,7 @@ auto repair_map( std::string const& fs_path )
     else
     {
         return repair::check_map( con
+                                , stmts
                                 , *unbegotten_set.begin()
                                 , true );
     }
@@ -1417,20 +1676,31 @@ auto repair_map_root( std::string const& fs_path
 
     KMAP_ENSURE( fs::exists( fp ), error_code::filesystem::file_not_found );
 
+    auto con = db::open_connection( fp, SQLITE_OPEN_READWRITE, false );
+
+    KTRY( ensure_current_schema( con ) );
     KTRY( back_up_state( fp ) );
 
-    auto con = db::open_connection( fp, SQLITE_OPEN_READWRITE, false );
+    auto stmts = db::StatementCache{};
 
     return repair::check_map( con
+                            , stmts
                             , KTRY( uuid_from_string( root_id ) )
                             , true );
 }
 
+auto migrate_map( std::string const& fs_path )
+    -> kmap::Result< void >
+{
+    return repair::migrate_map( com::kmap_root_dir / fs_path );
+}
+
 EMSCRIPTEN_BINDINGS( kmap_module )
 {
     function( "check_map", &kmap::repair::binding::check_map );
     function( "check_map_root", &kmap::repair::binding::check_map_root );
     function( "erase_node", &kmap::repair::binding::erase_node );
+    function( "migrate_map", &kmap::repair::binding::migrate_map );
     function( "repair_map", &kmap::repair::binding::repair_map );
     function( "repair_map_root", &kmap::repair::binding::repair_map_root );
 }
@@ -1471,9 +1741,9 @@ SCENARIO( "repair_map", "[repair]" )
         {
             auto const root = gen_uuid();
 
-            con( insert_into( nt ).set( nt.uuid = to_string( root ) ) );
-            con( insert_into( ht ).set( ht.uuid = to_string( root ), ht.heading = "root" ) );
-            con( insert_into( tt ).set( tt.uuid = to_string( root ), tt.title = "Root" ) );
+            con( insert_into( nt ).set( nt.uuid = db::to_blob( root ) ) );
+            con( insert_into( ht ).set( ht.uuid = db::to_blob( root ), ht.heading = "root" ) );
+            con( insert_into( tt ).set( tt.uuid = db::to_blob( root ), tt.title = "Root" ) );
 
             THEN( "check => map state correct" )
             {
@@ -1485,7 +1755,7 @@ SCENARIO( "repair_map", "[repair]" )
             {
                 auto const invalid_id = std::string{ "039-981" };
 
-                con( insert_into( nt ).set( nt.uuid = invalid_id ) );
+                con( insert_into( nt ).set( nt.uuid = as_blob( invalid_id ) ) );
 
                 THEN( "check => map state correct" )
                 {
@@ -1498,7 +1768,7 @@ SCENARIO( "repair_map", "[repair]" )
 
                     THEN( "invalid node id erased" )
                     {
-                        auto selected = con( select( all_of( nt ) ).from( nt ).where( nt.uuid == invalid_id ) );
+                        auto selected = con( select( all_of( nt ) ).from( nt ).where( nt.uuid == as_blob( invalid_id ) ) );
 
                         REQUIRE( std::distance( selected.begin(), selected.end() ) == 0 );
                     }
@@ -1515,8 +1785,8 @@ SCENARIO( "repair_map", "[repair]" )
             {
                 auto const child = gen_uuid();
 
-                con( insert_into( ct ).set( ct.parent_uuid = to_string( root )
-                                          , ct.child_uuid = to_string( child ) ) );
+                con( insert_into( ct ).set( ct.parent_uuid = db::to_blob( root )
+                                          , ct.child_uuid = db::to_blob( child ) ) );
 
                 THEN( "check( child as root ) => non-root provided as root error" )
                 {
@@ -1530,7 +1800,7 @@ SCENARIO( "repair_map", "[repair]" )
                 {
                     REQUIRE_TRY( repair_map( con, root, true ) );
 
-                    auto selected = con( select( all_of( nt ) ).from( nt ).where( nt.uuid == to_string( child ) ) );
+                    auto selected = con( select( all_of( nt ) ).from( nt ).where( nt.uuid == db::to_blob( child ) ) );
 
                     REQUIRE( std::distance( selected.begin(), selected.end() ) == 1 );
                 }
@@ -1547,4 +1817,121 @@ SCENARIO( "repair_map", "[repair]" )
 #endif // 0
 }
 
+SCENARIO( "migrate_map upgrades a v0 map in place", "[repair][migrate]" )
+{
+    KMAP_COMPONENT_FIXTURE_SCOPED( "database", "database.filesystem", "network" );
+
+    auto& km = Singleton::instance();
+    // Fetched anew on each use, as loading replaces components.
+    auto const db = [ & ]{ return REQUIRE_TRY( km.fetch_component< com::Database >() ); };
+    auto const nw = [ & ]{ return REQUIRE_TRY( km.fetch_component< com::Network >() ); };
+    auto const initialized_coms = km.component_store().all_initialized_components();
+    auto const disk_path = fmt::format( "migrate.test.{}.kmap", to_string( gen_uuid() ) );
+    auto const fp = com::kmap_root_dir / disk_path;
+    // The v0 schema: UUIDs stored as text.
+    auto const legacy_tables = std::map< std::string, std::string >
+    {
+        { "nodes", "CREATE TABLE nodes ( uuid, PRIMARY KEY( uuid ) );" }
+    ,   { "children", "CREATE TABLE children ( parent_uuid TEXT, child_uuid TEXT, PRIMARY KEY( parent_uuid, child_uuid ) );" }
+    ,   { "headings", "CREATE TABLE headings ( uuid TEXT, heading TEXT, PRIMARY KEY( uuid ) );" }
+    ,   { "titles", "CREATE TABLE titles ( uuid TEXT, title TEXT, PRIMARY KEY( uuid ) );" }
+    ,   { "bodies", "CREATE TABLE bodies ( uuid TEXT, body TEXT, PRIMARY KEY( uuid ) );" }
+    ,   { "aliases", "CREATE TABLE aliases ( src_uuid TEXT, dst_uuid TEXT, PRIMARY KEY( src_uuid, dst_uuid ) );" }
+    ,   { "attributes", "CREATE TABLE attributes ( parent_uuid TEXT, child_uuid TEXT, PRIMARY KEY( parent_uuid, child_uuid ) );" }
+    ,   { "resources", "CREATE TABLE resources ( uuid TEXT, resource BLOB, PRIMARY KEY( uuid ) );" }
+    };
+
+    GIVEN( "map with ordered children, a body and an alias, flushed to disk" )
+    {
+        auto const root = nw()->root_node();
+        auto const p = REQUIRE_TRY( nw()->create_child( root, "p" ) );
+        auto const c1 = REQUIRE_TRY( nw()->create_child( p, "1" ) );
+        auto const c2 = REQUIRE_TRY( nw()->create_child( p, "2" ) );
+        auto const c3 = REQUIRE_TRY( nw()->create_child( p, "3" ) );
+
+        REQUIRE_RES( nw()->reorder_children( p, { c3, c1, c2 } ) );
+        REQUIRE_RES( nw()->update_body( c1, "body of 1" ) );
+
+        auto const a12 = REQUIRE_TRY( nw()->create_alias( c1, c2 ) );
+
+        REQUIRE_RES( db()->init_db_on_disk( fp ) );
+        REQUIRE_RES( db()->flush_delta_to_disk() );
+
+        GIVEN( "map rewritten under the v0 schema" )
+        {
+            {
+                auto con = db::open_connection( fp, SQLITE_OPEN_READWRITE, false );
+
+                for( auto const& [ table, create_sql ] : legacy_tables )
+                {
+                    auto const info = com::execute_raw( con, fmt::format( "PRAGMA table_info( {} );", table ) );
+                    auto cols = std::vector< std::string >{};
+
+                    for( auto [ it, end ] = info.equal_range( "name" )
+                       ; it != end
+                       ; ++it )
+                    {
+                        auto const& col = it->second;
+
+                        cols.emplace_back( db::is_uuid_column( col )
+                                         ? fmt::format( "lower( substr( hex( {0} ), 1, 8 ) || '-' || substr( hex( {0} ), 9, 4 ) || '-' || substr( hex( {0} ), 13, 4 ) || '-' || substr( hex( {0} ), 17, 4 ) || '-' || substr( hex( {0} ), 21 ) )", col )
+                                         : col );
+                    }
+
+                    for( auto const& stmt : { fmt::format( "ALTER TABLE {0} RENAME TO {0}_v1;", table )
+                                            , create_sql
+                                            , fmt::format( "INSERT INTO {0} SELECT {1} FROM {0}_v1;", table, cols | rvs::join( ',' ) | ranges::to< std::string >() )
+                                            , fmt::format( "DROP TABLE {}_v1;", table ) } )
+                    {
+                        REQUIRE( !com::execute_raw( con, stmt ).contains( "error" ) );
+                    }
+                }
+
+                REQUIRE_RES( db::update_schema_version( con, 0 ) );
+            }
+
+            THEN( "load, check and repair refuse it" )
+            {
+                REQUIRE_RFAIL( km.load( disk_path, initialized_coms ) );
+                REQUIRE_RFAIL( binding::check_map( disk_path ) );
+                REQUIRE_RFAIL( binding::repair_map( disk_path ) );
+            }
+
+            WHEN( "migrated" )
+            {
+                REQUIRE_RES( migrate_map( fp ) );
+
+                THEN( "schema is current" )
+                {
+                    auto con = db::open_connection( fp, SQLITE_OPEN_READWRITE, false );
+
+                    REQUIRE( REQUIRE_TRY( db::fetch_schema_version( con ) ) == db::schema_version );
+                }
+                THEN( "loaded map retains nodes, headings, bodies, order and aliases" )
+                {
+                    REQUIRE_RES( km.load( disk_path, initialized_coms ) );
+
+                    REQUIRE( nw()->root_node() == root );
+                    REQUIRE( REQUIRE_TRY( nw()->fetch_heading( p ) ) == "p" );
+                    REQUIRE( REQUIRE_TRY( nw()->fetch_heading( c1 ) ) == "1" );
+                    REQUIRE( REQUIRE_TRY( nw()->fetch_heading( c2 ) ) == "2" );
+                    REQUIRE( REQUIRE_TRY( nw()->fetch_heading( c3 ) ) == "3" );
+                    REQUIRE( REQUIRE_TRY( nw()->fetch_body( c1 ) ) == "body of 1" );
+                    REQUIRE( REQUIRE_TRY( nw()->fetch_children_ordered( p ) ) == UuidVec{ c3, c1, c2 } );
+                    REQUIRE( nw()->exists( a12 ) );
+                    REQUIRE( nw()->resolve( a12 ) == c1 );
+                }
+            }
+        }
+
+        // Cleanup database file and its backup.
+        for( auto const& path : { fp, FsPath{ fp }.replace_extension( ".pre-repair" ) } )
+        {
+            auto ec = boost::system::error_code{};
+
+            fs::remove( path, ec );
+        }
+    }
+}
+
 } // namespace kmap::repair
\ No newline at end of file
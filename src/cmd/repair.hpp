@@ -23,6 +23,10 @@ namespace kmap::repair {
 
 auto back_up_state( FsPath const& fp ) -> Result< void >;
 auto erase_node( sqlpp::sqlite3::connection& con, std::string const& node ) -> Result< void >;
+/**
+ * @brief Upgrades the map file at `fp` to db::schema_version in place, backing it up first.
+ */
+auto migrate_map( FsPath const& fp ) -> Result< void >;
 auto repair_conflicting_headings( Database& db ) -> void;
 auto repair_map( FsPath const &fp ) -> Result< void >;
 auto repair_orderings( Database& db ) -> void;
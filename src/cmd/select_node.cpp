@@ -39,7 +39,7 @@ auto select_destination( Kmap& kmap )
         auto const nw = KTRYE( kmap.fetch_component< com::Network >() );
         auto const heading = args[ 0 ];
         auto const selected = nw->selected_node();
-        auto const aliases = nw->alias_store().fetch_aliases( com::AliasItem::rsrc_type{ selected } );
+        auto const aliases = nw->fetch_aliases( selected );
         auto const map = aliases
                        | views::transform( [ & ]( auto const& e ){ return std::pair{ e, KTRYE( nw->fetch_heading( e ) ) }; } )
                        | to_vector;
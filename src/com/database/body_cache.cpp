@@ -0,0 +1,204 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#include <com/database/body_cache.hpp>
+
+#include <test/util.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace kmap::com::db {
+
+auto BodyCache::budget() const
+    -> std::size_t
+{
+    return budget_;
+}
+
+auto BodyCache::bytes() const
+    -> std::size_t
+{
+    return bytes_;
+}
+
+auto BodyCache::clear()
+    -> void
+{
+    lru_.clear();
+    entries_.clear();
+    bytes_ = 0;
+}
+
+auto BodyCache::contains( Uuid const& key ) const
+    -> bool
+{
+    return entries_.contains( key );
+}
+
+auto BodyCache::erase( Uuid const& key )
+    -> void
+{
+    if( auto const it = entries_.find( key )
+      ; it != entries_.end() )
+    {
+        bytes_ -= it->second.bytes;
+        lru_.erase( it->second.pos );
+        entries_.erase( it );
+    }
+}
+
+auto BodyCache::push( Uuid const& key
+                    , std::size_t const bytes )
+    -> void
+{
+    if( auto const it = entries_.find( key )
+      ; it != entries_.end() )
+    {
+        bytes_ = bytes_ - it->second.bytes + bytes;
+        it->second.bytes = bytes;
+        lru_.splice( lru_.begin(), lru_, it->second.pos );
+    }
+    else
+    {
+        lru_.emplace_front( key );
+        entries_.emplace( key, Entry{ .pos = lru_.begin(), .bytes = bytes } );
+        bytes_ += bytes;
+    }
+}
+
+auto BodyCache::set_budget( std::size_t const bytes )
+    -> void
+{
+    budget_ = bytes;
+}
+
+auto BodyCache::size() const
+    -> std::size_t
+{
+    return entries_.size();
+}
+
+auto BodyCache::stats() const
+    -> Stats const&
+{
+    return stats_;
+}
+
+auto BodyCache::touch( Uuid const& key )
+    -> bool
+{
+    if( auto const it = entries_.find( key )
+      ; it != entries_.end() )
+    {
+        lru_.splice( lru_.begin(), lru_, it->second.pos );
+        ++stats_.hits;
+
+        return true;
+    }
+    else
+    {
+        ++stats_.misses;
+
+        return false;
+    }
+}
+
+auto BodyCache::trim( std::function< bool( Uuid const& ) > const& pinned )
+    -> std::vector< Uuid >
+{
+    auto rv = std::vector< Uuid >{};
+    auto it = lru_.end();
+
+    while( bytes_ > budget_
+        && it != lru_.begin() )
+    {
+        --it;
+
+        if( pinned( *it ) )
+        {
+            continue;
+        }
+
+        auto const key = *it;
+        auto const eit = entries_.find( key );
+
+        bytes_ -= eit->second.bytes;
+        it = lru_.erase( it );
+        entries_.erase( eit );
+        ++stats_.evictions;
+
+        rv.emplace_back( key );
+    }
+
+    return rv;
+}
+
+SCENARIO( "BodyCache evicts least recently used, unpinned bodies", "[db][body_cache]" )
+{
+    auto bc = BodyCache{};
+    auto const n1 = gen_uuid();
+    auto const n2 = gen_uuid();
+    auto const n3 = gen_uuid();
+    auto const unpinned = []( Uuid const& ){ return false; };
+
+    bc.set_budget( 10 );
+
+    GIVEN( "three bodies totalling beyond budget" )
+    {
+        bc.push( n1, 4 );
+        bc.push( n2, 4 );
+        bc.push( n3, 4 );
+
+        REQUIRE( bc.bytes() == 12 );
+
+        THEN( "trimming evicts the least recently used" )
+        {
+            REQUIRE( bc.trim( unpinned ) == std::vector< Uuid >{ n1 } );
+            REQUIRE( bc.bytes() == 8 );
+            REQUIRE( !bc.contains( n1 ) );
+            REQUIRE( bc.stats().evictions == 1 );
+        }
+        WHEN( "the oldest is touched" )
+        {
+            REQUIRE( bc.touch( n1 ) );
+
+            THEN( "the next oldest is evicted instead" )
+            {
+                REQUIRE( bc.trim( unpinned ) == std::vector< Uuid >{ n2 } );
+                REQUIRE( bc.contains( n1 ) );
+            }
+        }
+        WHEN( "the oldest is pinned" )
+        {
+            auto const pinned = [ & ]( Uuid const& k ){ return k == n1; };
+
+            THEN( "it is skipped" )
+            {
+                REQUIRE( bc.trim( pinned ) == std::vector< Uuid >{ n2 } );
+                REQUIRE( bc.contains( n1 ) );
+            }
+        }
+        WHEN( "a body is resized" )
+        {
+            bc.push( n2, 1 );
+
+            THEN( "the byte count follows, and nothing need be evicted" )
+            {
+                REQUIRE( bc.bytes() == 9 );
+                REQUIRE( bc.trim( unpinned ).empty() );
+            }
+        }
+    }
+    GIVEN( "an absent key" )
+    {
+        THEN( "touching it is a miss" )
+        {
+            REQUIRE( !bc.touch( n1 ) );
+            REQUIRE( bc.stats().misses == 1 );
+        }
+    }
+}
+
+} // namespace kmap::com::db
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#pragma once
+#ifndef KMAP_DB_BODY_CACHE_HPP
+#define KMAP_DB_BODY_CACHE_HPP
+
+#include "common.hpp"
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace kmap::com::db {
+
+/**
+ * @brief Byte-budgeted LRU over the bodies resident in db::Cache's BodyTable, when bodies are paged in lazily.
+ * @note Only keys and sizes are tracked here; the bodies themselves remain in the BodyTable. An evicted key's body is replaced by a placeholder there.
+ */
+class BodyCache
+{
+public:
+    struct Stats
+    {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t evictions = 0;
+    };
+
+    static constexpr auto default_budget = std::size_t{ 32 * 1024 * 1024 };
+
+private:
+    using Lru = std::list< Uuid >; // Most recently used at front.
+    struct Entry
+    {
+        Lru::iterator pos = {};
+        std::size_t bytes = 0;
+    };
+
+    std::size_t budget_ = default_budget;
+    std::size_t bytes_ = 0;
+    Lru lru_ = {};
+    std::unordered_map< Uuid, Entry, boost::hash< Uuid > > entries_ = {};
+    Stats stats_ = {};
+
+public:
+    auto budget() const
+        -> std::size_t;
+    auto bytes() const
+        -> std::size_t;
+    auto clear()
+        -> void;
+    auto contains( Uuid const& key ) const
+        -> bool;
+    auto erase( Uuid const& key )
+        -> void;
+    /**
+     * @brief Records `key` as resident, holding `bytes`, and marks it most recently used.
+     */
+    auto push( Uuid const& key
+             , std::size_t const bytes )
+        -> void;
+    auto set_budget( std::size_t const bytes )
+        -> void;
+    auto size() const
+        -> std::size_t;
+    auto stats() const
+        -> Stats const&;
+    /**
+     * @brief Marks `key` most recently used, if resident.
+     * @return Whether `key` was resident.
+     */
+    auto touch( Uuid const& key )
+        -> bool;
+    /**
+     * @brief Drops least recently used keys, skipping those `pinned`, until within budget.
+     * @return The dropped keys, whose bodies the caller is expected to page out.
+     */
+    auto trim( std::function< bool( Uuid const& ) > const& pinned )
+        -> std::vector< Uuid >;
+};
+
+} // namespace kmap::com::db
+
+#endif // KMAP_DB_BODY_CACHE_HPP
@@ -610,6 +610,17 @@ auto fetch_deltas( Cache const& cache
     return rv;
 }
 
+auto Cache::has_delta() const
+    -> bool
+{
+    auto rv = false;
+
+    boost::hana::for_each( delta_journal_
+                         , [ & ]( auto const& dk ){ rv = rv || !dk.keys.empty(); } );
+
+    return rv;
+}
+
 auto print_deltas( db::Cache const& cache )
     -> void
 {
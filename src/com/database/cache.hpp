@@ -109,6 +109,18 @@ struct ReversalItem
     ValueVariant value = {};
 };
 
+/**
+ * @brief Set of keys, for a given table, whose entries currently carry a non-empty delta.
+ */
+template< typename Table >
+struct DeltaKeys
+{
+    using key_type = typename Table::unique_key_type;
+    using Set = std::unordered_set< key_type, boost::hash< key_type > >;
+
+    Set keys = {};
+};
+
 class Cache
 {
     // Note: There is a dependency among tables. All tables depend, respecting DB semantics, on NodeTable, so it should be listed last such that (erase) iterations find it last.
@@ -120,9 +132,19 @@ class Cache
                                   , AttributeTable
                                   , ResourceTable
                                   , NodeTable >;
+    // Mirrors CacheTables: one DeltaKeys per table, so flushing need not scan whole tables to find deltas.
+    using DeltaJournal = std::tuple< DeltaKeys< HeadingTable >
+                                   , DeltaKeys< TitleTable >
+                                   , DeltaKeys< BodyTable >
+                                   , DeltaKeys< ChildTable >
+                                   , DeltaKeys< AliasTable >
+                                   , DeltaKeys< AttributeTable >
+                                   , DeltaKeys< ResourceTable >
+                                   , DeltaKeys< NodeTable > >;
     using ReversalMap = std::map< TransactionIdSet, std::vector< ReversalItem > >;
 
     CacheTables cache_tables_ = {};
+    DeltaJournal delta_journal_ = {};
     // UndoStore undo_store_ = {};
     // ReversalMap units_ = {};
     // TransactionIdSet curr_groups_ = {}; // Rather, should it not be a UUID assigned to a group, rather than an index?
@@ -187,6 +209,38 @@ public:
 
         return rv;
     }
+    /**
+     * @brief Borrowing counterpart of fetch_value: refers to the current value in place, rather than copying it, along with its entry's deltas, out.
+     * @note Valid until the table is next mutated.
+     */
+    template< typename Table >
+    auto fetch_value_ref( typename Table::unique_key_type const& ukey ) const
+        -> Result< std::reference_wrapper< typename Table::value_type const > >
+    {
+        KM_RESULT_PROLOG();
+
+        auto rv = result::make_result< std::reference_wrapper< typename Table::value_type const > >();
+        auto const& ut = std::get< Table >( cache_tables_ ).underlying();
+
+        if( auto const it = ut.find( ukey )
+          ; it != ut.end() )
+        {
+            if( !it->delta_items.empty() )
+            {
+                if( auto const& di = it->delta_items.back()
+                  ; di.action != DeltaType::erased )
+                {
+                    rv = std::cref( di.value );
+                }
+            }
+            else if( it->cache_item )
+            {
+                rv = std::cref( it->cache_item.value() );
+            }
+        }
+
+        return rv;
+    }
     template< typename Table
             , typename Key >
         requires requires( Table t ) { { t.fetch( Key{} ) } -> concepts::RangeResult; }
@@ -234,20 +288,24 @@ public:
         KM_RESULT_PROLOG();
 
         auto& table = std::get< Table >( cache_tables_ );
+        auto& journal = std::get< DeltaKeys< Table > >( delta_journal_ ).keys;
         auto update_set = std::set< typename Table::unique_key_type >{};
         auto erase_set = std::set< typename Table::unique_key_type >{};
 
-        for( auto& item : table )
+        for( auto const& ukey : journal )
         {
-            if( !item.delta_items.empty() )
+            auto const& ut = table.underlying();
+
+            if( auto const it = ut.find( ukey )
+              ; it != ut.end() && !it->delta_items.empty() )
             {
-                if( item.delta_items.back().action == DeltaType::erased )
+                if( it->delta_items.back().action == DeltaType::erased )
                 {
-                    erase_set.emplace( item.key() );
+                    erase_set.emplace( ukey );
                 }
                 else
                 {
-                    update_set.emplace( item.key() );
+                    update_set.emplace( ukey );
                 }
             }
         }
@@ -272,6 +330,42 @@ public:
                 KTRYE( table.erase( ti_key ) );
             }
         }
+
+        journal.clear();
+    }
+    template< typename Table >
+    [[ nodiscard ]]
+    auto delta_keys() const
+        -> typename DeltaKeys< Table >::Set const&
+    {
+        return std::get< DeltaKeys< Table > >( delta_journal_ ).keys;
+    }
+    [[ nodiscard ]]
+    auto has_delta() const
+        -> bool;
+    /**
+     * @brief Swaps the cached value of a clean (delta-free) entry in or out, without registering a delta. For tables paged lazily from disk.
+     */
+    template< typename Table >
+    auto page( typename Table::unique_key_type const& ukey
+             , typename Table::value_type const& value )
+        -> Result< void >
+    {
+        KM_RESULT_PROLOG();
+
+        auto rv = result::make_result< void >();
+        auto& table = std::get< Table >( cache_tables_ );
+        auto const& ut = table.underlying();
+        auto const it = ut.find( ukey );
+
+        KMAP_ENSURE( it != ut.end(), error_code::db::entry_not_found );
+        KMAP_ENSURE( it->cache_item && it->delta_items.empty(), error_code::db::update_failed );
+
+        KTRY( table.update( ukey, [ & ]( auto&& table_item ){ table_item.cache_item = value; } ) );
+
+        rv = outcome::success();
+
+        return rv;
     }
     template< typename Table >
     auto push( typename Table::unique_key_type const& ukey )
@@ -329,6 +423,8 @@ public:
             KMAP_THROW_EXCEPTION_MSG( fmt::format( "cache decider ended in invalid state: {}", decider.output->error_msg ) );
         }
 
+        journal_delta< Table >( ukey );
+
         rv = outcome::success();
 
         return rv;
@@ -389,7 +485,7 @@ public:
                 auto const update_fn = [ & ]( auto&& table_item )
                 {
                     table_item.delta_items.clear();
-                    table_item.delta_items.emplace_back( typename Table::DeltaItem{ .value = ukey, .action = DeltaType::changed, .transaction_id = {} } );
+                    append_delta( table_item.delta_items, typename Table::DeltaItem{ .value = ukey, .action = DeltaType::changed, .transaction_id = {} } );
                 };
 
                 KTRY( table.update( ukey, update_fn ) );
@@ -414,7 +510,7 @@ public:
                 auto const ukey = typename Table::unique_key_type{ left, right };
                 auto const update_fn = [ & ]( auto&& table_item )
                 {
-                    table_item.delta_items.emplace_back( typename Table::DeltaItem{ .value = ukey, .action = DeltaType::changed, .transaction_id = {} } );
+                    append_delta( table_item.delta_items, typename Table::DeltaItem{ .value = ukey, .action = DeltaType::changed, .transaction_id = {} } );
                 };
 
                 KTRY( table.update( ukey, update_fn ) );
@@ -423,7 +519,7 @@ public:
             {
                 auto const update_fn = [ & ]( auto&& table_item )
                 {
-                    table_item.delta_items.emplace_back( typename Table::DeltaItem{ .value = right, .action = DeltaType::changed, .transaction_id = {} } );
+                    append_delta( table_item.delta_items, typename Table::DeltaItem{ .value = right, .action = DeltaType::changed, .transaction_id = {} } );
                 };
 
                 KTRY( table.update( left, update_fn ) );
@@ -439,6 +535,15 @@ public:
             KMAP_THROW_EXCEPTION_MSG( fmt::format( "cache decider ended in invalid state: {}", decider.output->error_msg ) );
         }
 
+        if constexpr( concepts::Pair< typename Table::unique_key_type > )
+        {
+            journal_delta< Table >( typename Table::unique_key_type{ left, right } );
+        }
+        else
+        {
+            journal_delta< Table >( left );
+        }
+
         rv = outcome::success();
 
         return rv;
@@ -470,7 +575,7 @@ public:
                 auto&& table = std::get< Table >( cache_tables_ );
                 auto const update_fn = [ & ]( auto&& table_item )
                 {
-                    table_item.delta_items.emplace_back( typename Table::DeltaItem{ .value = typename Table::value_type{}, .action = DeltaType::erased, .transaction_id = {} } );
+                    append_delta( table_item.delta_items, typename Table::DeltaItem{ .value = typename Table::value_type{}, .action = DeltaType::erased, .transaction_id = {} } );
                 };
 
                 KTRY( table.update( ukey, update_fn ) );
@@ -487,6 +592,8 @@ public:
                 KMAP_THROW_EXCEPTION_MSG( fmt::format( "cache decider ended in invalid state", decider.output->error_msg ) );
             }
 
+            journal_delta< Table >( ukey );
+
             rv = outcome::success();
         }
 
@@ -534,7 +641,7 @@ public:
 
             auto const update_fn = [ & ]( auto&& table_item )
             {
-                table_item.delta_items.emplace_back( typename Table::DeltaItem{ .value = ukey, .action = DeltaType::erased, .transaction_id = {} } );
+                append_delta( table_item.delta_items, typename Table::DeltaItem{ .value = ukey, .action = DeltaType::erased, .transaction_id = {} } );
             };
 
             KMAP_TRY( table.update( ukey, update_fn ) );
@@ -551,6 +658,8 @@ public:
             KMAP_THROW_EXCEPTION_MSG( fmt::format( "cache decider ended in invalid state", decider.output->error_msg ) );
         }
 
+        journal_delta< Table >( typename Table::unique_key_type{ left, right } );
+
         rv = outcome::success();
 
         return rv;
@@ -841,6 +950,26 @@ public:
     //     -> UndoStore;
 
 protected:
+    /**
+     * @brief Records (or retracts) `ukey` in the table's delta journal, according to whether its entry carries a delta following a mutation.
+     */
+    template< typename Table >
+    auto journal_delta( typename Table::unique_key_type const& ukey )
+        -> void
+    {
+        auto const& ut = std::get< Table >( cache_tables_ ).underlying();
+        auto& journal = std::get< DeltaKeys< Table > >( delta_journal_ ).keys;
+
+        if( auto const it = ut.find( ukey )
+          ; it != ut.end() && !it->delta_items.empty() )
+        {
+            journal.emplace( ukey );
+        }
+        else
+        {
+            journal.erase( ukey );
+        }
+    }
     template< typename Table
             , typename Key >
         requires requires( Table t ) { { t.fetch( Key{} ) } -> concepts::NonRangeResult; }
@@ -0,0 +1,218 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#include "com/database/change_feed.hpp"
+
+#include "com/database/query_cache.hpp"
+#include "contract.hpp"
+#include "test/util.hpp"
+#include "utility.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include <exception>
+#include <stdexcept>
+
+namespace kmap::com::db {
+
+ChangeFeed::Hold::Hold( ChangeFeed& feed )
+    : feed_{ &feed }
+{
+    ++feed_->holds_;
+}
+
+ChangeFeed::Hold::~Hold()
+{
+    --feed_->holds_;
+
+    try
+    {
+        feed_->flush();
+    }
+    catch( std::exception const& e )
+    {
+        fmt::print( stderr, "[kmap][warn] change feed subscriber threw on release of hold; the batch's remaining deliveries are dropped: {}\n", e.what() );
+    }
+    catch( ... )
+    {
+        fmt::print( stderr, "[kmap][warn] change feed subscriber threw on release of hold; the batch's remaining deliveries are dropped\n" );
+    }
+}
+
+auto ChangeFeed::clear()
+    -> void
+{
+    versions_.clear();
+    pending_.clear();
+
+    base_ = ++clock_;
+}
+
+auto ChangeFeed::flush()
+    -> void
+{
+    if( holds_ == 0 && !pending_.empty() )
+    {
+        auto const batch = std::exchange( pending_, Batch{} );
+        auto const subscribers = subscribers_; // A subscriber may (un)subscribe while being notified.
+
+        for( auto const& [ id, subscriber ] : subscribers )
+        {
+            subscriber( batch );
+        }
+    }
+}
+
+auto ChangeFeed::hold()
+    -> Hold
+{
+    return Hold{ *this };
+}
+
+auto ChangeFeed::pending() const
+    -> Batch const&
+{
+    return pending_;
+}
+
+auto ChangeFeed::push( Change const& change )
+    -> void
+{
+    versions_.insert_or_assign( change.node, ++clock_ );
+
+    pending_.emplace_back( change );
+}
+
+auto ChangeFeed::subscribe( Subscriber const& subscriber )
+    -> SubscriberId
+{
+    auto const id = next_subscriber_++;
+
+    subscribers_.emplace( id, subscriber );
+
+    return id;
+}
+
+auto ChangeFeed::unsubscribe( SubscriberId const id )
+    -> void
+{
+    subscribers_.erase( id );
+}
+
+auto ChangeFeed::version( Uuid const& node ) const
+    -> std::uint64_t
+{
+    if( auto const it = versions_.find( node )
+      ; it != versions_.end() )
+    {
+        return it->second;
+    }
+    else
+    {
+        return base_;
+    }
+}
+
+SCENARIO( "ChangeFeed versions nodes and batches changes", "[db][change_feed]" )
+{
+    auto feed = ChangeFeed{};
+    auto batches = std::vector< ChangeFeed::Batch >{};
+    auto const n1 = gen_uuid();
+    auto const n2 = gen_uuid();
+    auto const sub = feed.subscribe( [ & ]( auto const& batch ){ batches.emplace_back( batch ); } );
+
+    GIVEN( "change to n1" )
+    {
+        auto const v0 = feed.version( n1 );
+
+        feed.push( Change{ .node = n1, .table = table_index< HeadingTable >, .kind = ChangeKind::updated } );
+
+        THEN( "only n1's version advances" )
+        {
+            REQUIRE( feed.version( n1 ) > v0 );
+            REQUIRE( feed.version( n2 ) == v0 );
+        }
+        THEN( "change is delivered on flush" )
+        {
+            REQUIRE( batches.empty() );
+
+            feed.flush();
+
+            REQUIRE( batches.size() == 1 );
+            REQUIRE( batches[ 0 ].size() == 1 );
+            REQUIRE( batches[ 0 ][ 0 ].node == n1 );
+            REQUIRE( feed.pending().empty() );
+        }
+        THEN( "clear advances unchanged nodes past prior versions" )
+        {
+            auto const v1 = feed.version( n1 );
+
+            feed.clear();
+
+            REQUIRE( feed.version( n1 ) > v1 );
+            REQUIRE( feed.version( n2 ) > v1 );
+        }
+    }
+    GIVEN( "held feed" )
+    {
+        {
+            auto const hold = feed.hold();
+
+            feed.push( Change{ .node = n1, .table = table_index< NodeTable >, .kind = ChangeKind::pushed } );
+            feed.flush();
+            feed.push( Change{ .node = n2, .table = table_index< NodeTable >, .kind = ChangeKind::pushed } );
+            feed.flush();
+
+            REQUIRE( batches.empty() );
+        }
+
+        THEN( "changes are delivered as one batch on release" )
+        {
+            REQUIRE( batches.size() == 1 );
+            REQUIRE( batches[ 0 ].size() == 2 );
+        }
+    }
+    GIVEN( "held feed, with a subscriber that throws" )
+    {
+        auto const thrower = feed.subscribe( []( auto const& ){ throw std::runtime_error{ "subscriber failure" }; } );
+
+        auto const release = [ & ]
+        {
+            auto const hold = feed.hold();
+
+            feed.push( Change{ .node = n1, .table = table_index< NodeTable >, .kind = ChangeKind::pushed } );
+        };
+
+        THEN( "releasing the hold doesn't throw" )
+        {
+            REQUIRE_NOTHROW( release() );
+        }
+        THEN( "the feed is no longer held" )
+        {
+            release();
+            feed.unsubscribe( thrower );
+            batches.clear();
+
+            feed.push( Change{ .node = n2, .table = table_index< NodeTable >, .kind = ChangeKind::pushed } );
+            feed.flush();
+
+            REQUIRE( batches.size() == 1 );
+        }
+    }
+    GIVEN( "unsubscribed" )
+    {
+        feed.unsubscribe( sub );
+        feed.push( Change{ .node = n1, .table = table_index< NodeTable >, .kind = ChangeKind::erased } );
+        feed.flush();
+
+        THEN( "nothing is delivered" )
+        {
+            REQUIRE( batches.empty() );
+        }
+    }
+}
+
+} // kmap::com::db
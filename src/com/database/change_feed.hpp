@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#pragma once
+#ifndef KMAP_DB_CHANGE_FEED_HPP
+#define KMAP_DB_CHANGE_FEED_HPP
+
+#include <common.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace kmap::com::db {
+
+enum class ChangeKind
+{
+    pushed
+,   updated
+,   erased
+};
+
+struct Change
+{
+    Uuid node = {};
+    std::size_t table = {}; // table_index< Table >, e.g., table_index< HeadingTable > for a heading change.
+    ChangeKind kind = ChangeKind::pushed;
+
+    auto operator==( Change const& ) const -> bool = default;
+};
+
+/**
+ * @brief Per-node versions, and batches of changes delivered to subscribers, so that views can refresh only what changed.
+ * @note A version is the value of a feed-wide clock at the node's last change, so it increases monotonically, per node, across loads.
+ *       Changes are delivered on flush(), unless held, in which case they accrue until the outermost hold is released.
+ */
+class ChangeFeed
+{
+public:
+    using Batch = std::vector< Change >;
+    using Subscriber = std::function< void( Batch const& ) >;
+    using SubscriberId = std::uint64_t;
+
+    /**
+     * @brief Holds delivery for its lifetime.
+     * @note Release delivers what accrued. A subscriber that throws during it is reported, not propagated, as release happens in a destructor.
+     */
+    class Hold
+    {
+        ChangeFeed* feed_ = {};
+
+    public:
+        Hold( ChangeFeed& feed );
+        Hold( Hold const& ) = delete;
+        ~Hold();
+    };
+
+private:
+    std::uint64_t clock_ = 0;
+    std::uint64_t base_ = 0; // Version of nodes unchanged since load.
+    std::unordered_map< Uuid, std::uint64_t, boost::hash< Uuid > > versions_ = {};
+    Batch pending_ = {};
+    std::map< SubscriberId, Subscriber > subscribers_ = {};
+    SubscriberId next_subscriber_ = 0;
+    unsigned holds_ = 0;
+
+public:
+    /**
+     * @brief Drops versions and pending changes, as on load; nodes then report a version newer than any prior.
+     */
+    auto clear()
+        -> void;
+    /**
+     * @brief Delivers pending changes to subscribers, unless held.
+     */
+    auto flush()
+        -> void;
+    [[ nodiscard ]]
+    auto hold()
+        -> Hold;
+    auto pending() const
+        -> Batch const&;
+    auto push( Change const& change )
+        -> void;
+    auto subscribe( Subscriber const& subscriber )
+        -> SubscriberId;
+    auto unsubscribe( SubscriberId const id )
+        -> void;
+    auto version( Uuid const& node ) const
+        -> std::uint64_t;
+};
+
+} // kmap::com::db
+
+#endif // KMAP_DB_CHANGE_FEED_HPP
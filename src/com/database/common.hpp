@@ -8,6 +8,7 @@
 #define KMAP_DB_COMMON_HPP
 
 #include <common.hpp>
+#include <contract.hpp>
 #include <error/db.hpp>
 #include <error/master.hpp>
 #include <utility.hpp>
@@ -80,6 +81,33 @@ struct DeltaItem
 template< typename Value >
 using DeltaItems = std::vector< DeltaItem< Value > >;
 
+/**
+ * @brief Appends `item`, compacting the chain to its latest value and action, so a repeatedly edited key holds a single delta between flushes.
+ * @note A `created` head is retained through subsequent changes, as erasing a created-only key clears it rather than recording an erasure.
+ */
+template< typename Value >
+auto append_delta( DeltaItems< Value >& items
+                 , DeltaItem< Value > const& item )
+    -> void
+{
+    if( items.empty() )
+    {
+        items.emplace_back( item );
+    }
+    else if( items.back().action == DeltaType::created
+          && item.action == DeltaType::changed )
+    {
+        items.back().value = item.value;
+        items.back().transaction_id = item.transaction_id;
+    }
+    else
+    {
+        items.back() = item;
+    }
+
+    BC_ASSERT( items.size() == 1 );
+}
+
 template< typename Left
         , typename Right >
 struct TableItemLR
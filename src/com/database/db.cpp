@@ -29,6 +29,7 @@
 #include <boost/hana/for_each.hpp>
 #include <boost/hana/reverse.hpp>
 #include <range/v3/action/sort.hpp>
+#include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/algorithm/find.hpp>
 #include <range/v3/algorithm/find.hpp>
 #include <range/v3/range/conversion.hpp>
@@ -153,12 +154,27 @@ auto Database::load_internal( FsPath const& path )
 
     fmt::print( "Database :: load: {}\n", path_.string() );
 
+    stmt_cache_.clear();
+    body_cache_.clear();
+    query_cache_.clear();
+    change_feed_.clear();
+    order_index_.clear();
+    bodies_paged_ = ( body_cache_.budget() != 0 );
+
 #if KMAP_LOGGING_DB
     con_ = std::make_unique< sql::connection >( this->open_connection( path_, SQLITE_OPEN_READONLY, true ) );
 #else
     con_ = std::make_unique< sql::connection >( this->open_connection( path_, SQLITE_OPEN_READONLY, false ) );
 #endif
 
+    // Note: Map files predating versioning report 0, and store UUIDs as text.
+    if( auto const version = KTRY( db::fetch_schema_version( *con_ ) )
+      ; version != db::schema_version )
+    {
+        return KMAP_MAKE_ERROR_MSG( error_code::db::schema_mismatch
+                                  , fmt::format( "map schema v{} found, v{} expected; upgrade via kmap.migrate_map( path )", version, db::schema_version ) );
+    }
+
     {
         auto proc_table = [ & ]( auto&& table ) mutable
         {
@@ -174,7 +190,7 @@ auto Database::load_internal( FsPath const& path )
 
                 for( auto const& e : rows )
                 {
-                    KTRYE( push_node( KTRYE( uuid_from_string( e.uuid ) ) ) );
+                    KTRYE( push_node( KTRYE( uuid_from_blob( e.uuid.value() ) ) ) );
                 }
             }
             else if constexpr( std::is_same_v< Table, db::HeadingTable > )
@@ -186,7 +202,7 @@ auto Database::load_internal( FsPath const& path )
 
                 for( auto const& e : rows )
                 {
-                    KTRYE( push_heading( KTRYE( uuid_from_string( e.uuid ) ), e.heading ) );
+                    KTRYE( push_heading( KTRYE( uuid_from_blob( e.uuid.value() ) ), e.heading ) );
                 }
             }
             else if constexpr( std::is_same_v< Table, db::TitleTable > )
@@ -198,19 +214,35 @@ auto Database::load_internal( FsPath const& path )
 
                 for( auto const& e : rows )
                 {
-                    KTRYE( push_title( KTRYE( uuid_from_string( e.uuid ) ), e.title ) );
+                    KTRYE( push_title( KTRYE( uuid_from_blob( e.uuid.value() ) ), e.title ) );
                 }
             }
             else if constexpr( std::is_same_v< Table, db::BodyTable > )
             {
                 auto t = bodies::bodies{};
-                auto rows = execute( select( all_of( t ) )
-                                   . from( t )
-                                   . unconditionally() );
 
-                for( auto const& e : rows )
+                if( bodies_paged_ )
+                {
+                    // Only presence is loaded. Bodies are paged in on fetch.
+                    auto rows = execute( select( t.uuid )
+                                       . from( t )
+                                       . unconditionally() );
+
+                    for( auto const& e : rows )
+                    {
+                        KTRYE( push_body( KTRYE( uuid_from_blob( e.uuid.value() ) ), std::string{} ) );
+                    }
+                }
+                else
                 {
-                    KTRYE( push_body( KTRYE( uuid_from_string( e.uuid ) ), e.body ) );
+                    auto rows = execute( select( all_of( t ) )
+                                       . from( t )
+                                       . unconditionally() );
+
+                    for( auto const& e : rows )
+                    {
+                        KTRYE( push_body( KTRYE( uuid_from_blob( e.uuid.value() ) ), e.body ) );
+                    }
                 }
             }
             else if constexpr( std::is_same_v< Table, db::ChildTable > )
@@ -222,7 +254,7 @@ auto Database::load_internal( FsPath const& path )
 
                 for( auto const& e : rows )
                 {
-                    KTRYE( push_child( KTRYE( uuid_from_string( e.parent_uuid ) ), KTRYE( uuid_from_string( e.child_uuid ) ) ) );
+                    KTRYE( push_child( KTRYE( uuid_from_blob( e.parent_uuid.value() ) ), KTRYE( uuid_from_blob( e.child_uuid.value() ) ) ) );
                 }
             }
             else if constexpr( std::is_same_v< Table, db::AliasTable > )
@@ -234,7 +266,7 @@ auto Database::load_internal( FsPath const& path )
 
                 for( auto const& e : rows )
                 {
-                    KTRYE( push_alias( KTRYE( uuid_from_string( e.src_uuid ) ), KTRYE( uuid_from_string( e.dst_uuid ) ) ) );
+                    KTRYE( push_alias( KTRYE( uuid_from_blob( e.src_uuid.value() ) ), KTRYE( uuid_from_blob( e.dst_uuid.value() ) ) ) );
                 }
             }
             else if constexpr( std::is_same_v< Table, db::AttributeTable > )
@@ -246,7 +278,7 @@ auto Database::load_internal( FsPath const& path )
 
                 for( auto const& e : rows )
                 {
-                    KTRYE( push_attr( KTRYE( uuid_from_string( e.parent_uuid ) ), KTRYE( uuid_from_string( e.child_uuid ) ) ) );
+                    KTRYE( push_attr( KTRYE( uuid_from_blob( e.parent_uuid.value() ) ), KTRYE( uuid_from_blob( e.child_uuid.value() ) ) ) );
                 }
             }
             else if constexpr( std::is_same_v< Table, db::ResourceTable > )
@@ -271,6 +303,8 @@ auto Database::load_internal( FsPath const& path )
     }
 
     {
+        stmt_cache_.clear();
+
 #if KMAP_LOGGING_DB
         con_ = std::make_unique< sql::connection >( this->open_connection( path_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, true ) );
 #else
@@ -278,6 +312,8 @@ auto Database::load_internal( FsPath const& path )
 #endif
     }
 
+    KTRY( apply_journal_mode() );
+
     rv = outcome::success();
 
     return rv;
@@ -309,6 +345,14 @@ auto Database::init_db_on_disk( FsPath const& path )
         path_.replace_extension( "kmap" );
     }
 
+    // Paged-out bodies live only in the prior file, so must be brought in before the connection is replaced.
+    if( con_ && bodies_paged_ )
+    {
+        KTRY( materialize_bodies() );
+    }
+
+    stmt_cache_.clear();
+
 #if KMAP_LOGGING_DB
     con_ = std::make_unique< sql::connection >( this->open_connection( path_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, true ) );
 #else
@@ -335,6 +379,8 @@ auto Database::init_db_on_disk( FsPath const& path )
 
     create_tables();
 
+    KTRY( apply_journal_mode() );
+
     rv = outcome::success();
 
     return rv;
@@ -343,8 +389,6 @@ auto Database::init_db_on_disk( FsPath const& path )
 auto Database::cache()
     -> db::Cache&
 {
-    query_cache_.clear();
-
     return cache_;
 }
 
@@ -354,6 +398,24 @@ auto Database::cache() const
     return cache_;
 }
 
+auto Database::change_feed()
+    -> db::ChangeFeed&
+{
+    return change_feed_;
+}
+
+auto Database::change_feed() const
+    -> db::ChangeFeed const&
+{
+    return change_feed_;
+}
+
+auto Database::fetch_version( Uuid const& node ) const
+    -> std::uint64_t
+{
+    return change_feed_.version( node );
+}
+
 auto Database::query_cache()
     -> db::QueryCache&
 {
@@ -413,6 +475,7 @@ auto Database::push_child( Uuid const& parent
     KMAP_ENSURE( node_exists( child ), error_code::network::invalid_node ); 
 
     KTRY( cache().push< db::ChildTable >( db::Parent{ parent }, db::Child{ child } ) );
+    changed< db::ChildTable >( db::ChangeKind::pushed, parent, child );
     // cache().push( TableId::attributes, child, db::AttributeValue{ fmt::format( "order:{}", 1 ) } );
 
     rv = outcome::success();
@@ -466,6 +529,57 @@ SCENARIO( "Database::push_child", "[benchmark][db]" )
     };
 }
 
+SCENARIO( "Database writes version nodes and feed changes", "[db][change_feed]" )
+{
+    KMAP_COMPONENT_FIXTURE_SCOPED( "database" );
+
+    auto& km = kmap::Singleton::instance();
+    auto const db = REQUIRE_TRY( km.fetch_component< com::Database >() );
+    auto batches = std::vector< db::ChangeFeed::Batch >{};
+    auto const sub = db->change_feed().subscribe( [ & ]( auto const& batch ){ batches.emplace_back( batch ); } );
+    auto const n1 = gen_uuid();
+
+    GIVEN( "pushed node with heading" )
+    {
+        REQUIRE_TRY( db->push_node( n1 ) );
+        REQUIRE_TRY( db->push_heading( n1, "1" ) );
+
+        THEN( "each push is delivered" )
+        {
+            REQUIRE( batches.size() == 2 );
+            REQUIRE( batches[ 1 ] == db::ChangeFeed::Batch{ db::Change{ .node = n1, .table = db::table_index< db::HeadingTable >, .kind = db::ChangeKind::pushed } } );
+        }
+
+        WHEN( "heading is updated" )
+        {
+            auto const v0 = db->fetch_version( n1 );
+
+            REQUIRE_TRY( db->update_heading( n1, "2" ) );
+
+            THEN( "version advances" )
+            {
+                REQUIRE( db->fetch_version( n1 ) > v0 );
+                REQUIRE( batches.back().back().kind == db::ChangeKind::updated );
+            }
+        }
+        WHEN( "node is erased" )
+        {
+            batches.clear();
+
+            REQUIRE_TRY( db->erase_all( n1 ) );
+
+            THEN( "cascade is delivered as one batch" )
+            {
+                REQUIRE( batches.size() == 1 );
+                REQUIRE( batches[ 0 ].size() == 2 );
+                REQUIRE( ranges::all_of( batches[ 0 ], []( auto const& c ){ return c.kind == db::ChangeKind::erased; } ) );
+            }
+        }
+    }
+
+    db->change_feed().unsubscribe( sub );
+}
+
 auto Database::push_node( Uuid const& id )
     -> Result< void >
 {
@@ -477,6 +591,7 @@ auto Database::push_node( Uuid const& id )
     auto rv = KMAP_MAKE_RESULT( void );
 
     KTRY( cache().push< db::NodeTable >( id ) );
+    changed< db::NodeTable >( db::ChangeKind::pushed, id );
 
     rv = outcome::success();
 
@@ -496,6 +611,7 @@ auto Database::push_heading( Uuid const& node
     auto rv = KMAP_MAKE_RESULT( void );
 
     KTRY( cache().push< db::HeadingTable >( node, heading ) );
+    changed< db::HeadingTable >( db::ChangeKind::pushed, node );
 
     rv = outcome::success();
 
@@ -514,7 +630,11 @@ auto Database::push_body( Uuid const& node
 
     auto rv = KMAP_MAKE_RESULT( void );
 
+    // The cache decider compares against the cached body, so it can't be a placeholder.
+    KTRY( page_in_body( node ) );
     KTRY( cache().push< db::BodyTable >( node, body ) );
+    changed< db::BodyTable >( db::ChangeKind::pushed, node );
+    order_index_.erase_order_node( node );
 
     rv = outcome::success();
 
@@ -534,6 +654,7 @@ auto Database::push_title( Uuid const& node
     auto rv = KMAP_MAKE_RESULT( void );
 
     KTRY( cache().push< db::TitleTable >( node, title ) );
+    changed< db::TitleTable >( db::ChangeKind::pushed, node );
 
     rv = outcome::success();
 
@@ -553,6 +674,7 @@ auto Database::push_attr( Uuid const& parent
     auto rv = KMAP_MAKE_RESULT( void );
 
     KTRY( cache().push< db::AttributeTable >( db::Left{ parent }, db::Right{ attr } ) );
+    changed< db::AttributeTable >( db::ChangeKind::pushed, parent, attr );
 
     rv = outcome::success();
 
@@ -635,6 +757,7 @@ auto Database::push_alias( Uuid const& src
     KMAP_ENSURE( !alias_exists( src, dst ), error_code::network::invalid_node );
 
     KTRY( cache().push< db::AliasTable >( db::Left{ src }, db::Right{ dst } ) );
+    changed< db::AliasTable >( db::ChangeKind::pushed, src, dst );
 
     rv = outcome::success();
 
@@ -656,6 +779,190 @@ auto Database::path() const
     }
 }
 
+auto Database::body_cache() const
+    -> db::BodyCache const&
+{
+    return body_cache_;
+}
+
+auto Database::statement_stats() const
+    -> db::StatementCache::Stats const&
+{
+    return stmt_cache_.stats();
+}
+
+auto Database::set_body_cache_budget( std::size_t const bytes )
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_STR( "bytes", std::to_string( bytes ) );
+
+    auto rv = KMAP_MAKE_RESULT( void );
+
+    body_cache_.set_budget( bytes );
+
+    if( bodies_paged_ )
+    {
+        if( bytes == 0 )
+        {
+            KTRY( materialize_bodies() );
+        }
+        else
+        {
+            KTRY( trim_body_cache() );
+        }
+    }
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+auto Database::materialize_bodies()
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = KMAP_MAKE_RESULT( void );
+
+    BC_CONTRACT()
+        BC_PRE([ & ]
+        {
+            BC_ASSERT( con_ );
+        })
+        BC_POST([ & ]
+        {
+            if( rv )
+            {
+                BC_ASSERT( !bodies_paged_ );
+            }
+        })
+    ;
+
+    if( bodies_paged_ )
+    {
+        // A single scan, rather than a select per body.
+        auto t = db::bodies::bodies{};
+        auto rows = execute( select( all_of( t ) )
+                           . from( t )
+                           . unconditionally() );
+
+        for( auto const& e : rows )
+        {
+            auto const id = KTRY( db::uuid_from_blob( e.uuid.value() ) );
+
+            if( !body_cache_.contains( id )
+             && cache_.contains_cached< db::BodyTable >( id )
+             && !cache_.contains_delta< db::BodyTable >( id ) )
+            {
+                KTRY( cache_.page< db::BodyTable >( id, e.body ) );
+            }
+        }
+
+        body_cache_.clear();
+        bodies_paged_ = false;
+    }
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+auto Database::page_in_body( Uuid const& node ) const
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH( "node", to_string( node ) );
+
+    auto rv = KMAP_MAKE_RESULT( void );
+
+    // Dirty bodies are read from their delta; bodies yet to be flushed have no cached value to page.
+    if( bodies_paged_
+     && cache_.contains_cached< db::BodyTable >( node )
+     && !cache_.contains_delta< db::BodyTable >( node )
+     && !body_cache_.touch( node ) )
+    {
+        auto const body = KTRY( db::select_body( *con_, stmt_cache_, to_string( node ) ) );
+
+        KTRY( cache_.page< db::BodyTable >( node, body ) );
+
+        body_cache_.push( node, body.size() );
+
+        KTRY( trim_body_cache() );
+    }
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+/**
+ * @note Dirty bodies are pinned: their flushed value may yet be needed by the cache decider, and they are re-admitted, with their new size, once flushed.
+ */
+auto Database::trim_body_cache() const
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = KMAP_MAKE_RESULT( void );
+    auto const& dirty = cache_.delta_keys< db::BodyTable >();
+    auto const evicted = body_cache_.trim( [ & ]( Uuid const& key ){ return dirty.contains( key ); } );
+
+    for( auto const& key : evicted )
+    {
+        KTRY( cache_.page< db::BodyTable >( key, std::string{} ) );
+    }
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+auto Database::set_journal_mode( std::string const& mode )
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_STR( "mode", mode );
+
+    auto rv = KMAP_MAKE_RESULT( void );
+    auto const valid_modes = std::set< std::string >{ "delete", "truncate", "persist", "memory", "wal", "off" };
+
+    KMAP_ENSURE_MSG( valid_modes.contains( mode ), error_code::common::uncategorized, fmt::format( "invalid journal mode: {}", mode ) );
+
+    journal_mode_ = mode;
+
+    if( con_ )
+    {
+        KTRY( apply_journal_mode() );
+    }
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+auto Database::apply_journal_mode()
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_STR( "mode", journal_mode_ );
+
+    auto rv = KMAP_MAKE_RESULT( void );
+
+    BC_CONTRACT()
+        BC_PRE([ & ]
+        {
+            BC_ASSERT( con_ );
+        })
+    ;
+
+    KTRY( com::apply_journal_mode( *con_, journal_mode_ ) );
+
+    rv = outcome::success();
+
+    return rv;
+}
+
 auto Database::open_connection( FsPath const& db_path
                               , int flags
                               , bool debug )
@@ -698,6 +1005,8 @@ auto Database::fetch_alias_destinations( Uuid const& src ) const
         })
     ;
 
+    query_cache_.record( src );
+
     auto r = cache().fetch_values< db::AliasTable >( db::Left{ src } );
 
     if( r )
@@ -818,6 +1127,8 @@ auto Database::fetch_parent( Uuid const& id ) const
         })
     ;
 
+    query_cache_.record( id );
+
     auto const parent = KTRY( cache().fetch_values< db::ChildTable >( db::Child{ id } ) );
 
     BC_ASSERT( parent.size() == 1 );
@@ -842,7 +1153,7 @@ auto Database::fetch_child( Uuid const& parent
     auto rv = KMAP_MAKE_RESULT( Uuid );
     auto const children = KTRY( fetch_children( parent ) );
     auto const headings = children
-                        | views::transform( [ & ]( auto const& e ){ return std::make_pair( e, KTRYE( fetch_heading( e ) ) ); } )
+                        | views::transform( [ & ]( auto const& e ){ return std::make_pair( e, KTRYE( fetch_heading_view( e ) ) ); } )
                         | views::filter( [ & ]( auto const& e ){ return e.second == heading; } )
                         | to_vector;
     
@@ -862,11 +1173,27 @@ auto Database::fetch_body( Uuid const& id ) const
     KM_RESULT_PROLOG();
         // KM_RESULT_PUSH_NODE( "node", id );
 
+    auto rv = KMAP_MAKE_RESULT( std::string );
+
+    rv = std::string{ KTRY( fetch_body_view( id ) ) };
+
+    return rv;
+}
+
+auto Database::fetch_body_view( Uuid const& id ) const
+    -> Result< std::string_view >
+{
+    KM_RESULT_PROLOG();
+
     KMAP_ENSURE_EXCEPT( node_exists( id ) ); // TODO: replace with ensure_result
 
-    auto rv = KMAP_MAKE_RESULT( std::string );
+    auto rv = KMAP_MAKE_RESULT( std::string_view );
+
+    KTRY( page_in_body( id ) );
 
-    rv = KTRY( cache().fetch_value< db::BodyTable >( id ) );
+    query_cache_.record( id );
+
+    rv = std::string_view{ KTRY( cache().fetch_value_ref< db::BodyTable >( id ) ).get() };
 
     return rv;
 }
@@ -876,18 +1203,25 @@ auto Database::fetch_heading( Uuid const& id ) const
 {
     KM_RESULT_PROLOG();
 
+    auto rv = KMAP_MAKE_RESULT( Heading );
+
+    rv = Heading{ KTRY( fetch_heading_view( id ) ) };
+
+    return rv;
+}
+
+auto Database::fetch_heading_view( Uuid const& id ) const
+    -> Result< std::string_view >
+{
+    KM_RESULT_PROLOG();
+
     KMAP_ENSURE_EXCEPT( node_exists( id ) ); // TODO: replace with ensure_result
 
-    auto rv = KMAP_MAKE_RESULT( Heading );
+    auto rv = KMAP_MAKE_RESULT( std::string_view );
 
-    BC_CONTRACT()
-        BC_PRE([ & ]
-        {
-            BC_ASSERT( node_exists( id ) );
-        })
-    ;
+    query_cache_.record( id );
 
-    rv = KTRY( cache().fetch_value< db::HeadingTable >( id ) );
+    rv = std::string_view{ KTRY( cache().fetch_value_ref< db::HeadingTable >( id ) ).get() };
 
     return rv;
 }
@@ -909,6 +1243,8 @@ auto Database::fetch_attr( Uuid const& id ) const
     ;
 
     // TODO: attr should only ever 1 parent, so the table type should represent this.
+    query_cache_.record( id );
+
     auto const attr = KTRY( cache().fetch_values< db::AttributeTable >( db::Left{ id } ) );
 
     if( attr.size() == 1 )
@@ -930,6 +1266,8 @@ auto Database::fetch_attr_owner( Uuid const& attrn ) const
     KMAP_ENSURE( node_exists( attrn ), error_code::network::invalid_node );
 
     // TODO: attr should only ever 1 parent, so the table type should represent this.
+    query_cache_.record( attrn );
+
     auto const attr = KTRY( cache().fetch_values< db::AttributeTable >( db::Right{ attrn } ) );
 
     BC_ASSERT( attr.size() == 1 );
@@ -956,6 +1294,61 @@ auto Database::fetch_nodes( Heading const& heading ) const
     return rv;
 }
 
+auto Database::fetch_order( Uuid const& parent ) const
+    -> Result< UuidVec >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_NODE( "parent", parent );
+
+    auto rv = KMAP_MAKE_RESULT( UuidVec );
+
+    if( auto const entry = order_index_.fetch( parent )
+      ; entry )
+    {
+        query_cache_.record( entry.value().get().order_node );
+
+        rv = entry.value().get().children;
+    }
+    else
+    {
+        auto const attrn = KTRY( fetch_attr( parent ) );
+        auto const ordern = KTRY( fetch_child( attrn, "order" ) );
+        auto const body = KTRY( fetch_body_view( ordern ) );
+
+        rv = KTRY( order_index_.push( parent, ordern, body ) ).get().children;
+    }
+
+    return rv;
+}
+
+auto Database::fetch_order_position( Uuid const& parent
+                                   , Uuid const& child ) const
+    -> Result< std::size_t >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_NODE( "parent", parent );
+        KM_RESULT_PUSH_NODE( "child", child );
+
+    auto rv = KMAP_MAKE_RESULT( std::size_t );
+
+    if( !order_index_.fetch( parent ) )
+    {
+        KTRY( fetch_order( parent ) );
+    }
+
+    auto const& entry = KTRY( order_index_.fetch( parent ) ).get();
+
+    query_cache_.record( entry.order_node );
+
+    if( auto const it = entry.positions.find( child )
+      ; it != entry.positions.end() )
+    {
+        rv = it->second;
+    }
+
+    return rv;
+}
+
 // auto Database::fetch_bodies() const
 //     -> UniqueIdMultiStrSet
 // {
@@ -988,7 +1381,7 @@ auto Database::fetch_title( Uuid const& id ) const
 
     auto rv = KMAP_MAKE_RESULT( std::string );
 
-    rv = KTRY( cache().fetch_value< db::TitleTable >( id ) );
+    rv = std::string{ KTRY( fetch_title_view( id ) ) };
 
     // auto const& titles = cache().fetch_titles();
     // auto const& map = titles.set.get< 1 >();
@@ -1018,12 +1411,28 @@ auto Database::fetch_title( Uuid const& id ) const
     return rv;
 }
 
-auto Database::fetch_genesis_time( Uuid const& id ) const
-    -> Optional< uint64_t >
+auto Database::fetch_title_view( Uuid const& id ) const
+    -> Result< std::string_view >
 {
-    KMAP_THROW_EXCEPTION_MSG( "deprecated" );
-    auto rv = Optional< uint64_t >{};
-    // auto const& sid = to_string( id );
+    KM_RESULT_PROLOG();
+
+    KMAP_ENSURE_EXCEPT( node_exists( id ) ); // TODO: replace with ensure_result
+
+    auto rv = KMAP_MAKE_RESULT( std::string_view );
+
+    query_cache_.record( id );
+
+    rv = std::string_view{ KTRY( cache().fetch_value_ref< db::TitleTable >( id ) ).get() };
+
+    return rv;
+}
+
+auto Database::fetch_genesis_time( Uuid const& id ) const
+    -> Optional< uint64_t >
+{
+    KMAP_THROW_EXCEPTION_MSG( "deprecated" );
+    auto rv = Optional< uint64_t >{};
+    // auto const& sid = to_string( id );
     // auto gtt = genesis_times::genesis_times{};
     // auto const& rt = execute( select( all_of( gtt ) )
     //                         . from( gtt )
@@ -1084,6 +1493,7 @@ auto Database::update_heading( Uuid const& node
     KMAP_ENSURE( node_exists( node ), error_code::network::invalid_node );
 
     KTRY( cache().push< db::HeadingTable >( node, heading ) );
+    changed< db::HeadingTable >( db::ChangeKind::updated, node );
 
     rv = outcome::success();
 
@@ -1113,6 +1523,7 @@ auto Database::update_title( Uuid const& node
     KMAP_ENSURE( node_exists( node ), error_code::network::invalid_node );
 
     KTRY( cache().push< db::TitleTable >( node, title ) );
+    changed< db::TitleTable >( db::ChangeKind::updated, node );
 
     rv = outcome::success();
 
@@ -1130,7 +1541,10 @@ auto Database::update_body( Uuid const& node
 
     KMAP_ENSURE( node_exists( node ), error_code::network::invalid_node );
 
+    KTRY( page_in_body( node ) );
     KTRY( cache().push< db::BodyTable >( node, content ) );
+    changed< db::BodyTable >( db::ChangeKind::updated, node );
+    order_index_.erase_order_node( node );
 
     rv = outcome::success();
 
@@ -1140,6 +1554,8 @@ auto Database::update_body( Uuid const& node
 auto Database::node_exists( Uuid const& id ) const
     -> bool
 {
+    query_cache_.record( id );
+
     return !cache().contains_erased_delta< db::NodeTable >( id )
         && ( cache().contains_cached< db::NodeTable >( id )
           || cache().contains_delta< db::NodeTable >( id ) );
@@ -1150,6 +1566,8 @@ auto Database::attr_exists( Uuid const& id ) const
 {
     auto const key = db::Child{ id };
 
+    query_cache_.record( id );
+
     return !cache().contains_erased_delta< db::AttributeTable >( key )
         && ( cache().contains_cached< db::AttributeTable >( key )
           || cache().contains_delta< db::AttributeTable >( key ) );
@@ -1161,6 +1579,9 @@ auto Database::alias_exists( Uuid const& src
 {
     auto const key = db::AliasTable::unique_key_type{ db::Src{ src }, db::Dst{ dst } };
 
+    query_cache_.record( src );
+    query_cache_.record( dst );
+
     return !cache().contains_erased_delta< db::AliasTable >( key )
         && ( cache().contains_cached< db::AliasTable >( key )
           || cache().contains_delta< db::AliasTable >( key ) );
@@ -1192,6 +1613,12 @@ auto Database::has_parent( Uuid const& child ) const
 
 auto Database::erase_all( Uuid const& id )
     -> Result< void >
+{
+    return erase_all( UuidVec{ id } );
+}
+
+auto Database::erase_all( UuidVec const& ids )
+    -> Result< void >
 {
     KM_RESULT_PROLOG();
 
@@ -1206,81 +1633,95 @@ auto Database::erase_all( Uuid const& id )
         })
     ;
 
-    // This needs to delete all table items with LHS or RHS (as applicable) is ID; "Cascade."
+    auto const hold = change_feed_.hold(); // Deliver the cascade as one batch.
 
+    // This needs to delete all table items with LHS or RHS (as applicable) is ID; "Cascade."
+    // Visiting table by table, so that each table is swept once for all IDs.
     auto const fn = [ & ]( auto const& table )
     {
         using Table = std::decay_t< decltype( table ) >;
 
-        if constexpr( std::is_same_v< Table, db::NodeTable > )
+        for( auto const& id : ids )
         {
-            if( contains< Table >( id ) )
+            if constexpr( std::is_same_v< Table, db::NodeTable > )
             {
-                KTRYE( cache().erase< Table >( id ) );
+                if( contains< Table >( id ) )
+                {
+                    KTRYE( cache().erase< Table >( id ) );
+                    changed< Table >( db::ChangeKind::erased, id );
+                }
             }
-        }
-        else if constexpr( std::is_same_v< Table, db::HeadingTable > )
-        {
-            if( contains< Table >( id ) )
+            else if constexpr( std::is_same_v< Table, db::HeadingTable > )
             {
-                KTRYE( cache().erase< Table >( id ) );
+                if( contains< Table >( id ) )
+                {
+                    KTRYE( cache().erase< Table >( id ) );
+                    changed< Table >( db::ChangeKind::erased, id );
+                }
             }
-        }
-        else if constexpr( std::is_same_v< Table, db::TitleTable > )
-        {
-            if( contains< Table >( id ) )
+            else if constexpr( std::is_same_v< Table, db::TitleTable > )
             {
-                KTRYE( cache().erase< Table >( id ) );
+                if( contains< Table >( id ) )
+                {
+                    KTRYE( cache().erase< Table >( id ) );
+                    changed< Table >( db::ChangeKind::erased, id );
+                }
             }
-        }
-        else if constexpr( std::is_same_v< Table, db::BodyTable > )
-        {
-            if( cache().contains< Table >( id ) )
+            else if constexpr( std::is_same_v< Table, db::BodyTable > )
             {
-                KTRYE( cache().erase< Table >( id ) );
+                if( cache().contains< Table >( id ) )
+                {
+                    KTRYE( cache().erase< Table >( id ) );
+                    changed< Table >( db::ChangeKind::erased, id );
+                    order_index_.erase_order_node( id );
+                }
             }
-        }
-        else if constexpr( std::is_same_v< Table, db::ResourceTable > )
-        {
-            if( cache().contains< Table >( id ) )
+            else if constexpr( std::is_same_v< Table, db::ResourceTable > )
             {
-                KTRYE( cache().erase< Table >( id ) );
+                if( cache().contains< Table >( id ) )
+                {
+                    KTRYE( cache().erase< Table >( id ) );
+                    changed< Table >( db::ChangeKind::erased, id );
+                }
             }
-        }
-        else if constexpr( std::is_same_v< Table, db::AttributeTable > )
-        {
-            if( auto const parent = fetch_attr_owner( id )
-              ; parent )
+            else if constexpr( std::is_same_v< Table, db::AttributeTable > )
             {
-                KTRYE( cache().erase< Table >( db::Parent{ parent.value() }, db::Child{ id } ) );
+                if( auto const parent = fetch_attr_owner( id )
+                  ; parent )
+                {
+                    KTRYE( cache().erase< Table >( db::Parent{ parent.value() }, db::Child{ id } ) );
+                    changed< Table >( db::ChangeKind::erased, parent.value(), id );
+                }
             }
-        }
-        else if constexpr( std::is_same_v< Table, db::ChildTable > )
-        {
-            if( auto const parent = fetch_parent( id )
-              ; parent )
+            else if constexpr( std::is_same_v< Table, db::ChildTable > )
             {
-                KTRYE( cache().erase< Table >( db::Parent{ parent.value() }, db::Child{ id } ) );
+                if( auto const parent = fetch_parent( id )
+                  ; parent )
+                {
+                    KTRYE( cache().erase< Table >( db::Parent{ parent.value() }, db::Child{ id } ) );
+                    changed< Table >( db::ChangeKind::erased, parent.value(), id );
+                }
             }
-        }
-        else if constexpr( std::is_same_v< Table, db::AliasTable > )
-        {
-            // TODO: Deleting alias dsts is a problem, in current state. Doesn't mesh with current alias gen system.
-            //       Actually, it _could_, so long as those are deleted also (preferably before this is called).
-            if( auto const dsts = fetch_alias_destinations( id )
-              ; dsts )
+            else if constexpr( std::is_same_v< Table, db::AliasTable > )
             {
-                auto const& dstsv = dsts.value();
-
-                for( auto const& dst : dstsv )
+                // TODO: Deleting alias dsts is a problem, in current state. Doesn't mesh with current alias gen system.
+                //       Actually, it _could_, so long as those are deleted also (preferably before this is called).
+                if( auto const dsts = fetch_alias_destinations( id )
+                  ; dsts )
                 {
-                    KTRYE( cache().erase< Table >( db::Src{ id }, db::Dst{ dst } ) );
+                    auto const& dstsv = dsts.value();
+
+                    for( auto const& dst : dstsv )
+                    {
+                        KTRYE( cache().erase< Table >( db::Src{ id }, db::Dst{ dst } ) );
+                        changed< Table >( db::ChangeKind::erased, id, dst );
+                    }
                 }
             }
-        }
-        else
-        {
-            static_assert( always_false< Table >::value, "non-exhaustive visitor!" );
+            else
+            {
+                static_assert( always_false< Table >::value, "non-exhaustive visitor!" );
+            }
         }
     };
 
@@ -1348,6 +1789,8 @@ auto Database::fetch_children( Uuid const& parent ) const
 
     KMAP_ENSURE( node_exists( parent ), error_code::network::invalid_node );
 
+    query_cache_.record( parent );
+
     if( auto const vs = cache().fetch_values< db::ChildTable >( db::Parent{ parent } )
       ; vs )
     {
@@ -1425,6 +1868,7 @@ auto Database::erase_child( Uuid const& parent
     KMAP_ENSURE( is_child( parent, child ), error_code::network::invalid_parent );
 
     KTRY( cache().erase< db::ChildTable >( db::Parent{ parent }, db::Child{ child } ) );
+    changed< db::ChildTable >( db::ChangeKind::erased, parent, child );
     
     rv = outcome::success();
 
@@ -1463,12 +1907,90 @@ auto Database::erase_alias( Uuid const& src
     KMAP_ENSURE( alias_exists( src, dst ), error_code::network::invalid_alias );
 
     KTRY( cache().erase< db::AliasTable >( db::Src{ src }, db::Dst{ dst } ) );
+    changed< db::AliasTable >( db::ChangeKind::erased, src, dst );
     
     rv = outcome::success();
 
     return rv;
 }
 
+namespace {
+
+/**
+ * @brief Table name and columns of the on-disk table mirroring `Table`. When `key_only`, only the columns composing the unique key.
+ */
+template< typename Table >
+auto make_row_batch( bool const key_only )
+    -> db::RowBatch
+{
+    using namespace db;
+
+    auto const make = []( std::string const& table
+                        , std::vector< std::string > const& cols )
+    {
+        auto rb = RowBatch{ .table = table };
+
+        for( auto const& col : cols )
+        {
+            rb.columns.emplace_back( RowBatch::Column{ .name = col, .blob = is_uuid_column( col ) || col == "resource" } );
+        }
+
+        return rb;
+    };
+    auto rv = RowBatch{};
+
+    if constexpr( std::is_same_v< Table, NodeTable > ) { rv = make( "nodes", { "uuid" } ); }
+    else if constexpr( std::is_same_v< Table, HeadingTable > ) { rv = make( "headings", { "uuid", "heading" } ); }
+    else if constexpr( std::is_same_v< Table, TitleTable > ) { rv = make( "titles", { "uuid", "title" } ); }
+    else if constexpr( std::is_same_v< Table, BodyTable > ) { rv = make( "bodies", { "uuid", "body" } ); }
+    else if constexpr( std::is_same_v< Table, ChildTable > ) { rv = make( "children", { "parent_uuid", "child_uuid" } ); }
+    else if constexpr( std::is_same_v< Table, AliasTable > ) { rv = make( "aliases", { "src_uuid", "dst_uuid" } ); }
+    else if constexpr( std::is_same_v< Table, AttributeTable > ) { rv = make( "attributes", { "parent_uuid", "child_uuid" } ); }
+    else if constexpr( std::is_same_v< Table, ResourceTable > ) { rv = make( "resources", { "uuid", "resource" } ); }
+    else { static_assert( always_false< Table >::value, "non-exhaustive visitor!" ); }
+
+    if( key_only
+     && !concepts::Pair< typename Table::unique_key_type > )
+    {
+        rv.columns.resize( 1 );
+    }
+
+    return rv;
+}
+
+template< typename Table >
+auto push_key( db::RowBatch& batch
+             , typename Table::unique_key_type const& ukey )
+    -> void
+{
+    if constexpr( concepts::Pair< typename Table::unique_key_type > )
+    {
+        batch.values.emplace_back( db::uuid_bytes( ukey.first.value() ) );
+        batch.values.emplace_back( db::uuid_bytes( ukey.second.value() ) );
+    }
+    else
+    {
+        batch.values.emplace_back( db::uuid_bytes( ukey ) );
+    }
+}
+
+template< typename Table >
+auto push_row( db::RowBatch& batch
+             , typename Table::unique_key_type const& ukey
+             , typename Table::value_type const& value )
+    -> void
+{
+    push_key< Table >( batch, ukey );
+
+    // Only the string-valued map tables carry a value column beyond the key.
+    if constexpr( std::is_same_v< typename Table::value_type, std::string > )
+    {
+        batch.values.emplace_back( value );
+    }
+}
+
+} // namespace anon
+
 // TODO: This should probably be part of db_fs, and not db proper.
 auto Database::flush_delta_to_disk()
     -> Result< void >
@@ -1493,217 +2015,217 @@ auto Database::flush_delta_to_disk()
 
     KMAP_ENSURE( has_file_on_disk(), error_code::common::uncategorized );
 
-    if( has_delta() )
+    if( !has_delta() )
     {
-        fmt::print( "[kmap][log][db] flush_delta_to_disk: has_delta, flushing...\n" );
+        rv = outcome::success();
+
+        return rv;
     }
 
-    auto proc_table = [ & ]( auto&& table ) mutable
+    fmt::print( "[kmap][log][db] flush_delta_to_disk: has_delta, flushing...\n" );
+
+    auto batches = std::vector< std::pair< db::RowBatch, db::RowBatch > >{}; // { removals, upserts }
+    auto collect = [ & ]( auto const& table )
     {
         using namespace db;
-        using sqlpp::sqlite3::insert_or_replace_into;
-        // using sqlpp::dynamic_remove_from;
-        using sqlpp::remove_from;
-        using sqlpp::parameter;
         using Table = std::decay_t< decltype( table ) >;
 
-        auto delta_pushed = false;
-        auto nt = nodes::nodes{};
-        auto nt_ins = insert_into( nt ).columns( nt.uuid ); // Nodes should never be "replaced"/updated.
-        auto nt_rm = con_->prepare( remove_from( nt ).where( nt.uuid == parameter( nt.uuid ) ) );
-        auto ht = headings::headings{};
-        auto ht_ins = insert_or_replace_into( ht ).columns( ht.uuid, ht.heading );
-        auto ht_rm = con_->prepare( remove_from( ht ).where( ht.uuid == parameter( ht.uuid ) ) );
-        auto tt = titles::titles{};
-        auto tt_ins = insert_or_replace_into( tt ).columns( tt.uuid, tt.title );
-        auto tt_rm = con_->prepare( remove_from( tt ).where( tt.uuid == parameter( tt.uuid ) ) );
-        auto bt = bodies::bodies{};
-        auto bt_ins = insert_or_replace_into( bt ).columns( bt.uuid, bt.body );
-        auto bt_rm = con_->prepare( remove_from( bt ).where( bt.uuid == parameter( bt.uuid ) ) );
-        auto ct = children::children{};
-        auto ct_ins = insert_into( ct ).columns( ct.parent_uuid, ct.child_uuid );
-        auto ct_rm = con_->prepare( remove_from( ct ).where( ct.parent_uuid == parameter( ct.parent_uuid ) && ct.child_uuid == parameter( ct.child_uuid ) ) );
-        auto at = aliases::aliases{};
-        auto at_ins = insert_into( at ).columns( at.src_uuid, at.dst_uuid );
-        auto at_rm = con_->prepare( remove_from( at ).where( at.src_uuid == parameter( at.src_uuid ) && at.dst_uuid == parameter( at.dst_uuid ) ) );
-        auto att = attributes::attributes{};
-        auto att_ins = insert_into( att ).columns( att.parent_uuid, att.child_uuid );
-        auto att_rm = con_->prepare( remove_from( att ).where( att.parent_uuid == parameter( att.parent_uuid ) && att.child_uuid == parameter( att.child_uuid ) ) );
-
-        for( auto const& item : table )
+        if constexpr( std::is_same_v< Table, ResourceTable > )
         {
-            if constexpr( std::is_same_v< Table, NodeTable > )
-            {
-                if( auto const& dis = item.delta_items
-                  ; !dis.empty() )
-                {
-                    if( dis.back().action == DeltaType::erased )
-                    {
-                        nt_rm.params.uuid = to_string( item.key() );
-                        ( *con_ )( nt_rm );
-                        delta_pushed = true;
-                    }
-                    else
-                    {
-                        nt_ins.values.add( nt.uuid = to_string( item.key() ) );
-                    }
-                }
-            }
-            else if constexpr( std::is_same_v< Table, HeadingTable > )
+            // Frankly... this one is a bit of a toughy because the size of the resource may be very large.
+            // It may make more general sense to pass around a file string, res heading, or some such that, at this point,
+            // the file may be stored into the db, so we don't have huge binaries sitting around in the cache. It'll take some thought.
+            BC_ASSERT( cache_.delta_keys< Table >().empty() );
+        }
+        else
+        {
+            auto removals = make_row_batch< Table >( true );
+            auto upserts = make_row_batch< Table >( false );
+            auto const& ut = table.underlying();
+
+            // Only visit entries journaled as carrying a delta, rather than scanning the whole table.
+            for( auto const& ukey : cache_.delta_keys< Table >() )
             {
-                if( auto const& dis = item.delta_items
-                  ; !dis.empty() )
+                auto const it = ut.find( ukey ); BC_ASSERT( it != ut.end() && !it->delta_items.empty() );
+                auto const& di = it->delta_items.back();
+
+                if( di.action == DeltaType::erased )
                 {
-                    if( dis.back().action == DeltaType::erased )
-                    {
-                        ht_rm.params.uuid = to_string( item.key() );
-                        ( *con_ )( ht_rm );
-                        delta_pushed = true;
-                    }
-                    else
-                    {
-                        ht_ins.values.add( ht.uuid = to_string( item.key() ), ht.heading = dis.back().value );
-                    }
+                    push_key< Table >( removals, ukey );
                 }
-            }
-            else if constexpr( std::is_same_v< Table, TitleTable > )
-            {
-                if( auto const& dis = item.delta_items
-                  ; !dis.empty() )
+                else
                 {
-                    if( dis.back().action == DeltaType::erased )
-                    {
-                        tt_rm.params.uuid = to_string( item.key() );
-                        ( *con_ )( tt_rm );
-                        delta_pushed = true;
-                    }
-                    else
-                    {
-                        tt_ins.values.add( tt.uuid = to_string( item.key() ), tt.title = dis.back().value );
-                    }
+                    push_row< Table >( upserts, ukey, di.value );
                 }
             }
-            else if constexpr( std::is_same_v< Table, BodyTable > )
+
+            batches.emplace_back( std::move( removals ), std::move( upserts ) );
+        }
+    };
+    auto apply_delta = [ & ]( auto&& table ) mutable
+    {
+        using Table = std::decay_t< decltype( table ) >;
+
+        cache().apply_delta_to_cache< Table >();
+    };
+
+    boost::hana::for_each( cache_.tables(), collect );
+
+    // The whole delta is written within a single transaction. Should any statement fail, the transaction is rolled back on scope exit, and the delta retained.
+    {
+        auto tx = sqlpp::start_transaction( *con_ );
+
+        for( auto const& [ removals, upserts ] : batches )
+        {
+            KTRY( db::remove_rows( *con_, stmt_cache_, removals ) );
+            KTRY( db::insert_rows( *con_, stmt_cache_, upserts ) );
+        }
+
+        tx.commit();
+    }
+
+    // Flushed bodies become clean, and so evictable; erased ones leave the LRU.
+    auto const flushed_bodies = bodies_paged_
+                              ? std::vector< Uuid >( cache_.delta_keys< db::BodyTable >().begin(), cache_.delta_keys< db::BodyTable >().end() )
+                              : std::vector< Uuid >{};
+
+    // Only apply delta after write is complete.
+    boost::hana::for_each( cache_.tables(), apply_delta );
+
+    if( bodies_paged_ )
+    {
+        for( auto const& key : flushed_bodies )
+        {
+            if( auto const body = cache_.fetch_cached_value< db::BodyTable >( key )
+              ; body )
             {
-                if( auto const& dis = item.delta_items
-                  ; !dis.empty() )
-                {
-                    if( dis.back().action == DeltaType::erased )
-                    {
-                        bt_rm.params.uuid = to_string( item.key() );
-                        ( *con_ )( bt_rm );
-                        delta_pushed = true;
-                    }
-                    else
-                    {
-                        bt_ins.values.add( bt.uuid = to_string( item.key() ), bt.body = dis.back().value );
-                    }
-                }
+                body_cache_.push( key, body.value().size() );
             }
-            else if constexpr( std::is_same_v< Table, ChildTable > )
+            else
             {
-                if( auto const& dis = item.delta_items
-                  ; !dis.empty() )
-                {
-                    if( dis.back().action == DeltaType::erased )
-                    {
-                        ct_rm.params.parent_uuid = to_string( item.left().value() );
-                        ct_rm.params.child_uuid = to_string( item.right().value() );
-                        ( *con_ )( ct_rm );
-                        delta_pushed = true;
-                    }
-                    else
-                    {
-                        ct_ins.values.add( ct.parent_uuid = to_string( dis.back().value.first.value() )
-                                         , ct.child_uuid = to_string( dis.back().value.second.value() ) );
-                    }
-                }
+                body_cache_.erase( key );
             }
-            else if constexpr( std::is_same_v< Table, AliasTable > )
+        }
+
+        KTRY( trim_body_cache() );
+    }
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+SCENARIO( "Database flushes its delta in a single transaction", "[db][flush]" )
+{
+    auto& km = kmap::Singleton::instance();
+    auto db = com::Database{ km, {}, "" };
+
+    KMAP_INIT_DISK_DB_FIXTURE_SCOPED( db );
+
+    // A second connection, as Database::execute_raw flushes before executing.
+    auto probe = db::open_connection( REQUIRE_TRY( db.path() ), SQLITE_OPEN_READWRITE, false );
+    auto const count = [ & ]( std::string const& table )
+    {
+        auto const res = execute_raw( probe, fmt::format( "SELECT COUNT(*) AS n FROM {};", table ) );
+
+        REQUIRE( res.contains( "n" ) );
+
+        return std::stoul( res.find( "n" )->second );
+    };
+
+    GIVEN( "node with heading awaiting flush" )
+    {
+        auto const n1 = gen_uuid();
+
+        REQUIRE_RES( db.push_node( n1 ) );
+        REQUIRE_RES( db.push_heading( n1, "1" ) );
+
+        WHEN( "flushed" )
+        {
+            REQUIRE_RES( db.flush_delta_to_disk() );
+
+            THEN( "every table is written and the delta applied" )
             {
-                if( auto const& dis = item.delta_items
-                  ; !dis.empty() )
-                {
-                    if( dis.back().action == DeltaType::erased )
-                    {
-                        at_rm.params.src_uuid = to_string( item.left().value() );
-                        at_rm.params.dst_uuid = to_string( item.right().value() );
-                        ( *con_ )( at_rm );
-                        delta_pushed = true;
-                    }
-                    else
-                    {
-                        at_ins.values.add( at.src_uuid = to_string( dis.back().value.first.value() )
-                                         , at.dst_uuid = to_string( dis.back().value.second.value() ) );
-                    }
-                }
+                REQUIRE( count( "nodes" ) == 1 );
+                REQUIRE( count( "headings" ) == 1 );
+                REQUIRE( !db.has_delta() );
             }
-            else if constexpr( std::is_same_v< Table, AttributeTable > )
+        }
+        WHEN( "the last table written rejects its rows" )
+        {
+            // Headings are written ahead of nodes, so a heading committed apart from its node would survive the fault.
+            REQUIRE( !execute_raw( probe, "CREATE TRIGGER reject_nodes BEFORE INSERT ON nodes BEGIN SELECT RAISE( ABORT, 'rejected' ); END;" ).contains( "error" ) );
+            REQUIRE_RFAIL( db.flush_delta_to_disk() );
+
+            THEN( "writes to every table are rolled back" )
             {
-                if( auto const& dis = item.delta_items
-                  ; !dis.empty() )
-                {
-                    if( dis.back().action == DeltaType::erased )
-                    {
-                        att_rm.params.parent_uuid = to_string( item.left().value() );
-                        att_rm.params.child_uuid = to_string( item.right().value() );
-                        ( *con_ )( att_rm );
-                        delta_pushed = true;
-                    }
-                    else
-                    {
-                        att_ins.values.add( att.parent_uuid = to_string( dis.back().value.first.value() )
-                                          , att.child_uuid = to_string( dis.back().value.second.value() ) );
-                    }
-                }
+                REQUIRE( count( "headings" ) == 0 );
+                REQUIRE( count( "nodes" ) == 0 );
             }
-            else if constexpr( std::is_same_v< Table, ResourceTable > )
+            THEN( "the delta is retained" )
             {
-                // Frankly... this one is a bit of a toughy because the size of the resource may be very large.
-                // It may make more general sense to pass around a file string, res heading, or some such that, at this point,
-                // the file may be stored into the db, so we don't have huge binaries sitting around in the cache. It'll take some thought.
-                assert( false && "TODO" );
-                KMAP_THROW_EXCEPTION_MSG( "TODO" );
+                REQUIRE( db.has_delta() );
+                REQUIRE( db.fetch_heading( n1 ).value() == "1" );
             }
-            else
+
+            WHEN( "the fault is cleared and flushed again" )
             {
-                static_assert( always_false< Table >::value, "non-exhaustive visitor!" );
+                REQUIRE( !execute_raw( probe, "DROP TRIGGER reject_nodes;" ).contains( "error" ) );
+                REQUIRE_RES( db.flush_delta_to_disk() );
+
+                THEN( "the retained delta is written" )
+                {
+                    REQUIRE( count( "nodes" ) == 1 );
+                    REQUIRE( count( "headings" ) == 1 );
+                    REQUIRE( !db.has_delta() );
+                }
             }
         }
+    }
+}
 
-        auto push_to_db = [ & ]( auto const& ins, auto const& rm ) mutable
+SCENARIO( "journal mode is applied to the connection", "[db][journal]" )
+{
+    GIVEN( "in-memory connection" )
+    {
+        auto cfg = sqlpp::sqlite3::connection_config{};
+
+        cfg.path_to_database = ":memory:";
+        cfg.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+        auto con = sqlpp::sqlite3::connection{ cfg };
+
+        THEN( "supported mode is reported in effect" )
         {
-            if( !ins.values._data._insert_values.empty()
-             || delta_pushed )
-            {
-                cache().apply_delta_to_cache< Table >();
-            }
-            if( !ins.values._data._insert_values.empty() )
-            {
-                execute( ins );
-            }
-            // if( !nt_rm.where._data._dynamic_expressions.empty() )
-            // {
-            //     execute( rm );
-            // }
-        };
+            REQUIRE( REQUIRE_TRY( apply_journal_mode( con, "off" ) ) == "off" );
+        }
+        THEN( "unsupported mode is reported as the mode SQLite fell back to, with a warning" )
+        {
+            // In-memory databases support only "memory" and "off".
+            REQUIRE( REQUIRE_TRY( apply_journal_mode( con, "truncate" ) ) == "memory" );
+        }
+    }
+    GIVEN( "database on disk" )
+    {
+        auto& km = kmap::Singleton::instance();
+        auto db = com::Database{ km, {}, "" };
 
-        if constexpr( std::is_same_v< Table, NodeTable > ) { push_to_db( nt_ins, nt_rm ); }
-        else if constexpr( std::is_same_v< Table, HeadingTable > ) { push_to_db( ht_ins, ht_rm ); }
-        else if constexpr( std::is_same_v< Table, TitleTable > ) { push_to_db( tt_ins, tt_rm ); }
-        else if constexpr( std::is_same_v< Table, BodyTable > ) { push_to_db( bt_ins, bt_rm ); }
-        else if constexpr( std::is_same_v< Table, ChildTable > ) { push_to_db( ct_ins, ct_rm ); }
-        else if constexpr( std::is_same_v< Table, AliasTable > ) { push_to_db( at_ins, at_rm ); }
-        else if constexpr( std::is_same_v< Table, AttributeTable > ) { push_to_db( att_ins, att_rm ); }
-        else if constexpr( std::is_same_v< Table, ResourceTable > ) { /*TODO*/ }
-        else { static_assert( always_false< Table >::value, "non-exhaustive visitor!" ); }
-    };
+        KMAP_INIT_DISK_DB_FIXTURE_SCOPED( db );
 
-    boost::hana::for_each( cache().tables(), proc_table );
+        THEN( "requested mode is applied" )
+        {
+            REQUIRE_RES( db.set_journal_mode( "truncate" ) );
 
-    rv = outcome::success();
+            auto const res = db.execute_raw( "PRAGMA journal_mode;" );
 
-    return rv;
+            REQUIRE( res.contains( "journal_mode" ) );
+            REQUIRE( res.find( "journal_mode" )->second == "truncate" );
+        }
+        THEN( "invalid mode is refused" )
+        {
+            REQUIRE_RFAIL( db.set_journal_mode( "bogus" ) );
+        }
+    }
 }
 
 // TODO: This should probably be part of db_fs, and not db proper.
@@ -1730,66 +2252,39 @@ auto Database::flush_cache_to_disk()
 
     KMAP_ENSURE( has_file_on_disk(), error_code::common::uncategorized );
 
-    auto proc_table = [ & ]( auto&& table ) mutable
+    // Every body is written, so none may remain a placeholder. Ordinarily, init_db_on_disk has already brought them in.
+    KTRY( materialize_bodies() );
+
+    auto batches = std::vector< db::RowBatch >{};
+    auto collect = [ & ]( auto const& table )
     {
         using namespace db;
         using Table = std::decay_t< decltype( table ) >;
 
-        auto nt = nodes::nodes{};
-        auto nt_ins = insert_into( nt ).columns( nt.uuid );
-        auto ht = headings::headings{};
-        auto ht_ins = insert_into( ht ).columns( ht.uuid, ht.heading );
-        auto tt = titles::titles{};
-        auto tt_ins = insert_into( tt ).columns( tt.uuid, tt.title );
-        auto bt = bodies::bodies{};
-        auto bt_ins = insert_into( bt ).columns( bt.uuid, bt.body );
-        auto ct = children::children{};
-        auto ct_ins = insert_into( ct ).columns( ct.parent_uuid, ct.child_uuid );
-        auto at = aliases::aliases{};
-        auto at_ins = insert_into( at ).columns( at.src_uuid, at.dst_uuid );
-        auto att = attributes::attributes{};
-        auto att_ins = insert_into( att ).columns( att.parent_uuid, att.child_uuid );
-
-        for( auto const& item : table )
+        if constexpr( std::is_same_v< Table, ResourceTable > )
         {
-            if constexpr( std::is_same_v< Table, NodeTable > ) { nt_ins.values.add( nt.uuid = to_string( item.key() ) ); }
-            else if constexpr( std::is_same_v< Table, HeadingTable > ) { ht_ins.values.add( ht.uuid = to_string( item.left() ), ht.heading = item.right() ); }
-            else if constexpr( std::is_same_v< Table, TitleTable > ) { tt_ins.values.add( tt.uuid = to_string( item.left() ), tt.title = item.right() ); }
-            else if constexpr( std::is_same_v< Table, BodyTable > ) { bt_ins.values.add( bt.uuid = to_string( item.left() ), bt.body = item.right() ); }
-            else if constexpr( std::is_same_v< Table, ChildTable > ) { ct_ins.values.add( ct.parent_uuid = to_string( item.left().value() ), ct.child_uuid = to_string( item.right().value() ) ); }
-            else if constexpr( std::is_same_v< Table, AliasTable > ) { at_ins.values.add( at.src_uuid = to_string( item.left().value() ) , at.dst_uuid = to_string( item.right().value() ) ); }
-            else if constexpr( std::is_same_v< Table, AttributeTable > ) { att_ins.values.add( att.parent_uuid = to_string( item.left().value() ) , att.child_uuid = to_string( item.right().value() ) ); }
-            else if constexpr( std::is_same_v< Table, ResourceTable > )
-            {
-                // Frankly... this one is a bit of a toughy because the size of the resource may be very large.
-                // It may make more general sense to pass around a file string, res heading, or some such that, at this point,
-                // the file may be stored into the db, so we don't have huge binaries sitting around in the cache. It'll take some thought.
-                assert( false && "TODO" );
-                KMAP_THROW_EXCEPTION_MSG( "TODO" );
-            }
-            else
-            {
-                static_assert( always_false< Table >::value, "non-exhaustive visitor!" );
-            }
+            // Frankly... this one is a bit of a toughy because the size of the resource may be very large.
+            // It may make more general sense to pass around a file string, res heading, or some such that, at this point,
+            // the file may be stored into the db, so we don't have huge binaries sitting around in the cache. It'll take some thought.
+            BC_ASSERT( table.begin() == table.end() );
         }
-
-        auto push_to_db = [ & ]( auto const& ins ) mutable
+        else
         {
-            if( !ins.values._data._insert_values.empty() )
+            auto rows = make_row_batch< Table >( false );
+
+            for( auto const& item : table )
             {
-                execute( ins );
+                // Erased entries are not written; they are dropped from the cache by apply_delta_to_cache.
+                if( item.delta_items.empty()
+                 || item.delta_items.back().action != DeltaType::erased )
+                {
+                    if constexpr( concepts::Pair< typename Table::unique_key_type > ) { push_row< Table >( rows, item.key(), item.key() ); }
+                    else { push_row< Table >( rows, item.left(), item.right() ); }
+                }
             }
-        };
 
-        if constexpr( std::is_same_v< Table, NodeTable > ) { push_to_db( nt_ins ); }
-        else if constexpr( std::is_same_v< Table, HeadingTable > ) { push_to_db( ht_ins ); }
-        else if constexpr( std::is_same_v< Table, TitleTable > ) { push_to_db( tt_ins ); }
-        else if constexpr( std::is_same_v< Table, BodyTable > ) { push_to_db( bt_ins ); }
-        else if constexpr( std::is_same_v< Table, ChildTable > ) { push_to_db( ct_ins ); }
-        else if constexpr( std::is_same_v< Table, AliasTable > ) { push_to_db( at_ins ); }
-        else if constexpr( std::is_same_v< Table, AttributeTable > ) { push_to_db( att_ins ); }
-        else if constexpr( std::is_same_v< Table, ResourceTable > ) { /*TODO*/ }
-        else { static_assert( always_false< Table >::value, "non-exhaustive visitor!" ); }
+            batches.emplace_back( std::move( rows ) );
+        }
     };
     auto apply_delta = [ & ]( auto&& table ) mutable
     {
@@ -1799,8 +2294,20 @@ auto Database::flush_cache_to_disk()
         cache().apply_delta_to_cache< Table >();
     };
 
-    boost::hana::for_each( cache().tables(), proc_table );
-    boost::hana::for_each( cache().tables(), apply_delta );
+    boost::hana::for_each( cache_.tables(), collect );
+
+    {
+        auto tx = sqlpp::start_transaction( *con_ );
+
+        for( auto const& rows : batches )
+        {
+            KTRY( db::insert_rows( *con_, stmt_cache_, rows ) );
+        }
+
+        tx.commit();
+    }
+
+    boost::hana::for_each( cache_.tables(), apply_delta );
 
     rv = outcome::success();
 
@@ -1810,25 +2317,7 @@ auto Database::flush_cache_to_disk()
 auto Database::has_delta() const
     -> bool
 {
-    auto rv = false;
-
-    auto const fn = [ & ]( auto const& table )
-    {
-        // TODO: Very inefficient, iterating through _all_ items in _all_ tables, looking for a delta.
-        //       Makes more sense to keep a delta flag in each table to consult.
-        for( auto const& item : table )
-        {
-            if( !item.delta_items.empty() )
-            {
-                rv = true;
-                // TODO: break? Is there a way with Boost.Hana?
-            }
-        }
-    };
-
-    boost::hana::for_each( cache().tables(), fn );
-
-    return rv;
+    return cache().has_delta();
 }
 
 // auto Database::action_seq()
@@ -1893,11 +2382,18 @@ auto create_tables( sqlpp::sqlite3::connection& con )
     // Note: "IF NOT EXISTS" is used to allow create_tables to be called for
     // each connection, in case the database does not contain a new table that
     // has been added after original database creation.
+    auto const fresh = execute_raw( con, "SELECT name FROM sqlite_master WHERE type='table';" ).empty();
 
     for( auto const& sql : db::table_map | rvs::values )
     {
         con.execute( sql );
     }
+
+    // Only a freshly created database is known to be of the current schema; an existing one retains its version, to be upgraded via migration.
+    if( fresh )
+    {
+        con.execute( fmt::format( "PRAGMA user_version = {};", db::schema_version ) );
+    }
 }
 
 auto execute_raw( sqlpp::sqlite3::connection& con
@@ -1943,6 +2439,49 @@ auto execute_raw( sqlpp::sqlite3::connection& con
     return rv;
 }
 
+/**
+ * @note WAL ordinarily requires shared memory, which the "unix-dotfile" VFS does not provide. SQLite permits WAL without shared memory
+ *       so long as exclusive locking mode is set beforehand, so exclusive locking accompanies WAL.
+ */
+auto apply_journal_mode( sqlpp::sqlite3::connection& con
+                       , std::string const& mode )
+    -> Result< std::string >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_STR( "mode", mode );
+
+    auto rv = result::make_result< std::string >();
+
+    if( mode == "wal" )
+    {
+        auto const lres = execute_raw( con, "PRAGMA locking_mode = EXCLUSIVE;" );
+
+        KMAP_ENSURE_MSG( !lres.contains( "error" ), error_code::common::uncategorized, lres.find( "error" )->second );
+    }
+
+    auto const jres = execute_raw( con, fmt::format( "PRAGMA journal_mode = {};", mode ) );
+
+    KMAP_ENSURE_MSG( !jres.contains( "error" ), error_code::common::uncategorized, jres.find( "error" )->second );
+
+    // Note: "PRAGMA journal_mode" reports the resulting mode, which falls back to the prior one when the requested is unsupported.
+    if( auto const it = jres.find( "journal_mode" )
+      ; it != jres.end() )
+    {
+        if( it->second != mode )
+        {
+            fmt::print( stderr, "[kmap][warn] requested journal mode '{}', but database reports '{}'\n", mode, it->second );
+        }
+
+        rv = it->second;
+    }
+    else
+    {
+        rv = mode;
+    }
+
+    return rv;
+}
+
 namespace {
 namespace database_def {
 
@@ -7,9 +7,13 @@
 #ifndef KMAP_DB_HPP
 #define KMAP_DB_HPP
 
+#include <com/database/body_cache.hpp>
 #include <com/database/cache.hpp>
+#include <com/database/change_feed.hpp>
 #include <com/database/common.hpp>
+#include <com/database/order_index.hpp>
 #include <com/database/query_cache.hpp>
+#include <com/database/util.hpp>
 #include <common.hpp>
 #include <component.hpp>
 #include <path.hpp>
@@ -19,6 +23,7 @@
 #include <sqlpp11/sqlite3/connection.h>
 
 #include <memory>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -29,8 +34,14 @@ class Database : public Component
 {
     FsPath path_ = {};
     std::unique_ptr< sqlpp::sqlite3::connection > con_ = {}; // TODO: I think this actually belongs in com::DatabaseFilesystem. In the future.
+    mutable db::StatementCache stmt_cache_ = {}; // Declared after `con_`, so cached statements are finalized before their connection closes. Mutable, as bodies are paged in by const fetches.
     mutable db::Cache cache_ = {}; // Needs to be mutable, as fetching/reading operations are const, but may update the cache. TODO: Really? I think what I had in mind was when it needed to be loaded from disk, but this all happens at one time via explicit command, so I don't think mutable is necessary.
     mutable db::QueryCache query_cache_ = {};
+    db::ChangeFeed change_feed_ = {};
+    mutable db::OrderIndex order_index_ = {}; // Populated by const fetches.
+    std::string journal_mode_ = "delete"; // SQLite's default rollback journal.
+    mutable db::BodyCache body_cache_ = {};
+    bool bodies_paged_ = false; // When set, clean BodyTable entries absent from `body_cache_` hold a placeholder, their bodies left on disk.
 
 public:
     // using TableId = db::TableId;
@@ -111,24 +122,59 @@ public:
         -> sqlpp::sqlite3::connection;
     auto path() const
         -> Result< FsPath >;
+    auto body_cache() const
+        -> db::BodyCache const&;
+    auto statement_stats() const
+        -> db::StatementCache::Stats const&;
+    /**
+     * @brief Sets the byte budget for bodies held in memory. A non-zero budget has bodies loaded lazily, on fetch, evicting the least recently used; zero loads all bodies up front.
+     * @note Lazy loading takes effect on the next load. Setting zero while bodies are paged brings all remaining bodies in from disk.
+     */
+    auto set_body_cache_budget( std::size_t const bytes )
+        -> Result< void >;
+    /**
+     * @brief Sets the SQLite journal mode (e.g., "delete", "wal") for the current connection and any subsequently opened.
+     */
+    auto set_journal_mode( std::string const& mode )
+        -> Result< void >;
 
     // Convenience interface.
     template< typename Table >
     auto contains( auto const& key ) const
         -> bool
     {
+        for_each_key_node( key, [ & ]( auto const& node ){ query_cache_.record( node ); } );
+
         return cache().contains< Table >( key );
     }
     template< typename Table >
     auto erase( auto const& key )
         -> Result< void > 
     {
-        return cache().erase< Table >( key );
+        KM_RESULT_PROLOG();
+
+        KTRY( cache().erase< Table >( key ) );
+
+        auto const hold = change_feed_.hold();
+
+        for_each_key_node( key, [ & ]( auto const& node )
+        {
+            changed< Table >( db::ChangeKind::erased, node );
+
+            if constexpr( std::is_same_v< Table, db::BodyTable > )
+            {
+                order_index_.erase_order_node( node );
+            }
+        } );
+
+        return outcome::success();
     }
     template< typename Table >
     auto fetch() const
         -> Table const&
     {
+        query_cache_.record_table< Table >();
+
         return cache().fetch< Table >();
     }
 
@@ -179,6 +225,12 @@ public:
         -> Result< Uuid >;
     auto fetch_body( Uuid const& id ) const
         -> Result< std::string >;
+    /**
+     * @brief Borrowing counterpart of fetch_body.
+     * @note Valid until the cache is next mutated, or another body is fetched, which may page this one out.
+     */
+    auto fetch_body_view( Uuid const& id ) const
+        -> Result< std::string_view >;
     auto fetch_children() const
         -> std::vector< std::pair< Uuid
                                  , Uuid > >;
@@ -186,6 +238,12 @@ public:
         -> Result< UuidSet >;
     auto fetch_heading( Uuid const& id ) const
         -> Result< Heading >;
+    /**
+     * @brief Borrowing counterpart of fetch_heading.
+     * @note Valid until the cache is next mutated.
+     */
+    auto fetch_heading_view( Uuid const& id ) const
+        -> Result< std::string_view >;
     auto fetch_attr( Uuid const& parent ) const
         -> Result< Uuid >;
     auto fetch_attr_owner( Uuid const& attrn ) const
@@ -196,11 +254,37 @@ public:
         -> UuidUnSet;
     auto fetch_nodes( Heading const& heading ) const
         -> UuidSet;
+    /**
+     * @brief Children of `parent`, as ordered by its `$.order` attribute body.
+     * @note Entries are resolved (i.e., alias sources). The body is parsed on first fetch, and held until it changes.
+     */
+    auto fetch_order( Uuid const& parent ) const
+        -> Result< UuidVec >;
+    auto fetch_order_position( Uuid const& parent
+                             , Uuid const& child ) const
+        -> Result< std::size_t >;
     auto fetch_title( Uuid const& id ) const
         -> Result< std::string >;
+    /**
+     * @brief Borrowing counterpart of fetch_title.
+     * @note Valid until the cache is next mutated.
+     */
+    auto fetch_title_view( Uuid const& id ) const
+        -> Result< std::string_view >;
     auto fetch_genesis_time( Uuid const& id ) const
         -> Optional< uint64_t >;
     [[ nodiscard ]]
+    auto change_feed()
+        -> db::ChangeFeed&;
+    [[ nodiscard ]]
+    auto change_feed() const
+        -> db::ChangeFeed const&;
+    /**
+     * @brief Returns `node`'s version, which increases with each push, update, or erase touching it.
+     */
+    auto fetch_version( Uuid const& node ) const
+        -> std::uint64_t;
+    [[ nodiscard ]]
     auto query_cache()
         -> db::QueryCache&;
     [[ nodiscard ]]
@@ -228,6 +312,8 @@ public:
         -> Result< void >;
     auto erase_all( Uuid const& id ) // TODO: Ensures all lhs/rhs for all tables is erased ("cascading erase")? Or not DB's responsibilty?
         -> Result< void >;
+    auto erase_all( UuidVec const& ids )
+        -> Result< void >;
     auto erase_child( Uuid const& parent
                     , Uuid const& child )
         -> Result< void >;
@@ -250,10 +336,62 @@ public:
         -> bool;
 
 protected:
+    auto apply_journal_mode()
+        -> Result< void >;
     auto cache()
         -> db::Cache&;
+    /**
+     * @brief Invalidates dependent queries and records a change of `kind` to `Table` for each of `nodes`.
+     * @note Changes are delivered as one batch, unless the feed is held.
+     */
+    template< typename Table >
+    auto changed( db::ChangeKind const kind
+                , std::same_as< Uuid > auto const&... nodes )
+        -> void
+    {
+        query_cache_.invalidate< Table >( nodes... );
+
+        ( change_feed_.push( db::Change{ .node = nodes, .table = db::table_index< Table >, .kind = kind } ), ... );
+
+        change_feed_.flush();
+    }
+    /**
+     * @brief Applies `fn` to each node of a table key: a Uuid, a Left/Right, or a pair of either.
+     */
+    static auto for_each_key_node( auto const& key
+                                 , auto const& fn )
+        -> void
+    {
+        using Key = std::decay_t< decltype( key ) >;
+
+        if constexpr( concepts::Pair< Key > )
+        {
+            for_each_key_node( key.first, fn );
+            for_each_key_node( key.second, fn );
+        }
+        else if constexpr( std::is_same_v< Key, Uuid > )
+        {
+            fn( key );
+        }
+        else
+        {
+            fn( key.value() );
+        }
+    }
     auto load_internal( FsPath const& path )
         -> Result< void >;
+    /**
+     * @brief Brings in every body still on disk, ending lazy paging.
+     */
+    auto materialize_bodies()
+        -> Result< void >;
+    /**
+     * @brief Ensures the body of `node`, if on disk and clean, is resident in the cache.
+     */
+    auto page_in_body( Uuid const& node ) const
+        -> Result< void >;
+    auto trim_body_cache() const
+        -> Result< void >;
 //protected: // Allowing access for "repair-state". TODO: Better handle this.
     // auto action_seq()
     //     -> ActionSequence;
@@ -267,6 +405,13 @@ protected:
     //     -> Result< void >;
 };
 
+/**
+ * @brief Sets the journal mode of `con`, warning should SQLite settle on a different one.
+ * @return The journal mode SQLite reports in effect.
+ */
+auto apply_journal_mode( sqlpp::sqlite3::connection& con
+                       , std::string const& mode )
+    -> Result< std::string >;
 auto create_attr_node( Database& db
                      , Uuid const& parent)
     -> Result< Uuid >;
@@ -9,6 +9,7 @@
 #include <com/cmd/cclerk.hpp>
 #include <com/database/db.hpp>
 #include <com/database/table_decl.hpp>
+#include <com/database/util.hpp>
 #include <com/filesystem/filesystem.hpp>
 #include <error/filesystem.hpp>
 #include <io.hpp>
@@ -104,16 +105,16 @@ SCENARIO( "saved data mirrors runtime data", "[db][fs][save][load]")
             {
                 // nt
                 {
-                    auto rows = exec_select( nt, nt.uuid == to_string( root ) );
+                    auto rows = exec_select( nt, nt.uuid == db::to_blob( root ) );
                     REQUIRE( std::distance( rows.begin(), rows.end() ) == 1 );
                 }
                 // ht
                 {
-                    auto rows = exec_select( ht, ht.uuid == to_string( root ) );
+                    auto rows = exec_select( ht, ht.uuid == db::to_blob( root ) );
                     REQUIRE( std::distance( rows.begin(), rows.end() ) == 1 );
                 }
                 {
-                    auto rows = exec_select( ht, ht.uuid == to_string( root ) );
+                    auto rows = exec_select( ht, ht.uuid == db::to_blob( root ) );
                     REQUIRE( rows.begin()->heading == "root" );
                 }
             }
@@ -128,21 +129,21 @@ SCENARIO( "saved data mirrors runtime data", "[db][fs][save][load]")
                 {
                     // nt
                     {
-                        auto rows = exec_select( nt, nt.uuid == to_string( c1 ) );
+                        auto rows = exec_select( nt, nt.uuid == db::to_blob( c1 ) );
                         REQUIRE( std::distance( rows.begin(), rows.end() ) == 1 );
                     }
                     // ht
                     {
-                        auto rows = exec_select( ht, ht.uuid == to_string( c1 ) );
+                        auto rows = exec_select( ht, ht.uuid == db::to_blob( c1 ) );
                         REQUIRE( std::distance( rows.begin(), rows.end() ) == 1 );
                     }
                     {
-                        auto rows = exec_select( ht, ht.uuid == to_string( c1 ) );
+                        auto rows = exec_select( ht, ht.uuid == db::to_blob( c1 ) );
                         REQUIRE( rows.begin()->heading == c1h );
                     }
                     // ct
                     {
-                        auto rows = exec_select( ct, ct.child_uuid == to_string( c1 ) );
+                        auto rows = exec_select( ct, ct.child_uuid == db::to_blob( c1 ) );
                         REQUIRE( std::distance( rows.begin(), rows.end() ) == 1 );
                     }
                 }
@@ -156,17 +157,17 @@ SCENARIO( "saved data mirrors runtime data", "[db][fs][save][load]")
                     {
                         // nt
                         {
-                            auto rows = exec_select( nt, nt.uuid == to_string( c1 ) );
+                            auto rows = exec_select( nt, nt.uuid == db::to_blob( c1 ) );
                             REQUIRE( std::distance( rows.begin(), rows.end() ) == 0 );
                         }
                         // ht
                         {
-                            auto rows = exec_select( ht, ht.uuid == to_string( c1 ) );
+                            auto rows = exec_select( ht, ht.uuid == db::to_blob( c1 ) );
                             REQUIRE( std::distance( rows.begin(), rows.end() ) == 0 );
                         }
                         // ct
                         {
-                            auto rows = exec_select( ct, ct.child_uuid == to_string( c1 ) );
+                            auto rows = exec_select( ct, ct.child_uuid == db::to_blob( c1 ) );
                             REQUIRE( std::distance( rows.begin(), rows.end() ) == 0 );
                         }
                     }
@@ -557,6 +558,63 @@ SCENARIO( "save.as after save.as output DBs are mirrored for all listed componen
     if( exists( abs_disk_path_2 ) ) { boost::filesystem::remove( abs_disk_path_2 ); }
 }
 
+SCENARIO( "bodies are paged in lazily after load", "[db][fs][load][body_cache]")
+{
+    KMAP_COMPONENT_FIXTURE_SCOPED( "database", "database.filesystem", "network" );
+
+    auto& km = Singleton::instance();
+    auto const db = [ & ] { return REQUIRE_TRY( km.fetch_component< com::Database >() ); };
+    auto const nw = [ & ] { return REQUIRE_TRY( km.fetch_component< com::Network >() ); };
+    auto initialized_coms = km.component_store().all_initialized_components();
+    auto const disk_path = ".db_fs_test.kmap";
+    auto const abs_disk_path = com::kmap_root_dir / disk_path;
+
+    if( exists( abs_disk_path ) ) { boost::filesystem::remove( abs_disk_path ); }
+
+    GIVEN( "two bodies flushed to disk" )
+    {
+        REQUIRE_TRY( db()->init_db_on_disk( abs_disk_path ) );
+
+        auto const c1 = REQUIRE_TRY( nw()->create_child( nw()->root_node(), "1" ) );
+        auto const c2 = REQUIRE_TRY( nw()->create_child( nw()->root_node(), "2" ) );
+
+        REQUIRE_TRY( nw()->update_body( c1, "body 1" ) );
+        REQUIRE_TRY( nw()->update_body( c2, "body 2" ) );
+        REQUIRE_TRY( db()->flush_delta_to_disk() );
+
+        WHEN( "loaded with a budget fitting one body" )
+        {
+            REQUIRE_TRY( km.load( disk_path, initialized_coms ) );
+            REQUIRE_TRY( db()->set_body_cache_budget( 6 ) ); // Loading replaces the component, so the budget is set after.
+
+            THEN( "bodies are fetched from disk, evicting the least recently used" )
+            {
+                REQUIRE( REQUIRE_TRY( db()->fetch_body( c1 ) ) == "body 1" );
+                REQUIRE( REQUIRE_TRY( db()->fetch_body( c2 ) ) == "body 2" );
+                REQUIRE( db()->body_cache().contains( c2 ) );
+                REQUIRE( !db()->body_cache().contains( c1 ) );
+                REQUIRE( REQUIRE_TRY( db()->fetch_body( c1 ) ) == "body 1" );
+            }
+            THEN( "an updated body is pinned until flushed" )
+            {
+                REQUIRE_TRY( nw()->update_body( c1, "body 1'" ) );
+                REQUIRE( REQUIRE_TRY( db()->fetch_body( c2 ) ) == "body 2" );
+                REQUIRE( REQUIRE_TRY( db()->fetch_body( c1 ) ) == "body 1'" );
+                REQUIRE_TRY( db()->flush_delta_to_disk() );
+                REQUIRE( db()->body_cache().bytes() <= 6 );
+                REQUIRE( REQUIRE_TRY( db()->fetch_body( c1 ) ) == "body 1'" );
+            }
+            THEN( "a body may be cleared" )
+            {
+                REQUIRE_TRY( nw()->update_body( c1, "" ) );
+                REQUIRE( REQUIRE_TRY( db()->fetch_body( c1 ) ) == "" );
+            }
+        }
+    }
+
+    if( exists( abs_disk_path ) ) { boost::filesystem::remove( abs_disk_path ); }
+}
+
 auto DatabaseFilesystem::copy_state( FsPath const& dst )
     -> Result< void >
 {
@@ -88,6 +88,27 @@ struct Database
         return db->has_file_on_disk();
     }
 
+    auto set_body_cache_budget( std::size_t const bytes )
+        -> kmap::Result< void >
+    {
+        KM_RESULT_PROLOG();
+
+        auto const db = KTRY( kmap_.fetch_component< com::Database >() );
+
+        return db->set_body_cache_budget( bytes );
+    }
+
+    auto set_journal_mode( std::string const& mode )
+        -> kmap::Result< void >
+    {
+        KM_RESULT_PROLOG();
+            KM_RESULT_PUSH_STR( "mode", mode );
+
+        auto const db = KTRY( kmap_.fetch_component< com::Database >() );
+
+        return db->set_journal_mode( mode );
+    }
+
     auto path()
         -> Result< std::string >
     {
@@ -115,6 +136,8 @@ EMSCRIPTEN_BINDINGS( kmap_database )
         .function( "has_delta", &kmap::com::binding::Database::has_delta )
         .function( "has_file_on_disk", &kmap::com::binding::Database::has_file_on_disk )
         .function( "path", &kmap::com::binding::Database::path )
+        .function( "set_body_cache_budget", &kmap::com::binding::Database::set_body_cache_budget )
+        .function( "set_journal_mode", &kmap::com::binding::Database::set_journal_mode )
         ;
 }
 
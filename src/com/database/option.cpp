@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#include <com/option/option_clerk.hpp>
+#include <common.hpp>
+#include <component.hpp>
+
+#include <set>
+#include <string>
+#include <string_view>
+
+namespace kmap::com::database {
+
+class Option : public Component
+{
+    OptionClerk oclerk_;
+
+public:
+    static constexpr auto id = "database.option";
+    constexpr auto name() const -> std::string_view override { return id; }
+
+    Option( Kmap& km
+          , std::set< std::string > const& requisites
+          , std::string const& description )
+        : Component{ km, requisites, description }
+        , oclerk_{ km }
+    {
+        KM_RESULT_PROLOG();
+
+        KTRYE( register_standard_options() );
+    }
+    virtual ~Option() = default;
+
+    auto initialize()
+        -> Result< void > override
+    {
+        KM_RESULT_PROLOG();
+        
+        auto rv = result::make_result< void >();
+
+        KTRY( oclerk_.install_registered() );
+        KTRY( oclerk_.apply_installed() );
+
+        rv = outcome::success();
+
+        return rv;
+    }
+    auto load()
+        -> Result< void > override
+    {
+        KM_RESULT_PROLOG();
+        
+        auto rv = result::make_result< void >();
+
+        KTRY( oclerk_.check_registered() );
+        KTRY( oclerk_.apply_installed() );
+
+        rv = outcome::success();
+
+        return rv;
+    }
+
+    auto register_standard_options()
+        -> Result< void >
+    {
+        KM_RESULT_PROLOG();
+
+        auto rv = result::make_result< void >();
+        
+        // database.journal_mode
+        {
+            auto const action = 
+R"%%%(
+ktry( kmap.database().set_journal_mode( option_value ) );
+)%%%";
+            KTRY( oclerk_.register_option( { .heading = "database.journal_mode"
+                                           , .descr = "SQLite journal mode for the map file: delete, truncate, persist, memory, wal, or off. 'wal' speeds up flushing of large deltas."
+                                           , .value = "\"delete\""
+                                           , .action = action } ) );
+        }
+        // database.body_cache_budget
+        {
+            auto const action = 
+R"%%%(
+ktry( kmap.database().set_body_cache_budget( option_value ) );
+)%%%";
+            KTRY( oclerk_.register_option( { .heading = "database.body_cache_budget"
+                                           , .descr = "Bytes of node bodies held in memory. When non-zero, bodies are loaded from the map file as viewed, evicting the least recently used; when zero, all are loaded up front."
+                                           , .value = "33554432"
+                                           , .action = action } ) );
+        }
+
+        rv = outcome::success();
+
+        return rv;
+    }
+};
+
+namespace {
+namespace database_option_def {
+
+using namespace std::string_literals;
+
+REGISTER_COMPONENT
+(
+    kmap::com::database::Option
+,   std::set({ "database"s, "option_store"s })
+,   "options for database"
+);
+
+} // namespace database_option_def 
+} // namespace anon
+
+} // kmap::com::database
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#include "com/database/order_index.hpp"
+
+#include "contract.hpp"
+#include "test/util.hpp"
+#include "utility.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+
+namespace kmap::com::db {
+
+auto OrderIndex::clear()
+    -> void
+{
+    entries_.clear();
+    parents_.clear();
+}
+
+auto OrderIndex::erase_order_node( Uuid const& order_node )
+    -> void
+{
+    if( auto const it = parents_.find( order_node )
+      ; it != parents_.end() )
+    {
+        entries_.erase( it->second );
+        parents_.erase( it );
+    }
+}
+
+auto OrderIndex::fetch( Uuid const& parent ) const
+    -> Result< std::reference_wrapper< Entry const > >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< std::reference_wrapper< Entry const > >();
+
+    if( auto const it = entries_.find( parent )
+      ; it != entries_.end() )
+    {
+        rv = std::cref( it->second );
+    }
+
+    return rv;
+}
+
+auto OrderIndex::push( Uuid const& parent
+                     , Uuid const& order_node
+                     , std::string_view const body )
+    -> Result< std::reference_wrapper< Entry const > >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_NODE( "parent", parent );
+        KM_RESULT_PUSH_NODE( "order_node", order_node );
+
+    auto rv = result::make_result< std::reference_wrapper< Entry const > >();
+    auto entry = Entry{ .order_node = order_node };
+
+    for( auto first = std::size_t{ 0 }
+       ; first <= body.size()
+       ; )
+    {
+        auto const last = std::min( body.find( '\n', first ), body.size() );
+        auto const child = KTRY( uuid_from_string( std::string{ body.substr( first, last - first ) } ) );
+
+        KMAP_ENSURE( entry.positions.emplace( child, entry.children.size() ).second, error_code::network::invalid_ordering );
+
+        entry.children.emplace_back( child );
+
+        first = last + 1;
+    }
+
+    erase_order_node( order_node );
+    entries_.erase( parent );
+
+    auto const it = entries_.insert_or_assign( parent, std::move( entry ) ).first;
+
+    parents_.insert_or_assign( order_node, parent );
+
+    rv = std::cref( it->second );
+
+    return rv;
+}
+
+auto OrderIndex::size() const
+    -> std::size_t
+{
+    return entries_.size();
+}
+
+SCENARIO( "OrderIndex parses and drops order bodies", "[db][order_index]" )
+{
+    auto index = OrderIndex{};
+    auto const parent = gen_uuid();
+    auto const ordern = gen_uuid();
+    auto const c1 = gen_uuid();
+    auto const c2 = gen_uuid();
+
+    GIVEN( "pushed body" )
+    {
+        auto const body = fmt::format( "{}\n{}", to_string( c2 ), to_string( c1 ) );
+        auto const& entry = REQUIRE_TRY( index.push( parent, ordern, body ) ).get();
+
+        THEN( "children are in body order" )
+        {
+            REQUIRE( entry.children == UuidVec{ c2, c1 } );
+            REQUIRE( entry.positions.at( c2 ) == 0 );
+            REQUIRE( entry.positions.at( c1 ) == 1 );
+            REQUIRE( index.fetch( parent ) );
+        }
+
+        WHEN( "order node is erased" )
+        {
+            index.erase_order_node( ordern );
+
+            THEN( "entry is dropped" )
+            {
+                REQUIRE( !index.fetch( parent ) );
+                REQUIRE( index.size() == 0 );
+            }
+        }
+    }
+    GIVEN( "body with duplicate child" )
+    {
+        auto const body = fmt::format( "{}\n{}", to_string( c1 ), to_string( c1 ) );
+
+        THEN( "push fails" )
+        {
+            REQUIRE( !index.push( parent, ordern, body ) );
+            REQUIRE( !index.fetch( parent ) );
+        }
+    }
+}
+
+} // kmap::com::db
@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#pragma once
+#ifndef KMAP_DB_ORDER_INDEX_HPP
+#define KMAP_DB_ORDER_INDEX_HPP
+
+#include <common.hpp>
+#include <util/result.hpp>
+
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+namespace kmap::com::db {
+
+/**
+ * @brief Ordered children per parent, parsed from `$.order` attribute bodies, so ordered fetches and position lookups needn't re-parse the body.
+ * @note The order body remains the persisted form. An entry is held until its order node's body changes, and is re-parsed on next fetch.
+ */
+class OrderIndex
+{
+public:
+    struct Entry
+    {
+        Uuid order_node = {};
+        UuidVec children = {};
+        std::unordered_map< Uuid, std::size_t, boost::hash< Uuid > > positions = {};
+    };
+
+private:
+    std::unordered_map< Uuid, Entry, boost::hash< Uuid > > entries_ = {}; // Keyed by parent.
+    std::unordered_map< Uuid, Uuid, boost::hash< Uuid > > parents_ = {}; // Order node => parent.
+
+public:
+    auto clear()
+        -> void;
+    /**
+     * @brief Drops the entry parsed from `order_node`'s body, if any.
+     */
+    auto erase_order_node( Uuid const& order_node )
+        -> void;
+    auto fetch( Uuid const& parent ) const
+        -> Result< std::reference_wrapper< Entry const > >;
+    /**
+     * @param body Newline-delimited child IDs.
+     */
+    auto push( Uuid const& parent
+             , Uuid const& order_node
+             , std::string_view const body )
+        -> Result< std::reference_wrapper< Entry const > >;
+    auto size() const
+        -> std::size_t;
+};
+
+} // kmap::com::db
+
+#endif // KMAP_DB_ORDER_INDEX_HPP
@@ -5,6 +5,7 @@
  ******************************************************************************/
 #include "com/database/query_cache.hpp"
 
+#include "contract.hpp"
 #include "path/node_view2.hpp"
 #include "test/util.hpp"
 #include "util/result.hpp"
@@ -12,7 +13,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <range/v3/iterator/operations.hpp>
 
-#include <map>
+#include <stdexcept>
 
 namespace kmap::com::db {
 
@@ -25,11 +26,59 @@ namespace kmap::com::db {
 //     return tether;
 // }
 
+auto QueryDeps::depends_on( std::size_t const table
+                          , Uuid const& node ) const
+    -> bool
+{
+    return tables.test( table )
+        || nodes.contains( node );
+}
+
+auto QueryDeps::merge( QueryDeps const& other )
+    -> void
+{
+    nodes.insert( other.nodes.begin(), other.nodes.end() );
+    tables |= other.tables;
+    stale = stale || other.stale;
+}
+
+auto QueryCache::begin_recording() const
+    -> void
+{
+    recordings_.emplace_back();
+}
+
 auto QueryCache::clear()
     -> void
 {
     // KMAP_LOG_LINE();
+    ++generation_;
     map_.clear();
+    node_dependents_.clear();
+    table_dependents_ = {};
+
+    for( auto& rec : recordings_ )
+    {
+        rec.stale = true;
+    }
+}
+
+auto QueryCache::end_recording() const
+    -> QueryDeps
+{
+    BC_ASSERT( !recordings_.empty() );
+
+    auto rv = std::move( recordings_.back() );
+
+    recordings_.pop_back();
+
+    // What an inner query read, its enclosing query read as well.
+    if( !recordings_.empty() )
+    {
+        recordings_.back().merge( rv );
+    }
+
+    return rv;
 }
 
 auto QueryCache::fetch( view2::Tether const& tether ) const
@@ -39,17 +88,66 @@ auto QueryCache::fetch( view2::Tether const& tether ) const
 
     auto rv = result::make_result< view2::FetchSet >();
 
-    if( map_.contains( tether ) )
+    if( auto const it = map_.find( tether )
+      ; it != map_.end() )
     {
         // fmt::print( "[QueryCache][fetched] {}\n", tether | act2::to_string );
-        rv = map_.at( tether );
+        if( !recordings_.empty() )
+        {
+            recordings_.back().merge( it->second.deps );
+        }
+
+        rv = it->second.result;
     }
 
     return rv;
 }
 
+auto QueryCache::generation() const
+    -> std::uint64_t
+{
+    return generation_;
+}
+
+auto QueryCache::is_recording() const
+    -> bool
+{
+    return !recordings_.empty();
+}
+
+auto QueryCache::invalidate( std::size_t const table
+                           , Uuid const& node )
+    -> void
+{
+    auto stale = std::vector< view2::Tether >{};
+
+    ++generation_;
+
+    if( auto const it = node_dependents_.find( node )
+      ; it != node_dependents_.end() )
+    {
+        stale.insert( stale.end(), it->second.begin(), it->second.end() );
+    }
+
+    stale.insert( stale.end(), table_dependents_[ table ].begin(), table_dependents_[ table ].end() );
+
+    for( auto const& tether : stale )
+    {
+        erase( tether );
+    }
+
+    for( auto& rec : recordings_ )
+    {
+        if( rec.depends_on( table, node ) )
+        {
+            rec.stale = true;
+        }
+    }
+}
+
 auto QueryCache::push( view2::Tether const& tether
-                     , view2::FetchSet const& result )
+                     , view2::FetchSet const& result
+                     , QueryDeps const& deps )
     -> Result< void >
 {
     // fmt::print( "[QueryCache][push] {}\n", tether | act2::to_string );
@@ -57,9 +155,27 @@ auto QueryCache::push( view2::Tether const& tether
 
     auto rv = result::make_result< void >();
 
-    if( !map_.contains( tether ) )
+    if( deps.stale )
     {
-        map_.emplace( tether, result );
+        rv = outcome::success();
+    }
+    else if( !map_.contains( tether ) )
+    {
+        map_.emplace( tether, Entry{ .result = result, .deps = deps } );
+
+        for( auto const& node : deps.nodes )
+        {
+            node_dependents_[ node ].emplace( tether );
+        }
+        for( auto i = std::size_t{ 0 }
+           ; i < table_count
+           ; ++i )
+        {
+            if( deps.tables.test( i ) )
+            {
+                table_dependents_[ i ].emplace( tether );
+            }
+        }
 
         rv = outcome::success();
     }
@@ -67,6 +183,56 @@ auto QueryCache::push( view2::Tether const& tether
     return rv;
 }
 
+auto QueryCache::record( Uuid const& node ) const
+    -> void
+{
+    if( !recordings_.empty() )
+    {
+        recordings_.back().nodes.emplace( node );
+    }
+}
+
+auto QueryCache::size() const
+    -> std::size_t
+{
+    return map_.size();
+}
+
+auto QueryCache::erase( view2::Tether const& tether )
+    -> void
+{
+    if( auto const it = map_.find( tether )
+      ; it != map_.end() )
+    {
+        auto const& deps = it->second.deps;
+
+        for( auto const& node : deps.nodes )
+        {
+            if( auto const nit = node_dependents_.find( node )
+              ; nit != node_dependents_.end() )
+            {
+                nit->second.erase( tether );
+
+                if( nit->second.empty() )
+                {
+                    node_dependents_.erase( nit );
+                }
+            }
+        }
+        for( auto i = std::size_t{ 0 }
+           ; i < table_count
+           ; ++i )
+        {
+            if( deps.tables.test( i ) )
+            {
+                table_dependents_[ i ].erase( tether );
+            }
+        }
+
+        map_.erase( it );
+    }
+}
+
 SCENARIO( "QueryCache push and fetch", "[node_view][query_cache]" )
 {
     auto cache = QueryCache{};
@@ -88,7 +254,7 @@ SCENARIO( "QueryCache push and fetch", "[node_view][query_cache]" )
 
             REQUIRE( test::fail( cache.fetch( tv ) ) );
 
-            REQUIRE_RES( cache.push( tv, rns ) );
+            REQUIRE_RES( cache.push( tv, rns, {} ) );
             REQUIRE( ranges::distance( cache ) == 1 );
 
             THEN( "cache.fetch( view )" )
@@ -110,7 +276,7 @@ SCENARIO( "QueryCache push and fetch", "[node_view][query_cache]" )
     {
         auto const rns = view2::FetchSet{ { .id = gen_uuid() } };
 
-        REQUIRE_RES( cache.push( anchor::abs_root | view2::direct_desc( "meta.event.object" ) | view2::to_tether, rns ) );
+        REQUIRE_RES( cache.push( anchor::abs_root | view2::direct_desc( "meta.event.object" ) | view2::to_tether, rns, {} ) );
         REQUIRE( ranges::distance( cache ) == 1 );
 
         THEN( "cache.fetch( abs_root | direct_desc( 'meta.event.object' ) )" )
@@ -122,6 +288,130 @@ SCENARIO( "QueryCache push and fetch", "[node_view][query_cache]" )
     }
 }
 
+ScopedRecording::ScopedRecording( QueryCache const& qcache )
+    : qcache_{ qcache }
+{
+    qcache_.begin_recording();
+}
+
+ScopedRecording::~ScopedRecording()
+{
+    if( !ended_ )
+    {
+        qcache_.end_recording();
+    }
+}
+
+auto ScopedRecording::end()
+    -> QueryDeps
+{
+    BC_ASSERT( !ended_ );
+
+    ended_ = true;
+
+    return qcache_.end_recording();
+}
+
+SCENARIO( "QueryCache invalidates only dependent results", "[node_view][query_cache]" )
+{
+    auto cache = QueryCache{};
+    auto const n1 = gen_uuid();
+    auto const n2 = gen_uuid();
+    auto const t1 = anchor::node( n1 ) | view2::child | view2::to_tether;
+    auto const t2 = anchor::node( n2 ) | view2::child | view2::to_tether;
+    auto const th = anchor::abs_root | view2::desc( "h" ) | view2::to_tether;
+    auto const push = [ & ]( auto const& tether
+                           , auto const& record )
+    {
+        cache.begin_recording();
+        record();
+        REQUIRE_RES( cache.push( tether, view2::FetchSet{}, cache.end_recording() ) );
+    };
+
+    push( t1, [ & ]{ cache.record( n1 ); } );
+    push( t2, [ & ]{ cache.record( n2 ); } );
+    push( th, [ & ]{ cache.record_table< HeadingTable >(); } );
+
+    REQUIRE( cache.size() == 3 );
+
+    WHEN( "n1's body changes" )
+    {
+        cache.invalidate< BodyTable >( n1 );
+
+        THEN( "only the result reading n1 is dropped" )
+        {
+            REQUIRE( test::fail( cache.fetch( t1 ) ) );
+            REQUIRE_RES( cache.fetch( t2 ) );
+            REQUIRE_RES( cache.fetch( th ) );
+        }
+    }
+    WHEN( "an unrelated heading changes" )
+    {
+        cache.invalidate< HeadingTable >( gen_uuid() );
+
+        THEN( "only the result reading all headings is dropped" )
+        {
+            REQUIRE_RES( cache.fetch( t1 ) );
+            REQUIRE_RES( cache.fetch( t2 ) );
+            REQUIRE( test::fail( cache.fetch( th ) ) );
+        }
+    }
+    WHEN( "a nested query hits the cache" )
+    {
+        auto const outer = anchor::node( n1 ) | view2::parent | view2::to_tether;
+
+        cache.begin_recording();
+        REQUIRE_RES( cache.fetch( t2 ) );
+        REQUIRE_RES( cache.push( outer, view2::FetchSet{}, cache.end_recording() ) );
+
+        THEN( "the enclosing result depends on what the hit read" )
+        {
+            cache.invalidate< ChildTable >( n2 );
+
+            REQUIRE( test::fail( cache.fetch( outer ) ) );
+        }
+    }
+    WHEN( "a nested query throws mid-evaluation" )
+    {
+        auto outer = ScopedRecording{ cache };
+
+        try
+        {
+            auto const inner = ScopedRecording{ cache };
+
+            cache.record( n1 );
+
+            throw std::runtime_error{ "thrown mid-evaluation" };
+        }
+        catch( std::exception const& ) {}
+
+        cache.record( n2 );
+
+        auto const deps = outer.end();
+
+        THEN( "the inner frame was closed, accruing to the outer" )
+        {
+            REQUIRE( !cache.is_recording() );
+            REQUIRE( deps.nodes.contains( n1 ) );
+            REQUIRE( deps.nodes.contains( n2 ) );
+        }
+    }
+    WHEN( "a read changes mid-evaluation" )
+    {
+        auto const t3 = anchor::node( n1 ) | view2::parent | view2::to_tether;
+
+        cache.begin_recording();
+        cache.record( n1 );
+        cache.invalidate< HeadingTable >( n1 );
+        REQUIRE_RES( cache.push( t3, view2::FetchSet{}, cache.end_recording() ) );
+
+        THEN( "the result is not retained" )
+        {
+            REQUIRE( test::fail( cache.fetch( t3 ) ) );
+        }
+    }
+}
+
 auto QueryCache::begin() const
     -> TetherMap::const_iterator
 {
@@ -7,36 +7,166 @@
 #ifndef KMAP_DB_QUERY_CACHE_HPP
 #define KMAP_DB_QUERY_CACHE_HPP
 
+#include <com/database/common.hpp>
 #include <common.hpp>
 #include <path/view/common.hpp>
 #include <path/view/tether.hpp>
 
+#include <array>
+#include <bitset>
+#include <concepts>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
 namespace kmap::com::db {
 
+namespace detail {
+
+template< typename T
+        , typename... Ts >
+consteval auto variant_index( std::variant< Ts... > const* )
+    -> std::size_t
+{
+    auto i = std::size_t{ 0 };
+
+    ( void )( ( std::is_same_v< T, Ts > || ( ++i, false ) ) || ... );
+
+    return i;
+}
+
+} // namespace detail
+
+inline constexpr auto table_count = std::variant_size_v< TableVariant >;
+
+template< typename Table >
+inline constexpr auto table_index = detail::variant_index< Table >( static_cast< TableVariant const* >( nullptr ) );
+
+/**
+ * @brief What a query read in producing its result: individual nodes, and tables read as a whole (e.g., a scan of all headings).
+ */
+struct QueryDeps
+{
+    UuidUnSet nodes = {};
+    std::bitset< table_count > tables = {};
+    bool stale = false; // Something read was changed while the query was being evaluated.
+
+    auto depends_on( std::size_t const table
+                   , Uuid const& node ) const
+        -> bool;
+    auto merge( QueryDeps const& other )
+        -> void;
+};
+
+/**
+ * @brief Memoizes tether results, along with the nodes and tables each read, so that a change invalidates only the results depending on it.
+ * @note Reads are recorded while a query is evaluated, between begin_recording() and end_recording(). Recordings nest, with inner reads accruing to outer queries.
+ */
 class QueryCache
 {
-    using TetherMap = std::map< view2::Tether, view2::FetchSet >;
+    struct Entry
+    {
+        view2::FetchSet result = {};
+        QueryDeps deps = {};
+    };
+    using TetherMap = std::unordered_map< view2::Tether, Entry, boost::hash< view2::Tether > >; // Keyed by Tether::fingerprint().
+    using TetherSet = std::unordered_set< view2::Tether, boost::hash< view2::Tether > >;
 
     TetherMap map_ = {};
+    std::unordered_map< Uuid, TetherSet, boost::hash< Uuid > > node_dependents_ = {};
+    std::array< TetherSet, table_count > table_dependents_ = {};
+    mutable std::vector< QueryDeps > recordings_ = {}; // Innermost last.
+    std::uint64_t generation_ = 0;
 
 public:
     // auto normalize( view2::Tether const& tether )
     //     -> view2::Tether;
+    auto begin_recording() const
+        -> void;
     auto clear()
         -> void;
+    auto end_recording() const
+        -> QueryDeps;
+    /**
+     * @note A hit accrues the entry's dependencies to any recording in progress.
+     */
     auto fetch( view2::Tether const& tether ) const
         -> Result< view2::FetchSet >;
+    /**
+     * @brief Advances on every invalidation and clear, so caches kept outside this one can tell whether anything changed since they were filled.
+     */
+    auto generation() const
+        -> std::uint64_t;
+    auto is_recording() const
+        -> bool;
+    /**
+     * @brief Drops results that read `node` from `table`, or that read `table` as a whole.
+     */
+    auto invalidate( std::size_t const table
+                   , Uuid const& node )
+        -> void;
+    template< typename Table >
+    auto invalidate( std::same_as< Uuid > auto const&... nodes )
+        -> void
+    {
+        ( invalidate( table_index< Table >, nodes ), ... );
+    }
+    /**
+     * @note Results whose recorded reads went stale during evaluation are not retained.
+     */
     auto push( view2::Tether const& tether
-             , view2::FetchSet const& result )
+             , view2::FetchSet const& result
+             , QueryDeps const& deps )
         -> Result< void >;
+    auto record( Uuid const& node ) const
+        -> void;
+    template< typename Table >
+    auto record_table() const
+        -> void
+    {
+        if( !recordings_.empty() )
+        {
+            recordings_.back().tables.set( table_index< Table > );
+        }
+    }
+    auto size() const
+        -> std::size_t;
 
     auto begin() const
         -> TetherMap::const_iterator;
     auto end() const
         -> TetherMap::const_iterator;
+
+protected:
+    auto erase( view2::Tether const& tether )
+        -> void;
+};
+
+/**
+ * @brief Records for the lifetime of the scope, so a query that throws mid-evaluation doesn't leave its frame open to collect later, unrelated reads.
+ * @note A frame ended by unwinding still accrues to any enclosing recording, as reads made are reads made.
+ */
+class ScopedRecording
+{
+    QueryCache const& qcache_;
+    bool ended_ = false;
+
+public:
+    explicit ScopedRecording( QueryCache const& qcache );
+    ScopedRecording( ScopedRecording const& ) = delete;
+    auto operator=( ScopedRecording const& ) -> ScopedRecording& = delete;
+    ~ScopedRecording();
+
+    /**
+     * @brief Ends the recording ahead of scope exit, returning what was read.
+     */
+    auto end()
+        -> QueryDeps;
 };
 
 } // kmap::com::db
 
 
-#endif // KMAP_DB_QUERY_CACHE_HPP
\ No newline at end of file
+#endif // KMAP_DB_QUERY_CACHE_HPP
@@ -17,22 +17,22 @@ SQLPP_DECLARE_TABLE
 (
     ( nodes )
     ,
-    ( uuid, text, SQLPP_NOT_NULL  )
+    ( uuid, blob, SQLPP_NOT_NULL  )
 )
 
 SQLPP_DECLARE_TABLE
 (
     ( children )
     ,
-    ( parent_uuid, text, SQLPP_NOT_NULL  )
-    ( child_uuid, text, SQLPP_NOT_NULL  )
+    ( parent_uuid, blob, SQLPP_NOT_NULL  )
+    ( child_uuid, blob, SQLPP_NOT_NULL  )
 )
 
 SQLPP_DECLARE_TABLE
 (
     ( headings )
     ,
-    ( uuid, text, SQLPP_NOT_NULL  )
+    ( uuid, blob, SQLPP_NOT_NULL  )
     ( heading, text, SQLPP_NOT_NULL  )
 )
 
@@ -40,7 +40,7 @@ SQLPP_DECLARE_TABLE
 (
     ( titles )
     ,
-    ( uuid, text, SQLPP_NOT_NULL  )
+    ( uuid, blob, SQLPP_NOT_NULL  )
     ( title, text, SQLPP_NOT_NULL  )
 )
 
@@ -48,7 +48,7 @@ SQLPP_DECLARE_TABLE
 (
     ( bodies )
     ,
-    ( uuid, text, SQLPP_NOT_NULL  )
+    ( uuid, blob, SQLPP_NOT_NULL  )
     ( body, text, SQLPP_NOT_NULL  )
 )
 
@@ -56,15 +56,15 @@ SQLPP_DECLARE_TABLE
 (
     ( aliases )
     ,
-    ( src_uuid, text, SQLPP_NOT_NULL  )
-    ( dst_uuid, text, SQLPP_NOT_NULL  )
+    ( src_uuid, blob, SQLPP_NOT_NULL  )
+    ( dst_uuid, blob, SQLPP_NOT_NULL  )
 )
 
 SQLPP_DECLARE_TABLE
 (
     ( resources )
     ,
-    ( uuid, text, SQLPP_NOT_NULL  )
+    ( uuid, blob, SQLPP_NOT_NULL  )
     ( resource, blob, SQLPP_NOT_NULL  )
 )
 
@@ -72,64 +72,71 @@ SQLPP_DECLARE_TABLE
 (
     ( attributes )
     ,
-    ( parent_uuid, text, SQLPP_NOT_NULL  )
-    ( child_uuid, text, SQLPP_NOT_NULL  )
+    ( parent_uuid, blob, SQLPP_NOT_NULL  )
+    ( child_uuid, blob, SQLPP_NOT_NULL  )
 )
 
 namespace kmap::com::db {
 
+/**
+ * @brief Stored as the file's `PRAGMA user_version`.
+ *        0: UUIDs stored as 36-character TEXT.
+ *        1: UUIDs stored as 16-byte BLOBs.
+ */
+inline constexpr auto schema_version = 1;
+
 inline
 auto const table_map = std::map< std::string, std::string >
 {
     { "nodes", 
 R"(CREATE TABLE IF NOT EXISTS nodes
-(   uuid
+(   uuid BLOB
 ,   PRIMARY KEY( uuid )
 );)" }
 ,   { "children",
 R"(CREATE TABLE IF NOT EXISTS children
-(   parent_uuid TEXT
-,   child_uuid TEXT
+(   parent_uuid BLOB
+,   child_uuid BLOB
 ,   PRIMARY KEY( parent_uuid
                , child_uuid )
 );)" }
 ,   { "headings",
 R"(CREATE TABLE IF NOT EXISTS headings
-(   uuid TEXT
+(   uuid BLOB
 ,   heading TEXT
 ,   PRIMARY KEY( uuid )
 );)" }
 ,   { "titles",
 R"(
 CREATE TABLE IF NOT EXISTS titles
-(   uuid TEXT
+(   uuid BLOB
 ,   title TEXT
 ,   PRIMARY KEY( uuid )
 );)" }
 ,   { "bodies", 
 R"(
 CREATE TABLE IF NOT EXISTS bodies
-(   uuid TEXT
+(   uuid BLOB
 ,   body TEXT
 ,   PRIMARY KEY( uuid )
 );)" }
 ,   { "aliases",
 R"(CREATE TABLE IF NOT EXISTS aliases
-(   src_uuid TEXT
-,   dst_uuid TEXT
+(   src_uuid BLOB
+,   dst_uuid BLOB
 ,   PRIMARY KEY( src_uuid
                , dst_uuid )
 );)" }
 ,   { "attributes",
 R"(CREATE TABLE IF NOT EXISTS attributes
-(   parent_uuid TEXT
-,   child_uuid TEXT
+(   parent_uuid BLOB
+,   child_uuid BLOB
 ,   PRIMARY KEY( parent_uuid
                , child_uuid )
 );)" }
 ,   { "resources",
 R"(CREATE TABLE IF NOT EXISTS resources
-(   uuid TEXT
+(   uuid BLOB
 ,   resource BLOB
 ,   PRIMARY KEY( uuid )
 );)" }
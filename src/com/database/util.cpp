@@ -6,9 +6,12 @@
 #include <com/database/util.hpp>
 
 #include <com/database/table_decl.hpp>
+#include <error/db.hpp>
+#include <test/util.hpp>
 #include <util/result.hpp>
 
 #include <boost/filesystem.hpp>
+#include <catch2/catch_test_macros.hpp>
 #include <sqlpp11/sqlpp11.h>
 #include <sqlpp11/sqlite3/connection.h>
 #include <sqlpp11/connection.h>
@@ -28,8 +31,404 @@ auto dbErrorLogCallback( void* pArg
               , zMsg );
 }
 
+auto make_placeholder_rows( std::size_t const ncols
+                          , std::size_t const nrows )
+    -> std::string
+{
+    auto row = std::string{ "(" };
+
+    for( auto i = std::size_t{ 0 }
+       ; i < ncols
+       ; ++i )
+    {
+        row += ( i == 0 ? "?" : ",?" );
+    }
+
+    row += ")";
+
+    auto rv = std::string{};
+
+    rv.reserve( nrows * ( row.size() + 1 ) );
+
+    for( auto i = std::size_t{ 0 }
+       ; i < nrows
+       ; ++i )
+    {
+        if( i != 0 )
+        {
+            rv += ",";
+        }
+
+        rv += row;
+    }
+
+    return rv;
+}
+
+auto make_insert_sql( RowBatch const& batch
+                    , std::size_t const nrows )
+    -> std::string
+{
+    auto cols = std::string{};
+
+    for( auto const& col : batch.columns )
+    {
+        cols += ( cols.empty() ? col.name : "," + col.name );
+    }
+
+    return fmt::format( "INSERT OR REPLACE INTO {}({}) VALUES {};"
+                      , batch.table
+                      , cols
+                      , make_placeholder_rows( batch.columns.size(), nrows ) );
+}
+
+auto make_remove_sql( RowBatch const& batch )
+    -> std::string
+{
+    auto conds = std::string{};
+
+    for( auto const& col : batch.columns )
+    {
+        conds += fmt::format( "{}{} = ?", conds.empty() ? "" : " AND ", col.name );
+    }
+
+    return fmt::format( "DELETE FROM {} WHERE {};"
+                      , batch.table
+                      , conds );
+}
+
+/**
+ * @brief Binds `count` values of `batch`, starting from `first`, to `stmt` and steps it once, leaving `stmt` reset for reuse.
+ */
+auto step_bound( sqlpp::sqlite3::connection& con
+               , sqlite3_stmt* stmt
+               , RowBatch const& batch
+               , std::size_t const first
+               , std::size_t const count
+               , error_code::db const ec )
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< void >();
+    auto const ncols = batch.columns.size();
+
+    for( auto i = std::size_t{ 0 }
+       ; i < count
+       ; ++i )
+    {
+        auto const& v = batch.values[ first + i ];
+        auto const param = static_cast< int >( i + 1 );
+
+        if( batch.columns[ ( first + i ) % ncols ].blob )
+        {
+            sqlite3_bind_blob( stmt, param, v.data(), static_cast< int >( v.size() ), SQLITE_STATIC );
+        }
+        else
+        {
+            sqlite3_bind_text( stmt, param, v.data(), static_cast< int >( v.size() ), SQLITE_STATIC );
+        }
+    }
+
+    auto const rc = sqlite3_step( stmt );
+
+    sqlite3_reset( stmt );
+    sqlite3_clear_bindings( stmt );
+
+    KMAP_ENSURE_MSG( rc == SQLITE_DONE, ec, sqlite3_errmsg( con.native_handle() ) );
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+/**
+ * @brief Steps the query `sql`, bound to the UUID `param`, collecting the first column of each resulting row.
+ *        UUID results are rendered as text.
+ */
+auto select_column( sqlpp::sqlite3::connection& con
+                  , StatementCache& stmts
+                  , std::string const& sql
+                  , std::string const& param
+                  , bool const uuid_result )
+    -> Result< std::set< std::string > >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_STR( "param", param );
+
+    auto rv = result::make_result< std::set< std::string > >();
+    auto rs = decltype( rv )::value_type{};
+    auto const key = uuid_bytes( KTRY( uuid_from_string( param ) ) );
+    auto const stmt = KTRY( stmts.fetch( con, sql ) );
+
+    sqlite3_bind_blob( stmt, 1, key.data(), static_cast< int >( key.size() ), SQLITE_STATIC );
+
+    auto rc = sqlite3_step( stmt );
+
+    while( rc == SQLITE_ROW )
+    {
+        if( uuid_result )
+        {
+            auto const data = static_cast< std::uint8_t const* >( sqlite3_column_blob( stmt, 0 ) );
+
+            if( auto const id = uuid_from_blob( data, static_cast< std::size_t >( sqlite3_column_bytes( stmt, 0 ) ) )
+              ; id )
+            {
+                rs.emplace( to_string( id.value() ) );
+            }
+        }
+        else
+        {
+            // Note: NULL reads as empty, as it did via sqlpp.
+            auto const text = reinterpret_cast< char const* >( sqlite3_column_text( stmt, 0 ) );
+
+            rs.emplace( text == nullptr ? std::string{} : std::string{ text, static_cast< std::size_t >( sqlite3_column_bytes( stmt, 0 ) ) } );
+        }
+
+        rc = sqlite3_step( stmt );
+    }
+
+    sqlite3_reset( stmt );
+    sqlite3_clear_bindings( stmt );
+
+    KMAP_ENSURE_MSG( rc == SQLITE_DONE, error_code::db::entry_not_found, sqlite3_errmsg( con.native_handle() ) );
+
+    rv = rs;
+
+    return rv;
+}
+
 } // namespace anon
 
+auto prepare( sqlpp::sqlite3::connection& con
+            , std::string const& sql )
+    -> Result< StatementPtr >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_STR( "sql", sql );
+
+    auto rv = result::make_result< StatementPtr >();
+    sqlite3_stmt* stmt = nullptr;
+
+    if( auto const rc = sqlite3_prepare_v2( con.native_handle(), sql.c_str(), static_cast< int >( sql.size() + 1 ), &stmt, nullptr )
+      ; rc == SQLITE_OK )
+    {
+        rv = StatementPtr{ stmt, &sqlite3_finalize };
+    }
+    else
+    {
+        sqlite3_finalize( stmt );
+
+        rv = KMAP_MAKE_ERROR_MSG( error_code::common::uncategorized, sqlite3_errmsg( con.native_handle() ) );
+    }
+
+    return rv;
+}
+
+auto fetch_schema_version( sqlpp::sqlite3::connection& con )
+    -> Result< int >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< int >();
+    auto const stmt = KTRY( prepare( con, "PRAGMA user_version;" ) );
+
+    KMAP_ENSURE_MSG( sqlite3_step( stmt.get() ) == SQLITE_ROW, error_code::common::uncategorized, sqlite3_errmsg( con.native_handle() ) );
+
+    rv = sqlite3_column_int( stmt.get(), 0 );
+
+    return rv;
+}
+
+auto is_uuid_column( std::string_view const name )
+    -> bool
+{
+    return name == "uuid" || name.ends_with( "_uuid" );
+}
+
+auto to_blob( Uuid const& id )
+    -> Blob
+{
+    return Blob( id.begin(), id.end() );
+}
+
+auto uuid_bytes( Uuid const& id )
+    -> std::string
+{
+    return std::string( reinterpret_cast< char const* >( id.data ), id.size() );
+}
+
+auto uuid_from_blob( std::uint8_t const* data
+                   , std::size_t const size )
+    -> Result< Uuid >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Uuid >();
+
+    KMAP_ENSURE( data != nullptr && size == Uuid::static_size(), error_code::common::conversion_failed );
+
+    auto id = Uuid{};
+
+    std::copy( data, data + size, id.begin() );
+
+    rv = id;
+
+    return rv;
+}
+
+auto uuid_from_blob( Blob const& blob )
+    -> Result< Uuid >
+{
+    return uuid_from_blob( blob.data(), blob.size() );
+}
+
+auto update_schema_version( sqlpp::sqlite3::connection& con
+                          , int const version )
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< void >();
+    // Note: PRAGMA does not accept bound parameters.
+    auto const stmt = KTRY( prepare( con, fmt::format( "PRAGMA user_version = {};", version ) ) );
+
+    KMAP_ENSURE_MSG( sqlite3_step( stmt.get() ) == SQLITE_DONE, error_code::common::uncategorized, sqlite3_errmsg( con.native_handle() ) );
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+auto StatementCache::clear()
+    -> void
+{
+    stmts_.clear();
+}
+
+auto StatementCache::fetch( sqlpp::sqlite3::connection& con
+                          , std::string const& sql )
+    -> Result< sqlite3_stmt* >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_STR( "sql", sql );
+
+    auto rv = result::make_result< sqlite3_stmt* >();
+
+    if( auto const it = stmts_.find( sql )
+      ; it != stmts_.end() && sqlite3_db_handle( it->second.get() ) == con.native_handle() )
+    {
+        auto const stmt = it->second.get();
+
+        sqlite3_reset( stmt );
+        sqlite3_clear_bindings( stmt );
+
+        ++stats_.reused;
+
+        rv = stmt;
+    }
+    else
+    {
+        if( it != stmts_.end() )
+        {
+            // Cached against a prior connection; the cache should have been cleared upon reopening.
+            clear();
+        }
+
+        auto const [ nit, inserted ] = stmts_.emplace( sql, KTRY( prepare( con, sql ) ) );
+
+        ++stats_.prepared;
+
+        rv = nit->second.get();
+    }
+
+    return rv;
+}
+
+auto StatementCache::size() const
+    -> std::size_t
+{
+    return stmts_.size();
+}
+
+auto StatementCache::stats() const
+    -> Stats const&
+{
+    return stats_;
+}
+
+auto insert_rows( sqlpp::sqlite3::connection& con
+                , StatementCache& stmts
+                , RowBatch const& batch )
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_STR( "table", batch.table );
+
+    auto rv = result::make_result< void >();
+    auto const ncols = batch.columns.size();
+    auto const nrows = batch.row_count();
+
+    if( nrows > 0 )
+    {
+        auto const var_limit = static_cast< std::size_t >( sqlite3_limit( con.native_handle(), SQLITE_LIMIT_VARIABLE_NUMBER, -1 ) );
+        auto const chunk_rows = std::max( std::size_t{ 1 }, std::min( max_rows_per_insert, var_limit / ncols ) );
+        auto const full_chunks = nrows / chunk_rows;
+        auto const rem_rows = nrows % chunk_rows;
+
+        if( full_chunks > 0 )
+        {
+            auto const stmt = KTRY( stmts.fetch( con, make_insert_sql( batch, chunk_rows ) ) );
+
+            for( auto i = std::size_t{ 0 }
+               ; i < full_chunks
+               ; ++i )
+            {
+                KTRY( step_bound( con, stmt, batch, i * chunk_rows * ncols, chunk_rows * ncols, error_code::db::push_failed ) );
+            }
+        }
+        if( rem_rows > 0 )
+        {
+            auto const stmt = KTRY( stmts.fetch( con, make_insert_sql( batch, rem_rows ) ) );
+
+            KTRY( step_bound( con, stmt, batch, full_chunks * chunk_rows * ncols, rem_rows * ncols, error_code::db::push_failed ) );
+        }
+    }
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+auto remove_rows( sqlpp::sqlite3::connection& con
+                , StatementCache& stmts
+                , RowBatch const& batch )
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_STR( "table", batch.table );
+
+    auto rv = result::make_result< void >();
+    auto const ncols = batch.columns.size();
+    auto const nrows = batch.row_count();
+
+    if( nrows > 0 )
+    {
+        auto const stmt = KTRY( stmts.fetch( con, make_remove_sql( batch ) ) );
+
+        for( auto i = std::size_t{ 0 }
+           ; i < nrows
+           ; ++i )
+        {
+            KTRY( step_bound( con, stmt, batch, i * ncols, ncols, error_code::db::erase_failed ) );
+        }
+    }
+
+    rv = outcome::success();
+
+    return rv;
+}
+
 /**
  * Note:
  *   - Use of "unix-dotfile" as a locking mechanism is done because some platforms/VFSs aren't supporting the default locking mechanism for SQLITE.
@@ -78,43 +477,30 @@ auto open_connection( FsPath const& db_path
 }
 
 auto select_aliases( sqlpp::sqlite3::connection& con
+                   , StatementCache& stmts
                    , std::string const& node )
     -> Result< std::set< std::string > >
 {
     KM_RESULT_PROLOG();
 
     auto rv = result::make_result< std::set< std::string > >();
-    auto rs = decltype( rv )::value_type{};
-    auto tbl = aliases::aliases{};
 
-    for( auto rows = con( select( all_of( tbl ) ).from( tbl ).where( tbl.dst_uuid == node ) )
-       ; auto const& row : rows )
-    {
-        rs.emplace( row.src_uuid );
-    }
-
-    rv = rs;
+    rv = KTRY( select_column( con, stmts, "SELECT src_uuid FROM aliases WHERE dst_uuid = ?;", node, true ) );
 
     return rv;
 }
 
 auto select_attribute_root( sqlpp::sqlite3::connection& con
+                          , StatementCache& stmts
                           , std::string const& node )
     -> Result< std::string >
 {
     KM_RESULT_PROLOG();
 
     auto rv = result::make_result< std::string >();
-    auto rs = std::set< std::string >{};
-    auto att = attributes::attributes{};
 
-    for( auto rows = con( select( all_of( att ) ).from( att ).where( att.parent_uuid == node ) )
-       ; auto const& row : rows )
-    {
-        rs.emplace( row.child_uuid );
-    }
-
-    if( rs.size() == 1 )
+    if( auto const rs = KTRY( select_column( con, stmts, "SELECT child_uuid FROM attributes WHERE parent_uuid = ?;", node, true ) )
+      ; rs.size() == 1 )
     {
         rv = *rs.begin();
     }
@@ -123,44 +509,31 @@ auto select_attribute_root( sqlpp::sqlite3::connection& con
 }
 
 auto select_attributes( sqlpp::sqlite3::connection& con
+                      , StatementCache& stmts
                       , std::string const& node )
     -> Result< std::set< std::string > >
 {
     KM_RESULT_PROLOG();
 
     auto rv = result::make_result< std::set< std::string > >();
-    auto rs = decltype( rv )::value_type{};
-    auto ct = children::children{};
-    auto const attr_root = KTRY( select_attribute_root( con, node ) );
+    auto const attr_root = KTRY( select_attribute_root( con, stmts, node ) );
 
-    for( auto rows = con( select( all_of( ct ) ).from( ct ).where( ct.parent_uuid == attr_root ) )
-       ; auto const& row : rows )
-    {
-        rs.emplace( row.child_uuid );
-    }
-
-    rv = rs;
+    rv = KTRY( select_children( con, stmts, attr_root ) );
 
     return rv;
 }
 
 auto select_body( sqlpp::sqlite3::connection& con
+                , StatementCache& stmts
                 , std::string const& node )
     -> Result< std::string >
 {
     KM_RESULT_PROLOG();
 
     auto rv = result::make_result< std::string >();
-    auto rs = std::set< decltype( rv )::value_type >{};
-    auto tbl = bodies::bodies{};
-
-    for( auto rows = con( select( all_of( tbl ) ).from( tbl ).where( tbl.uuid == node ) )
-       ; auto const& row : rows )
-    {
-        rs.emplace( row.body );
-    }
 
-    if( rs.size() == 1 )
+    if( auto const rs = KTRY( select_column( con, stmts, "SELECT body FROM bodies WHERE uuid = ?;", node, false ) )
+      ; rs.size() == 1 )
     {
         rv = *rs.begin();
     }
@@ -169,43 +542,30 @@ auto select_body( sqlpp::sqlite3::connection& con
 }
 
 auto select_children( sqlpp::sqlite3::connection& con
+                    , StatementCache& stmts
                     , std::string const& node )
     -> Result< std::set< std::string > >
 {
     KM_RESULT_PROLOG();
 
     auto rv = result::make_result< std::set< std::string > >();
-    auto rs = decltype( rv )::value_type{};
-    auto ct = children::children{};
 
-    for( auto rows = con( select( all_of( ct ) ).from( ct ).where( ct.parent_uuid == node ) )
-       ; auto const& row : rows )
-    {
-        rs.emplace( row.child_uuid );
-    }
-
-    rv = rs;
+    rv = KTRY( select_column( con, stmts, "SELECT child_uuid FROM children WHERE parent_uuid = ?;", node, true ) );
 
     return rv;
 }
 
 auto select_heading( sqlpp::sqlite3::connection& con
+                   , StatementCache& stmts
                    , std::string const& node )
     -> Result< std::string >
 {
     KM_RESULT_PROLOG();
 
     auto rv = result::make_result< std::string >();
-    auto rs = std::set< decltype( rv )::value_type >{};
-    auto tbl = headings::headings{};
-
-    for( auto rows = con( select( all_of( tbl ) ).from( tbl ).where( tbl.uuid == node ) )
-       ; auto const& row : rows )
-    {
-        rs.emplace( row.heading );
-    }
 
-    if( rs.size() == 1 )
+    if( auto const rs = KTRY( select_column( con, stmts, "SELECT heading FROM headings WHERE uuid = ?;", node, false ) )
+      ; rs.size() == 1 )
     {
         rv = *rs.begin();
     }
@@ -214,22 +574,16 @@ auto select_heading( sqlpp::sqlite3::connection& con
 }
 
 auto select_parent( sqlpp::sqlite3::connection& con
+                  , StatementCache& stmts
                   , std::string const& node )
     -> Result< std::string >
 {
     KM_RESULT_PROLOG();
 
     auto rv = result::make_result< std::string >();
-    auto rs = std::set< decltype( rv )::value_type >{};
-    auto ct = children::children{};
-
-    for( auto rows = con( select( all_of( ct ) ).from( ct ).where( ct.child_uuid == node ) )
-       ; auto const& row : rows )
-    {
-        rs.emplace( row.parent_uuid );
-    }
 
-    if( rs.size() == 1 )
+    if( auto const rs = KTRY( select_column( con, stmts, "SELECT parent_uuid FROM children WHERE child_uuid = ?;", node, true ) )
+      ; rs.size() == 1 )
     {
         rv = *rs.begin();
     }
@@ -238,27 +592,169 @@ auto select_parent( sqlpp::sqlite3::connection& con
 }
 
 auto select_attr_parent( sqlpp::sqlite3::connection& con
+                       , StatementCache& stmts
                        , std::string const& node )
     -> Result< std::string >
 {
     KM_RESULT_PROLOG();
 
     auto rv = result::make_result< std::string >();
-    auto rs = std::set< decltype( rv )::value_type >{};
-    auto tbl = attributes::attributes{};
 
-    for( auto rows = con( select( all_of( tbl ) ).from( tbl ).where( tbl.child_uuid == node ) )
-       ; auto const& row : rows )
+    if( auto const rs = KTRY( select_column( con, stmts, "SELECT parent_uuid FROM attributes WHERE child_uuid = ?;", node, true ) )
+      ; rs.size() == 1 )
     {
-        rs.emplace( row.parent_uuid );
+        rv = *rs.begin();
     }
 
-    if( rs.size() == 1 )
+    return rv;
+}
+
+SCENARIO( "StatementCache reuses statements by shape", "[db][statement_cache]" )
+{
+    auto cfg = sqlpp::sqlite3::connection_config{};
+
+    cfg.path_to_database = ":memory:";
+    cfg.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+    auto con = sqlpp::sqlite3::connection{ cfg };
+    auto stmts = StatementCache{};
+
+    con.execute( table_map.at( "headings" ) );
+
+    GIVEN( "two single-row batches of the same shape" )
     {
-        rv = *rs.begin();
+        auto const n1 = gen_uuid();
+        auto const n2 = gen_uuid();
+        auto const cols = std::vector< RowBatch::Column >{ { .name = "uuid", .blob = true }, { .name = "heading" } };
+        auto const b1 = RowBatch{ .table = "headings", .columns = cols, .values = { uuid_bytes( n1 ), "h1" } };
+        auto const b2 = RowBatch{ .table = "headings", .columns = cols, .values = { uuid_bytes( n2 ), "h2" } };
+
+        REQUIRE_RES( insert_rows( con, stmts, b1 ) );
+        REQUIRE_RES( insert_rows( con, stmts, b2 ) );
+
+        THEN( "the insert is prepared once and reused once" )
+        {
+            REQUIRE( stmts.size() == 1 );
+            REQUIRE( stmts.stats().prepared == 1 );
+            REQUIRE( stmts.stats().reused == 1 );
+        }
+
+        WHEN( "selecting each heading" )
+        {
+            auto const h1 = REQUIRE_TRY( select_heading( con, stmts, to_string( n1 ) ) );
+            auto const h2 = REQUIRE_TRY( select_heading( con, stmts, to_string( n2 ) ) );
+
+            REQUIRE( h1 == "h1" );
+            REQUIRE( h2 == "h2" );
+
+            THEN( "the select is prepared once and reused once" )
+            {
+                REQUIRE( stmts.size() == 2 );
+                REQUIRE( stmts.stats().prepared == 2 );
+                REQUIRE( stmts.stats().reused == 2 );
+            }
+        }
+        WHEN( "the cache is cleared" )
+        {
+            stmts.clear();
+
+            REQUIRE_RES( remove_rows( con, stmts, b1 ) );
+
+            THEN( "statements are dropped, but counts persist" )
+            {
+                REQUIRE( stmts.size() == 1 );
+                REQUIRE( stmts.stats().prepared == 2 );
+                REQUIRE_RFAIL( select_heading( con, stmts, to_string( n1 ) ) );
+            }
+        }
     }
+}
 
-    return rv;
+SCENARIO( "insert_rows splits batches into bounded chunks", "[db][statement_cache]" )
+{
+    auto cfg = sqlpp::sqlite3::connection_config{};
+
+    cfg.path_to_database = ":memory:";
+    cfg.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+    auto con = sqlpp::sqlite3::connection{ cfg };
+    auto stmts = StatementCache{};
+    auto const cols = std::vector< RowBatch::Column >{ { .name = "uuid", .blob = true }, { .name = "heading" } };
+    auto const make_batch = [ & ]( std::size_t const nrows )
+    {
+        auto rv = std::make_pair( RowBatch{ .table = "headings", .columns = cols }, std::vector< Uuid >{} );
+
+        for( auto i = std::size_t{ 0 }
+           ; i < nrows
+           ; ++i )
+        {
+            auto const id = gen_uuid();
+
+            rv.first.values.emplace_back( uuid_bytes( id ) );
+            rv.first.values.emplace_back( std::to_string( i ) );
+            rv.second.emplace_back( id );
+        }
+
+        return rv;
+    };
+    auto const require_written = [ & ]( std::vector< Uuid > const& ids )
+    {
+        for( auto i = std::size_t{ 0 }
+           ; i < ids.size()
+           ; ++i )
+        {
+            REQUIRE( REQUIRE_TRY( select_heading( con, stmts, to_string( ids[ i ] ) ) ) == std::to_string( i ) );
+        }
+    };
+
+    con.execute( table_map.at( "headings" ) );
+
+    GIVEN( "more rows than max_rows_per_insert" )
+    {
+        auto const [ batch, ids ] = make_batch( max_rows_per_insert + 1 );
+
+        REQUIRE_RES( insert_rows( con, stmts, batch ) );
+
+        THEN( "a full chunk and the remainder are each prepared" )
+        {
+            REQUIRE( stmts.size() == 2 );
+            REQUIRE( stmts.stats().prepared == 2 );
+        }
+        THEN( "every row is written" )
+        {
+            require_written( ids );
+        }
+    }
+    GIVEN( "more bound values than SQLITE_LIMIT_VARIABLE_NUMBER allows" )
+    {
+        sqlite3_limit( con.native_handle(), SQLITE_LIMIT_VARIABLE_NUMBER, 8 ); // Four rows of two columns.
+
+        auto const [ batch, ids ] = make_batch( 10 );
+
+        REQUIRE_RES( insert_rows( con, stmts, batch ) );
+
+        THEN( "full chunks share one statement, and the remainder has its own" )
+        {
+            REQUIRE( stmts.size() == 2 );
+            REQUIRE( stmts.stats().prepared == 2 );
+        }
+        THEN( "every row is written" )
+        {
+            require_written( ids );
+        }
+    }
+}
+
+SCENARIO( "UUIDs round trip through their BLOB form", "[db]" )
+{
+    auto const id = gen_uuid();
+    auto const blob = to_blob( id );
+    auto const rid = REQUIRE_TRY( uuid_from_blob( blob ) );
+
+    REQUIRE( blob.size() == 16 );
+    REQUIRE( rid == id );
+    REQUIRE( uuid_bytes( id ) == std::string( blob.begin(), blob.end() ) );
+    REQUIRE_RFAIL( uuid_from_blob( Blob( 15 ) ) );
 }
 
 } // namespace kmap::com::db
@@ -11,11 +11,95 @@
 
 #include <sqlpp11/sqlite3/connection.h>
 
+#include <cstdint>
+#include <memory>
 #include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace kmap::com::db {
 
+/**
+ * @brief Upper bound on rows bound to a single multi-row INSERT. The effective bound is further limited by SQLITE_LIMIT_VARIABLE_NUMBER.
+ */
+inline constexpr auto max_rows_per_insert = std::size_t{ 256 };
+
+using Blob = std::vector< std::uint8_t >;
+using StatementPtr = std::unique_ptr< sqlite3_stmt, decltype( &sqlite3_finalize ) >;
+
+/**
+ * @brief Prepared statements keyed by their SQL text (i.e., the statement's shape, with values bound as parameters), reused across calls.
+ * @note Statements belong to the connection they were prepared against, so the cache must be cleared before that connection is closed or replaced.
+ */
+class StatementCache
+{
+public:
+    struct Stats
+    {
+        std::size_t prepared = 0;
+        std::size_t reused = 0;
+    };
+
+private:
+    std::unordered_map< std::string, StatementPtr > stmts_ = {};
+    Stats stats_ = {};
+
+public:
+    auto clear()
+        -> void;
+    /**
+     * @brief Returns the statement for `sql`, preparing it on first use. A reused statement is reset, with its bindings cleared.
+     * @note The returned statement remains owned by the cache.
+     */
+    auto fetch( sqlpp::sqlite3::connection& con
+              , std::string const& sql )
+        -> Result< sqlite3_stmt* >;
+    auto size() const
+        -> std::size_t;
+    auto stats() const
+        -> Stats const&;
+};
+
+/**
+ * @brief Rows destined for a single table, laid out row-major in `values`, i.e., values.size() is a multiple of columns.size().
+ */
+struct RowBatch
+{
+    struct Column
+    {
+        std::string name = {};
+        bool blob = false; // Values hold raw bytes, bound as BLOB rather than TEXT.
+    };
+
+    std::string table = {};
+    std::vector< Column > columns = {};
+    std::vector< std::string > values = {};
+
+    auto row_count() const
+        -> std::size_t
+    {
+        return columns.empty() ? 0 : values.size() / columns.size();
+    }
+};
+
+auto fetch_schema_version( sqlpp::sqlite3::connection& con )
+    -> Result< int >;
+/**
+ * @brief Inserts (or replaces) all rows of `batch` via multi-row statements of bounded size.
+ *        The full-size statement is reused for every full chunk, and both it and the remainder's are reused across calls via `stmts`.
+ * @note Does not begin a transaction; caller is expected to wrap related batches in one.
+ */
+auto insert_rows( sqlpp::sqlite3::connection& con
+                , StatementCache& stmts
+                , RowBatch const& batch )
+    -> Result< void >;
+/**
+ * @brief Whether `name` follows the naming convention for UUID columns, i.e., "uuid" or "*_uuid".
+ */
+auto is_uuid_column( std::string_view const name )
+    -> bool;
 auto make_connection_config( FsPath const& db_path
                            , int flags
                            , bool debug )
@@ -24,30 +108,64 @@ auto open_connection( FsPath const& db_path
                     , int flags
                     , bool debug )
     -> sqlpp::sqlite3::connection;
+auto prepare( sqlpp::sqlite3::connection& con
+            , std::string const& sql )
+    -> Result< StatementPtr >;
+/**
+ * @brief Deletes all rows of `batch` matching every column of a row, reusing a single prepared statement.
+ * @note Does not begin a transaction; caller is expected to wrap related batches in one.
+ */
+auto remove_rows( sqlpp::sqlite3::connection& con
+                , StatementCache& stmts
+                , RowBatch const& batch )
+    -> Result< void >;
 auto select_aliases( sqlpp::sqlite3::connection& con
+                   , StatementCache& stmts
                    , std::string const& node )
     -> Result< std::set< std::string > >;
 auto select_attribute_root( sqlpp::sqlite3::connection& con
+                          , StatementCache& stmts
                           , std::string const& node )
     -> Result< std::string >;
 auto select_attributes( sqlpp::sqlite3::connection& con
+                      , StatementCache& stmts
                       , std::string const& node )
     -> Result< std::set< std::string > >;
 auto select_attr_parent( sqlpp::sqlite3::connection& con
+                       , StatementCache& stmts
                        , std::string const& node )
     -> Result< std::string >;
 auto select_body( sqlpp::sqlite3::connection& con
+                , StatementCache& stmts
                 , std::string const& node )
     -> Result< std::string >;
 auto select_children( sqlpp::sqlite3::connection& con
+                    , StatementCache& stmts
                     , std::string const& node )
     -> Result< std::set< std::string > >;
 auto select_heading( sqlpp::sqlite3::connection& con
+                   , StatementCache& stmts
                    , std::string const& node )
     -> Result< std::string >;
 auto select_parent( sqlpp::sqlite3::connection& con
+                  , StatementCache& stmts
                   , std::string const& node )
     -> Result< std::string >;
+auto to_blob( Uuid const& id )
+    -> Blob;
+auto update_schema_version( sqlpp::sqlite3::connection& con
+                          , int const version )
+    -> Result< void >;
+/**
+ * @brief Returns the 16 raw bytes of `id`, as bound to a BLOB column via RowBatch.
+ */
+auto uuid_bytes( Uuid const& id )
+    -> std::string;
+auto uuid_from_blob( std::uint8_t const* data
+                   , std::size_t const size )
+    -> Result< Uuid >;
+auto uuid_from_blob( Blob const& blob )
+    -> Result< Uuid >;
 
 } // kmap::com::db
 
@@ -6,6 +6,7 @@
 #include <com/event/event.hpp>
 
 #include <cmd/parser.hpp>
+#include <com/database/db.hpp>
 #include <com/network/network.hpp>
 #include <common.hpp>
 #include <error/network.hpp>
@@ -18,6 +19,7 @@
 #include <path/act/push.hpp>
 #include <path/node_view.hpp>
 #include <path/node_view2.hpp>
+#include <path/order.hpp>
 #include <test/util.hpp>
 #include <util/result.hpp>
 #include <util/script/script.hpp>
@@ -40,17 +42,40 @@
 #include <range/v3/view/split.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <algorithm>
 #include <vector>
 
 namespace rvs = ranges::views;
 
 namespace kmap::com {
 
+EventStore::~EventStore()
+{
+#if !KMAP_NATIVE
+    if( action_cache_subscription_ )
+    {
+        if( auto const db = component_slot< com::Database >()
+          ; db )
+        {
+            db->change_feed().unsubscribe( *action_cache_subscription_ );
+        }
+    }
+#endif // !KMAP_NATIVE
+}
+
 auto EventStore::initialize()
     -> Result< void >
 {
+    KM_RESULT_PROLOG();
+
     auto rv = result::make_result< void >();
 
+#if !KMAP_NATIVE
+    auto const db = KTRY( fetch_component< com::Database >() );
+
+    action_cache_subscription_ = db->change_feed().subscribe( [ this ]( auto const& batch ){ action_cache_.erase_changed( batch ); } );
+#endif // !KMAP_NATIVE
+
     rv = outcome::success();
 
     return rv;
@@ -61,6 +86,11 @@ auto EventStore::load()
 {
     auto rv = result::make_result< void >();
 
+    outlet_index_ = std::nullopt;
+#if !KMAP_NATIVE
+    action_cache_.clear();
+#endif // !KMAP_NATIVE
+
     rv = outcome::success();
 
     return rv;
@@ -97,6 +127,33 @@ auto EventStore::event_root() const
     return rv;
 }
 
+auto EventStore::ensure_outlet_index()
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = KMAP_MAKE_RESULT( void );
+
+    if( !outlet_index_ )
+    {
+        auto const& km = kmap_inst();
+        auto const all_outlets = view2::event::outlet_root
+                               | view2::desc( view2::event::outlet )
+                               | act2::to_node_set( km );
+
+        outlet_index_ = OutletIndex{};
+
+        for( auto const& outlet : all_outlets )
+        {
+            KTRY( index_outlet( outlet ) );
+        }
+    }
+
+    rv = outcome::success();
+
+    return rv;
+}
+
 /// "Outlet base" refers to the root of an outlet tree (outlet branches and leaves). Avoiding overloading the word "outlet root" to emphasize that it isn't referring to event.outlet. Perhaps "local_outlet_root"?
 auto EventStore::fetch_outlet_base( Uuid const& node )
     -> Result< Uuid >
@@ -177,6 +234,42 @@ auto EventStore::has_requisites( Uuid const& outlet
     return false;
 }
 
+auto EventStore::index_outlet( Uuid const& outlet )
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_NODE( "outlet", outlet );
+
+    auto rv = KMAP_MAKE_RESULT( void );
+
+    BC_CONTRACT()
+        BC_PRE([ & ]
+        {
+            BC_ASSERT( outlet_index_.has_value() );
+        })
+    ;
+
+    auto const& km = kmap_inst();
+    auto const reqs = anchor::node( outlet )
+                    | view2::event::requisite
+                    | view2::resolve
+                    | act2::to_node_set( km );
+    auto& index = outlet_index_.value();
+
+    unindex_outlet( outlet );
+
+    for( auto const& req : reqs )
+    {
+        index.outlets[ req ].emplace( outlet );
+    }
+
+    index.requisites[ outlet ] = reqs;
+
+    rv = outcome::success();
+
+    return rv;
+}
+
 // TODO: Or maybe, make a view action? view::verb( heading ) | act::fetch_or_create(), thereby giving the user the option of whether to fetch, create, or either.
 auto EventStore::install_verb( Heading const& heading )
     -> Result< Uuid >
@@ -359,6 +452,15 @@ auto EventStore::install_outlet_internal( Uuid const& root
     KTRY( nw->update_body( descn, leaf.description ) );
     KTRY( nw->update_body( actionn, action_body ) );
 
+    if( outlet_index_ )
+    {
+        KTRY( index_outlet( root ) );
+    }
+    else
+    {
+        KTRY( ensure_outlet_index() ); // Built from the outlet tree, `root` included.
+    }
+
     rv = outcome::success();
 
     return rv;
@@ -411,6 +513,15 @@ auto EventStore::install_outlet_internal( Uuid const& root
         };
         KTRY( std::visit( dispatch , transition ) );
     }
+
+    if( outlet_index_ )
+    {
+        KTRY( index_outlet( root ) );
+    }
+    else
+    {
+        KTRY( ensure_outlet_index() ); // Built from the outlet tree, `root` included.
+    }
         
     rv = outcome::success();
 
@@ -426,12 +537,18 @@ auto EventStore::uninstall_subject( std::string const& heading )
     auto rv = KMAP_MAKE_RESULT( void );
     auto& km = kmap_inst();
     auto const eroot = KTRY( event_root() );
+    auto const subtree = erasable_subtree( anchor::node( eroot )
+                                         | view2::child( "subject" )
+                                         | view2::direct_desc( heading )
+                                         | act2::to_node_set( km ) );
 
     KTRY( view::make( eroot )
         | view::child( "subject" )
         | view::direct_desc( heading )
         | view::erase_node( km ) );
 
+    unindex_erased( subtree );
+
     rv = outcome::success();
 
     return rv;
@@ -446,12 +563,18 @@ auto EventStore::uninstall_subject( Uuid const& node )
     auto rv = KMAP_MAKE_RESULT( void );
     auto& km = kmap_inst();
     auto const eroot = KTRY( event_root() );
+    auto const subtree = erasable_subtree( anchor::node( eroot )
+                                         | view2::child( "subject" )
+                                         | view2::desc( node )
+                                         | act2::to_node_set( km ) );
 
     KTRY( view::make( eroot )
         | view::child( "subject" )
         | view::desc( node )
         | view::erase_node( km ) );
 
+    unindex_erased( subtree );
+
     rv = outcome::success();
 
     return rv;
@@ -466,12 +589,18 @@ auto EventStore::uninstall_verb( std::string const& heading )
     auto rv = KMAP_MAKE_RESULT( void );
     auto& km = kmap_inst();
     auto const eroot = KTRY( event_root() );
+    auto const subtree = erasable_subtree( anchor::node( eroot )
+                                         | view2::child( "verb" )
+                                         | view2::direct_desc( heading )
+                                         | act2::to_node_set( km ) );
 
     KTRY( view::make( eroot )
         | view::child( "verb" )
         | view::direct_desc( heading )
         | view::erase_node( km ) );
 
+    unindex_erased( subtree );
+
     rv = outcome::success();
 
     return rv;
@@ -486,12 +615,18 @@ auto EventStore::uninstall_verb( Uuid const& node )
     auto rv = KMAP_MAKE_RESULT( void );
     auto& km = kmap_inst();
     auto const eroot = KTRY( event_root() );
+    auto const subtree = erasable_subtree( anchor::node( eroot )
+                                         | view2::child( "verb" )
+                                         | view2::desc( node )
+                                         | act2::to_node_set( km ) );
 
     KTRY( view::make( eroot )
         | view::child( "verb" )
         | view::desc( node )
         | view::erase_node( km ) );
 
+    unindex_erased( subtree );
+
     rv = outcome::success();
 
     return rv;
@@ -506,12 +641,18 @@ auto EventStore::uninstall_object( std::string const& heading )
     auto rv = KMAP_MAKE_RESULT( void );
     auto& km = kmap_inst();
     auto const eroot = KTRY( event_root() );
+    auto const subtree = erasable_subtree( anchor::node( eroot )
+                                         | view2::child( "object" )
+                                         | view2::direct_desc( heading )
+                                         | act2::to_node_set( km ) );
 
     KTRY( view::make( eroot )
         | view::child( "object" )
         | view::direct_desc( heading )
         | view::erase_node( km ) );
 
+    unindex_erased( subtree );
+
     rv = outcome::success();
 
     return rv;
@@ -526,12 +667,18 @@ auto EventStore::uninstall_object( Uuid const& node )
     auto rv = KMAP_MAKE_RESULT( void );
     auto& km = kmap_inst();
     auto const eroot = KTRY( event_root() );
+    auto const subtree = erasable_subtree( anchor::node( eroot )
+                                         | view2::child( "object" )
+                                         | view2::desc( node )
+                                         | act2::to_node_set( km ) );
 
     KTRY( view::make( eroot )
         | view::child( "object" )
         | view::desc( node )
         | view::erase_node( km ) );
 
+    unindex_erased( subtree );
+
     rv = outcome::success();
 
     return rv;
@@ -546,12 +693,18 @@ auto EventStore::uninstall_component( Uuid const& node )
     auto rv = KMAP_MAKE_RESULT( void );
     auto& km = kmap_inst();
     auto const eroot = KTRY( event_root() );
+    auto const subtree = erasable_subtree( anchor::node( eroot )
+                                         | view2::child( "component" )
+                                         | view2::desc( node )
+                                         | act2::to_node_set( km ) );
 
     KTRY( view::make( eroot )
         | view::child( "component" )
         | view::desc( node )
         | view::erase_node( km ) );
 
+    unindex_erased( subtree );
+
     rv = outcome::success();
 
     return rv;
@@ -566,12 +719,18 @@ auto EventStore::uninstall_outlet( std::string const& heading )
     auto rv = KMAP_MAKE_RESULT( void );
     auto& km = kmap_inst();
     auto const eroot = KTRY( event_root() );
+    auto const subtree = erasable_subtree( anchor::node( eroot )
+                                         | view2::child( "outlet" )
+                                         | view2::direct_desc( heading )
+                                         | act2::to_node_set( km ) );
 
     KTRY( view::make( eroot )
         | view::child( "outlet" )
         | view::direct_desc( heading )
         | view::erase_node( km ) );
 
+    unindex_erased( subtree );
+
     rv = outcome::success();
 
     return rv;
@@ -586,9 +745,12 @@ auto EventStore::uninstall_outlet( Uuid const& node )
     auto rv = KMAP_MAKE_RESULT( void );
     auto& km = kmap_inst();
     auto const nw = KTRY( km.fetch_component< com::Network >() );
+    auto const subtree = erasable_subtree( UuidSet{ node } );
 
     KTRY( nw->erase_node( node ) );
 
+    unindex_erased( subtree );
+
     rv = outcome::success();
 
     return rv;
@@ -602,14 +764,108 @@ auto EventStore::uninstall_outlet_transition( Uuid const& node )
 
     auto rv = KMAP_MAKE_RESULT( void );
     auto const nw = KTRY( fetch_component< com::Network >() );
+    auto const subtree = erasable_subtree( UuidSet{ node } );
 
     KTRY( nw->erase_node( node ) );
 
+    unindex_erased( subtree );
+
     rv = outcome::success();
 
     return rv;
 }
 
+auto EventStore::unindex_outlet( Uuid const& outlet )
+    -> void
+{
+    BC_CONTRACT()
+        BC_PRE([ & ]
+        {
+            BC_ASSERT( outlet_index_.has_value() );
+        })
+    ;
+
+    auto& index = outlet_index_.value();
+
+    if( auto const it = index.requisites.find( outlet )
+      ; it != index.requisites.end() )
+    {
+        for( auto const& req : it->second )
+        {
+            if( auto const oit = index.outlets.find( req )
+              ; oit != index.outlets.end() )
+            {
+                oit->second.erase( outlet );
+
+                if( oit->second.empty() )
+                {
+                    index.outlets.erase( oit );
+                }
+            }
+        }
+
+        index.requisites.erase( it );
+    }
+}
+
+auto EventStore::erasable_subtree( UuidSet const& roots )
+    -> UuidSet
+{
+    auto rv = UuidSet{};
+
+    if( outlet_index_ && !roots.empty() )
+    {
+        auto const& km = kmap_inst();
+
+        rv = anchor::node( roots )
+           | view2::desc
+           | act2::to_node_set( km );
+
+        rv.insert( roots.begin(), roots.end() );
+    }
+
+    return rv;
+}
+
+auto EventStore::unindex_erased( UuidSet const& nodes )
+    -> void
+{
+    if( !outlet_index_ )
+    {
+        return;
+    }
+
+    auto const& km = kmap_inst();
+    auto const nw = km.component_slot< com::Network >();
+    auto& index = outlet_index_.value();
+
+    for( auto const& node : nodes )
+    {
+        if( nw && nw->exists( node ) )
+        {
+            continue; // Not erased after all.
+        }
+
+        unindex_outlet( node );
+
+        // An erased requisite takes its aliases, under each outlet's "requisite", with it.
+        if( auto const it = index.outlets.find( node )
+          ; it != index.outlets.end() )
+        {
+            for( auto const& outlet : it->second )
+            {
+                if( auto const rit = index.requisites.find( outlet )
+                  ; rit != index.requisites.end() )
+                {
+                    rit->second.erase( node );
+                }
+            }
+
+            index.outlets.erase( it );
+        }
+    }
+}
+
 auto EventStore::execute_body( Uuid const& node )
     -> Result< void >
 {    
@@ -622,41 +878,37 @@ auto EventStore::execute_body( Uuid const& node )
     KMAP_ENSURE( nw->exists( node ), error_code::network::invalid_node );
 
     auto const body = KTRY( nw->fetch_body( node ) );
-    auto const code = KTRY( cmd::parser::parse_body_code( body ) );
-    auto const vres = boost::apply_visitor( [ & ]( auto const& e ) -> Result< void >
-                                          {
-                                              using T = std::decay_t< decltype( e ) >;
-
-                                              auto rv = KMAP_MAKE_RESULT( void );
-
-                                              if constexpr( std::is_same_v< T, cmd::ast::Kscript > )
-                                              {
-                                                  KMAP_THROW_EXCEPTION_MSG( "TODO: Impl. needed" );
-                                                  // rv = execute_kscript( kmap, e.code );
-                                              }
-                                              else if constexpr( std::is_same_v< T, cmd::ast::Javascript > )
-                                              {
-                                                  #if !KMAP_NATIVE
-                                                  auto const pp = KTRYE( js::preprocess( e.code ) );
-
-                                                  KTRY( js::eval_void( pp ) );
-                                                  #endif // !KMAP_NATIVE
-                                              }
-                                              else
-                                              {
-                                                  static_assert( always_false< T >::value, "non-exhaustive visitor!" );
-                                              }
-
-                                              rv = outcome::success();
-
-                                              return rv;
-                                          }
-                                          , code );
-
-    if( !vres )
+
+#if !KMAP_NATIVE
+    auto const compile = [ & ]( std::string const& source ) -> Result< emscripten::val >
     {
-        return KMAP_PROPAGATE_FAILURE( vres );
-    }
+        auto const code = KTRY( cmd::parser::parse_body_code( source ) );
+
+        return boost::apply_visitor( [ & ]( auto const& e ) -> Result< emscripten::val >
+                                     {
+                                         using T = std::decay_t< decltype( e ) >;
+
+                                         if constexpr( std::is_same_v< T, cmd::ast::Kscript > )
+                                         {
+                                             KMAP_THROW_EXCEPTION_MSG( "TODO: Impl. needed" );
+                                         }
+                                         else if constexpr( std::is_same_v< T, cmd::ast::Javascript > )
+                                         {
+                                             auto const pp = KTRY( js::preprocess( e.code ) );
+
+                                             return js::compile_void( {}, pp );
+                                         }
+                                         else
+                                         {
+                                             static_assert( always_false< T >::value, "non-exhaustive visitor!" );
+                                         }
+                                     }
+                                   , code );
+    };
+    auto const fn = KTRY( action_cache_.fetch_or_compile( node, body, compile ) );
+
+    KTRY( js::call_void( fn ) );
+#endif // !KMAP_NATIVE
 
     rv = outcome::success();
     
@@ -671,16 +923,23 @@ auto EventStore::fetch_matching_outlets( std::set< std::string > const& requisit
 
     auto rv = KMAP_MAKE_RESULT( UuidSet );
     auto const& km = kmap_inst();
-    auto const nw = KTRYE( fetch_component< com::Network >() );
     auto const rreqs = view2::event::event_root
                      | view2::all_of( view2::direct_desc, requisites )
                      | act2::to_node_set( km );
-    auto const outlets = view2::event::outlet_root
-                       | view2::desc( view2::child( "requisite" )
-                                    | view2::exactly( view2::alias_src, rreqs ) )
-                       | act2::to_node_set( km );
 
-    rv = outlets;
+    if( rreqs.size() == requisites.size() )
+    {
+        auto const matches = KTRY( match_outlets( rreqs ) );
+
+        // Exact match: no requisites beyond those given.
+        rv = matches
+           | rvs::filter( [ & ]( auto const& e ){ return outlet_index_->requisites.at( e ).size() == rreqs.size(); } )
+           | ranges::to< UuidSet >();
+    }
+    else
+    {
+        rv = UuidSet{};
+    }
 
     return rv;
 }
@@ -711,8 +970,114 @@ SCENARIO( "EventStore::fetch_matching_outlets", "[event]" )
                 REQUIRE( !mos.empty() );
                 REQUIRE( *mos.begin() == ores.value() );
             }
+            WHEN( "outlet uninstalled" )
+            {
+                REQUIRE_RES( estore->uninstall_outlet( ores.value() ) );
+
+                THEN( "no matching outlet found" )
+                {
+                    REQUIRE( REQUIRE_TRY( estore->fetch_matching_outlets( { "subject.victor" } ) ).empty() );
+                }
+            }
+            GIVEN( "outlet with an additional requisite" )
+            {
+                REQUIRE_RES( estore->install_verb( "charlie" ) );
+
+                auto const ores2 = estore->install_outlet( Leaf{ .heading = "2"
+                                                               , .requisites = { "subject.victor", "verb.charlie" }
+                                                               , .description = "test"
+                                                               , .action = "/*NOP*/" } );
+                REQUIRE_RES( ores2 );
+
+                THEN( "each matches only its exact requisites" )
+                {
+                    REQUIRE( REQUIRE_TRY( estore->fetch_matching_outlets( { "subject.victor" } ) ) == UuidSet{ ores.value() } );
+                    REQUIRE( REQUIRE_TRY( estore->fetch_matching_outlets( { "subject.victor", "verb.charlie" } ) ) == UuidSet{ ores2.value() } );
+                }
+                WHEN( "the first outlet is uninstalled" )
+                {
+                    REQUIRE_RES( estore->uninstall_outlet( ores.value() ) );
+
+                    THEN( "only it is dropped" )
+                    {
+                        REQUIRE( REQUIRE_TRY( estore->fetch_matching_outlets( { "subject.victor" } ) ).empty() );
+                        REQUIRE( REQUIRE_TRY( estore->fetch_matching_outlets( { "subject.victor", "verb.charlie" } ) ) == UuidSet{ ores2.value() } );
+                    }
+                }
+                WHEN( "the additional requisite is uninstalled" )
+                {
+                    REQUIRE_RES( estore->uninstall_verb( "charlie" ) );
+
+                    THEN( "it's dropped from the outlet requiring it" )
+                    {
+                        REQUIRE( REQUIRE_TRY( estore->fetch_matching_outlets( { "subject.victor" } ) ) == UuidSet{ ores.value(), ores2.value() } );
+                    }
+                }
+            }
+        }
+    }
+}
+
+auto EventStore::match_outlets( UuidSet const& requisites )
+    -> Result< UuidSet >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = KMAP_MAKE_RESULT( UuidSet );
+
+    KTRY( ensure_outlet_index() );
+
+    auto const nw = KTRY( fetch_component< com::Network >() );
+    auto& index = outlet_index_.value();
+    auto matches = UuidSet{};
+
+    // Intersect, starting from the requisite with the fewest outlets.
+    auto rarest = std::optional< UuidSet const* >{};
+
+    for( auto const& req : requisites )
+    {
+        if( auto const it = index.outlets.find( req )
+          ; it != index.outlets.end() )
+        {
+            if( !rarest || it->second.size() < rarest.value()->size() )
+            {
+                rarest = &it->second;
+            }
+        }
+        else
+        {
+            rarest = std::nullopt;
+
+            break;
+        }
+    }
+
+    if( rarest )
+    {
+        for( auto const& outlet : *rarest.value() )
+        {
+            auto const& oreqs = index.requisites.at( outlet );
+
+            if( std::includes( oreqs.begin(), oreqs.end(), requisites.begin(), requisites.end() ) )
+            {
+                matches.emplace( outlet );
+            }
+        }
+    }
+
+    // Outlets erased other than through uninstall_outlet() are dropped as found.
+    for( auto const& outlet : UuidSet{ matches } )
+    {
+        if( !nw->exists( outlet ) )
+        {
+            unindex_outlet( outlet );
+            matches.erase( outlet );
         }
     }
+
+    rv = matches;
+
+    return rv;
 }
 
 // TODO: If the requested subject, verb, or object is missing, don't err, it just means one hasn't been installed yet, so there'll be nothing to match against.
@@ -805,16 +1170,27 @@ auto EventStore::fire_event_internal( std::set< std::string > const& requisites
     auto rv = KMAP_MAKE_RESULT( void );
     auto& km = kmap_inst();
     auto const nw = KTRY( fetch_component< com::Network >() );
-    auto const vreqs = view2::event::event_root | view2::all_of( view2::direct_desc, requisites );
+    auto const req_srcs = view2::event::event_root
+                        | view2::all_of( view2::direct_desc, requisites )
+                        | act2::to_node_set( km );
+    auto const all_matches = KTRY( [ & ]() -> Result< UuidVec >
+    {
+        if( req_srcs.size() != requisites.size() ) // A requisite not installed can't be matched.
+        {
+            return UuidVec{};
+        }
+        else if( auto const matches = KTRY( match_outlets( req_srcs ) )
+               ; matches.empty() )
+        {
+            return UuidVec{};
+        }
+        else
+        {
+            return path::order( km, matches );
+        }
+    }() );
     auto const outlets = [ & ]
     {
-        auto const all_matches = view2::event::outlet_root
-                               | view2::desc( "requisite" )
-                               | view2::all_of( view2::alias, ( vreqs | act2::to_heading_set( km ) ) ) // TODO: Actually needs view::all_of( view::alias( view::resolve ), vreqs ), rather than just the heading matches.
-                               | view2::parent
-                               | view2::parent
-                               | view2::order
-                               | act2::to_node_vec( km );
         auto final_matches = decltype( all_matches ){};
 
         // Ensure all req coms have been initialized.
@@ -930,6 +1306,30 @@ SCENARIO( "EventStore::fire_event", "[event][benchmark]" )
             return estore->fire_event( {  "subject.victor", "verb.charlie", "object.delta" } );
         };
     }
+    GIVEN( "one matching outlet among many" )
+    {
+        REQUIRE_RES( estore->install_subject( "victor" ) );
+        REQUIRE_RES( estore->install_verb( "charlie" ) );
+
+        for( auto i = 0
+           ; i < 100
+           ; ++i )
+        {
+            auto const object = fmt::format( "o{}", i );
+
+            REQUIRE_RES( estore->install_object( object ) );
+            REQUIRE_RES( estore->install_outlet( Leaf{ .heading = fmt::format( "{}", i )
+                                                     , .requisites = { "subject.victor", "verb.charlie", fmt::format( "object.{}", object ) }
+                                                     , .description = "keypress latency"
+                                                     , .action = "/*NOP*/" } ) );
+        }
+
+        // Keypress to action: matching is by the requisite index, rather than a query over the outlet tree.
+        BENCHMARK( "fire_event: 1 of 100 outlets" )
+        {
+            return estore->fire_event( { "subject.victor", "verb.charlie", "object.o50" } );
+        };
+    }
     GIVEN( "two level outlet with identical requisites" )
     {
         REQUIRE_RES( estore->install_subject( "victor" ) );
@@ -1394,7 +1794,7 @@ using namespace std::string_literals;
 REGISTER_COMPONENT
 (
     kmap::com::EventStore
-,   std::set({ "command.store"s, "root_node"s })
+,   std::set({ "command.store"s, "database"s, "root_node"s })
 ,   "event related functionality"
 );
 
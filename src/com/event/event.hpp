@@ -11,8 +11,13 @@
 #include "component.hpp"
 #include "path/node_view2.hpp"
 
+#if !KMAP_NATIVE
+#include "js/function_cache.hpp"
+#endif // !KMAP_NATIVE
+
 #include <boost/json/object.hpp>
 
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
@@ -60,13 +65,26 @@ private:
     // Only the active state gets acted upon.
     TransitionMap transition_states_;
     std::optional< Payload > payload_ = std::nullopt;
+    // Inverted index from requisite (e.g., the node at "subject.victor") to the outlets requiring it, along with its converse.
+    // Matching an event thereby becomes a set intersection, rather than a query over the whole outlet tree.
+    // Built on first use or outlet install; kept current by install_outlet_internal() and, for just what they erase, by uninstall_*().
+    struct OutletIndex
+    {
+        std::map< Uuid, UuidSet > outlets = {}; // requisite => outlets
+        std::map< Uuid, UuidSet > requisites = {}; // outlet => requisites
+    };
+    std::optional< OutletIndex > outlet_index_ = std::nullopt;
+#if !KMAP_NATIVE
+    js::FunctionCache action_cache_ = {}; // Keyed by action node.
+    Optional< com::db::ChangeFeed::SubscriberId > action_cache_subscription_ = {}; // Drops entries of erased or re-bodied action nodes.
+#endif // !KMAP_NATIVE
 
 public:
     static constexpr auto id = "event_store";
     constexpr auto name() const -> std::string_view override { return id; }
 
     using Component::Component;
-    virtual ~EventStore() = default;
+    virtual ~EventStore();
 
     auto initialize()
         -> Result< void > override;
@@ -152,14 +170,35 @@ public:
         -> Result< void >;
 
 protected:
+    auto ensure_outlet_index()
+        -> Result< void >;
+    /**
+     * @brief Returns `roots` and their descendants, ahead of erasing `roots`, for unindex_erased(). Empty while there's no index to maintain.
+     */
+    auto erasable_subtree( UuidSet const& roots )
+        -> UuidSet;
     auto fire_event_internal( std::set< std::string > const& requisites )
         -> Result< void >;
+    auto index_outlet( Uuid const& outlet )
+        -> Result< void >;
     auto install_outlet_internal( Uuid const& root 
                                 , Leaf const& leaf )
         -> Result< void >;
     auto install_outlet_internal( Uuid const& root 
                                 , Branch const& leaf )
         -> Result< void >;
+    /**
+     * @brief Outlets whose requisites include all of `requisites`.
+     */
+    auto match_outlets( UuidSet const& requisites )
+        -> Result< UuidSet >;
+    /**
+     * @brief Drops from the index those of `nodes` since erased: as outlets, and as requisites of the outlets remaining.
+     */
+    auto unindex_erased( UuidSet const& nodes )
+        -> void;
+    auto unindex_outlet( Uuid const& outlet )
+        -> void;
 };
 
 namespace event
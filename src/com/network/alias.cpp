@@ -155,12 +155,20 @@ auto AliasStore::erase_alias( Uuid const& id )
 
     if( 1 == av.erase( id ) )
     {
+        pending_.erase( id );
+
         rv = outcome::success();
     }
 
     return rv;
 }
 
+auto AliasStore::erase_pending( Uuid const& id )
+    -> void
+{
+    pending_.erase( id );
+}
+
 // auto AliasStore::erase_alias_child( Uuid const& parent )
 //     -> Result< void >
 // {
@@ -617,6 +625,8 @@ auto AliasStore::push_alias( AliasItem const& item )
     KMAP_ENSURE( alias_set_.emplace( item ).second, error_code::network::invalid_node );
     // KMAP_ENSURE( alias_child_set_.emplace( AliasChildItem{ AliasChildItem::parent_type{ dst }, AliasChildItem::child_type{ alias_id } } ).second, error_code::network::invalid_node );
 
+    pending_.emplace( item.alias() );
+
     rv = item.alias();
 
     return rv;
@@ -652,6 +662,12 @@ auto AliasStore::is_alias( Uuid const& src
     return is_alias( make_alias_id( src, dst ) );
 }
 
+auto AliasStore::is_pending( Uuid const& id ) const
+    -> bool
+{
+    return pending_.contains( id );
+}
+
 auto AliasStore::resolve( Uuid const& id ) const
     -> Uuid
 {
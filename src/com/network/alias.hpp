@@ -14,7 +14,6 @@
 #include <boost/multi_index/identity.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/uuid/uuid_hash.hpp>
 
@@ -61,15 +60,6 @@ struct AliasItem
     std::strong_ordering operator<=>( AliasItem const& ) const = default;
 };
 
-struct AliasLoadItem : public AliasItem
-{
-    using loaded_type = bool;
-
-    loaded_type loaded_flag = false;
-
-    auto loaded() const{ return loaded_flag; }
-};
-
 [[ nodiscard ]]
 auto make_alias_item( Uuid const& top
                     , Uuid const& src
@@ -103,40 +93,13 @@ using AliasSet = boost::multi_index_container< AliasItem
                                                                                                           , AliasItem::top_type
                                                                                                           , &AliasItem::top >
                                                                                       , boost::hash< AliasItem::top_type > > > >;
-using AliasLoadSet = boost::multi_index_container< AliasLoadItem
-                                                 , bmi::indexed_by< bmi::hashed_unique< bmi::tag< AliasItem::alias_type >
-                                                                                      , bmi::const_mem_fun< AliasItem
-                                                                                                          , AliasItem::alias_type
-                                                                                                          , &AliasItem::alias >
-                                                                                      , boost::hash< AliasItem::alias_type > >
-                                                                  , bmi::hashed_non_unique< bmi::tag< AliasItem::src_type >
-                                                                                          , bmi::const_mem_fun< AliasItem
-                                                                                                              , AliasItem::src_type
-                                                                                                              , &AliasItem::src >
-                                                                                          , boost::hash< AliasItem::src_type > >
-                                                                  , bmi::hashed_non_unique< bmi::tag< AliasItem::rsrc_type >
-                                                                                          , bmi::const_mem_fun< AliasItem
-                                                                                                              , AliasItem::rsrc_type
-                                                                                                              , &AliasItem::rsrc >
-                                                                                          , boost::hash< AliasItem::rsrc_type > >
-                                                                  , bmi::hashed_non_unique< bmi::tag< AliasItem::dst_type >
-                                                                                          , bmi::const_mem_fun< AliasItem
-                                                                                                              , AliasItem::dst_type
-                                                                                                              , &AliasItem::dst >
-                                                                                          , boost::hash< AliasItem::dst_type > >
-                                                                  , bmi::hashed_non_unique< bmi::tag< AliasItem::top_type >
-                                                                                          , bmi::const_mem_fun< AliasItem
-                                                                                                              , AliasItem::top_type
-                                                                                                              , &AliasItem::top >
-                                                                                          , boost::hash< AliasItem::top_type > >
-                                                                  , bmi::ordered_non_unique< bmi::tag< AliasLoadItem::loaded_type >
-                                                                                           , bmi::const_mem_fun< AliasLoadItem
-                                                                                                               , AliasLoadItem::loaded_type
-                                                                                                               , &AliasLoadItem::loaded > > > >;
-
+/**
+ * @note An alias' children are materialized on expansion, rather than on push, so each pushed alias is pending until expanded (see Network::expand_alias).
+ */
 class AliasStore
 {
     AliasSet alias_set_ = {};
+    UuidSet pending_ = {};
 
 public:
     AliasStore() = default;
@@ -144,6 +107,8 @@ public:
     // Core
     auto erase_alias( Uuid const& id )
         -> Result< void >;
+    auto erase_pending( Uuid const& id )
+        -> void;
     [[ nodiscard ]]
     auto is_alias( Uuid const& id ) const
         -> bool;
@@ -177,6 +142,9 @@ public:
     [[ nodiscard ]]
     auto has_alias( Uuid const& node ) const
         -> bool;
+    [[ nodiscard ]]
+    auto is_pending( Uuid const& id ) const
+        -> bool;
     auto push_alias( AliasItem const& item )
         -> Result< Uuid >;
     [[ nodiscard ]]
@@ -0,0 +1,295 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#include "com/network/ancestry.hpp"
+
+#include "contract.hpp"
+#include "error/network.hpp"
+#include "test/util.hpp"
+#include "utility.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <map>
+
+namespace kmap::com {
+
+auto AncestryIndex::clear()
+    -> void
+{
+    entries_.clear();
+}
+
+auto AncestryIndex::depth( Uuid const& node
+                         , FetchParentFn const& fetch_parent )
+    -> std::uint32_t
+{
+    return fetch_entry( node, fetch_parent ).depth;
+}
+
+auto AncestryIndex::erase( Uuid const& node )
+    -> void
+{
+    entries_.erase( node );
+}
+
+auto AncestryIndex::fetch_ancestor( Uuid const& node
+                                  , std::uint32_t const distance
+                                  , FetchParentFn const& fetch_parent )
+    -> Result< Uuid >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_NODE( "node", node );
+
+    auto rv = result::make_result< Uuid >();
+
+    KMAP_ENSURE( distance <= fetch_entry( node, fetch_parent ).depth, error_code::network::invalid_lineage );
+
+    auto ancestor = node;
+
+    // Every ancestor was indexed in fetching `node`'s entry, so lookup() suffices.
+    for( auto i = std::size_t{ 0 }
+       ; ( distance >> i ) != 0
+       ; ++i )
+    {
+        if( ( ( distance >> i ) & 1 ) != 0 )
+        {
+            ancestor = lookup( ancestor ).jumps.at( i );
+        }
+    }
+
+    rv = ancestor;
+
+    return rv;
+}
+
+auto AncestryIndex::fetch_entry( Uuid const& node
+                               , FetchParentFn const& fetch_parent )
+    -> Entry const&
+{
+    if( auto const it = entries_.find( node )
+      ; it != entries_.end() )
+    {
+        return it->second;
+    }
+
+    // Walk up to the nearest indexed or parentless ancestor, then index back down from it.
+    auto lineage = std::vector< std::pair< Uuid, Optional< Uuid > > >{};
+
+    for( auto next = Optional< Uuid >{ node }
+       ; next
+       ; )
+    {
+        auto const parent = to_optional( fetch_parent( next.value() ) );
+
+        lineage.emplace_back( next.value(), parent );
+
+        if( parent && !entries_.contains( parent.value() ) )
+        {
+            next = parent;
+        }
+        else
+        {
+            next = boost::none;
+        }
+    }
+
+    for( auto it = lineage.rbegin()
+       ; it != lineage.rend()
+       ; ++it )
+    {
+        auto const& [ n, parent ] = *it;
+
+        if( !parent )
+        {
+            continue;
+        }
+
+        auto entry = Entry{ .depth = lookup( parent.value() ).depth + 1
+                          , .jumps = { parent.value() } };
+
+        for( auto i = std::size_t{ 1 }
+           ;
+           ; ++i )
+        {
+            auto const& jumped = lookup( entry.jumps[ i - 1 ] );
+
+            if( jumped.jumps.size() < i )
+            {
+                break;
+            }
+
+            entry.jumps.emplace_back( jumped.jumps[ i - 1 ] );
+        }
+
+        entries_.insert_or_assign( n, std::move( entry ) );
+    }
+
+    return lookup( node );
+}
+
+auto AncestryIndex::is_lineal( Uuid const& ancestor
+                             , Uuid const& descendant
+                             , FetchParentFn const& fetch_parent )
+    -> bool
+{
+    if( ancestor == descendant )
+    {
+        return true;
+    }
+
+    auto const ddepth = depth( descendant, fetch_parent );
+    auto const adepth = depth( ancestor, fetch_parent );
+
+    if( adepth >= ddepth )
+    {
+        return false;
+    }
+    else
+    {
+        auto const found = fetch_ancestor( descendant, ddepth - adepth, fetch_parent );
+
+        return found && found.value() == ancestor;
+    }
+}
+
+auto AncestryIndex::lineage( Uuid const& node
+                            , Uuid const& ancestor ) const
+    -> UuidVec
+{
+    auto rv = UuidVec{};
+
+    for( auto next = node
+       ; next != ancestor
+       ; )
+    {
+        auto const& entry = lookup( next );
+
+        if( entry.jumps.empty() )
+        {
+            break;
+        }
+
+        rv.emplace_back( next );
+
+        next = entry.jumps.front();
+    }
+
+    return rv;
+}
+
+auto AncestryIndex::lookup( Uuid const& node ) const
+    -> Entry const&
+{
+    static auto const parentless = Entry{};
+
+    if( auto const it = entries_.find( node )
+      ; it != entries_.end() )
+    {
+        return it->second;
+    }
+    else
+    {
+        return parentless;
+    }
+}
+
+auto AncestryIndex::size() const
+    -> std::size_t
+{
+    return entries_.size();
+}
+
+SCENARIO( "AncestryIndex answers lineage from jump pointers", "[network][ancestry]" )
+{
+    auto index = AncestryIndex{};
+    auto parents = std::map< Uuid, Uuid >{};
+    auto fetched = 0;
+    auto const fetch_parent = [ & ]( Uuid const& node ) -> Result< Uuid >
+    {
+        KM_RESULT_PROLOG();
+
+        auto rv = result::make_result< Uuid >();
+
+        ++fetched;
+
+        if( auto const it = parents.find( node )
+          ; it != parents.end() )
+        {
+            rv = it->second;
+        }
+
+        return rv;
+    };
+    auto const root = gen_uuid();
+    auto chain = UuidVec{ root };
+
+    for( auto i = 0; i < 10; ++i )
+    {
+        auto const child = gen_uuid();
+
+        parents.emplace( child, chain.back() );
+        chain.emplace_back( child );
+    }
+
+    GIVEN( "chain of 11" )
+    {
+        auto const leaf = chain.back();
+
+        THEN( "depths are indexed in one walk" )
+        {
+            REQUIRE( index.depth( leaf, fetch_parent ) == 10 );
+            REQUIRE( fetched == 11 );
+            REQUIRE( index.depth( chain.at( 5 ), fetch_parent ) == 5 );
+            REQUIRE( fetched == 11 );
+        }
+        THEN( "ancestors are found at each distance" )
+        {
+            for( auto d = std::uint32_t{ 0 }; d <= 10; ++d )
+            {
+                REQUIRE( REQUIRE_TRY( index.fetch_ancestor( leaf, d, fetch_parent ) ) == chain.at( 10 - d ) );
+            }
+
+            REQUIRE( !index.fetch_ancestor( leaf, 11, fetch_parent ) );
+        }
+        THEN( "lineage is determined" )
+        {
+            REQUIRE( index.is_lineal( root, leaf, fetch_parent ) );
+            REQUIRE( index.is_lineal( chain.at( 3 ), chain.at( 7 ), fetch_parent ) );
+            REQUIRE( index.is_lineal( leaf, leaf, fetch_parent ) );
+            REQUIRE( !index.is_lineal( leaf, root, fetch_parent ) );
+            REQUIRE( !index.is_lineal( gen_uuid(), leaf, fetch_parent ) );
+        }
+        THEN( "lineage lists the nodes walked" )
+        {
+            REQUIRE( index.depth( leaf, fetch_parent ) == 10 );
+
+            REQUIRE( index.lineage( leaf, chain.at( 7 ) ) == UuidVec{ chain.at( 10 ), chain.at( 9 ), chain.at( 8 ) } );
+            REQUIRE( index.lineage( leaf, leaf ).empty() );
+            REQUIRE( index.lineage( leaf, gen_uuid() ).size() == 10 );
+            REQUIRE( index.lineage( root, leaf ).empty() );
+        }
+
+        WHEN( "branch is added" )
+        {
+            REQUIRE( index.depth( leaf, fetch_parent ) == 10 );
+
+            auto const branch = gen_uuid();
+
+            parents.emplace( branch, chain.at( 4 ) );
+            fetched = 0;
+
+            THEN( "branch is indexed from its parent" )
+            {
+                REQUIRE( index.depth( branch, fetch_parent ) == 5 );
+                REQUIRE( fetched == 1 );
+                REQUIRE( index.is_lineal( chain.at( 4 ), branch, fetch_parent ) );
+                REQUIRE( !index.is_lineal( chain.at( 5 ), branch, fetch_parent ) );
+            }
+        }
+    }
+}
+
+} // namespace kmap::com
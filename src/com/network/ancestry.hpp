@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#pragma once
+#ifndef KMAP_NETWORK_ANCESTRY_HPP
+#define KMAP_NETWORK_ANCESTRY_HPP
+
+#include "common.hpp"
+#include "util/result.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+namespace kmap::com {
+
+/**
+ * @brief Depth and jump pointers (the 2^i-th ancestor, for each i) per node, so that lineage checks take O(log depth) lookups rather than a parent-by-parent walk.
+ * @note Entries are filled lazily, from `fetch_parent`, and a new node is indexed from its parent's entry. Parentless nodes (e.g., root, attribute nodes) aren't stored.
+ *       Erasing a node requires erase() of it (its descendants having been erased first); moving a node invalidates its whole subtree, so requires clear().
+ */
+class AncestryIndex
+{
+public:
+    using FetchParentFn = std::function< Result< Uuid >( Uuid const& ) >;
+
+    struct Entry
+    {
+        std::uint32_t depth = 0;
+        UuidVec jumps = {}; // jumps[ i ] is the 2^i-th ancestor.
+    };
+
+private:
+    std::unordered_map< Uuid, Entry, boost::hash< Uuid > > entries_ = {};
+
+public:
+    auto clear()
+        -> void;
+    auto depth( Uuid const& node
+              , FetchParentFn const& fetch_parent )
+        -> std::uint32_t;
+    auto erase( Uuid const& node )
+        -> void;
+    /**
+     * @brief Returns the ancestor `distance` generations above `node`.
+     */
+    auto fetch_ancestor( Uuid const& node
+                       , std::uint32_t const distance
+                       , FetchParentFn const& fetch_parent )
+        -> Result< Uuid >;
+    auto is_lineal( Uuid const& ancestor
+                  , Uuid const& descendant
+                  , FetchParentFn const& fetch_parent )
+        -> bool;
+    /**
+     * @brief Returns `node` and its indexed ancestors, nearest first, stopping short of `ancestor` or at the topmost with a parent.
+     * @note These are the nodes whose parents a walk from `node` to `ancestor` would fetch. Reads the index alone, so is only complete once `node`'s entry is.
+     */
+    auto lineage( Uuid const& node
+                , Uuid const& ancestor ) const
+        -> UuidVec;
+    auto size() const
+        -> std::size_t;
+
+protected:
+    auto fetch_entry( Uuid const& node
+                    , FetchParentFn const& fetch_parent )
+        -> Entry const&;
+    auto lookup( Uuid const& node ) const
+        -> Entry const&;
+};
+
+} // namespace kmap::com
+
+#endif // KMAP_NETWORK_ANCESTRY_HPP
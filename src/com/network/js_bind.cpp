@@ -49,6 +49,21 @@ struct Network
 
         return nw->create_child( parent, format_heading( title ), title );
     }
+    /**
+     * @brief Creates the nodes of an indented outline, one title per line, below `parent`, in a single pass.
+     */
+    auto create_subtree( Uuid const& parent
+                       , std::string const& outline )
+        -> Result< UuidVec >
+    {
+        KM_RESULT_PROLOG();
+            KM_RESULT_PUSH( "parent", parent );
+
+        auto const nw = KTRY( kmap_.fetch_component< com::Network >() );
+        auto const specs = KTRY( parse_outline( outline ) );
+
+        return nw->create_subtree( parent, specs );
+    }
     auto erase_node( Uuid const& node )
         -> Result< Uuid >
     {
@@ -306,6 +321,7 @@ EMSCRIPTEN_BINDINGS( kmap_network )
     class_< kmap::com::binding::Network >( "Network" )
         .function( "create_alias", &kmap::com::binding::Network::create_alias )
         .function( "create_child", &kmap::com::binding::Network::create_child )
+        .function( "create_subtree", &kmap::com::binding::Network::create_subtree )
         .function( "erase_node", &kmap::com::binding::Network::erase_node )
         .function( "fetch_body", &kmap::com::binding::Network::fetch_body )
         .function( "fetch_node", &kmap::com::binding::Network::fetch_node )
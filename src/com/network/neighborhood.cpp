@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#include "com/network/neighborhood.hpp"
+
+#include "contract.hpp"
+#include "test/util.hpp"
+#include "utility.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <map>
+
+namespace kmap::com {
+
+auto NeighborhoodCache::clear()
+    -> void
+{
+    entries_.clear();
+}
+
+auto NeighborhoodCache::fetch( Uuid const& parent
+                             , std::uint64_t const generation
+                             , FetchChildrenFn const& fetch_children )
+    -> Result< std::reference_wrapper< Entry const > >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_NODE( "parent", parent );
+
+    auto rv = result::make_result< std::reference_wrapper< Entry const > >();
+
+    if( generation != generation_ )
+    {
+        entries_.clear();
+
+        generation_ = generation;
+    }
+
+    if( auto const it = entries_.find( parent )
+      ; it != entries_.end() )
+    {
+        rv = std::cref( it->second );
+    }
+    else
+    {
+        auto entry = Entry{ .children = KTRY( fetch_children( parent ) ) };
+
+        for( auto i = std::size_t{ 0 }
+           ; i < entry.children.size()
+           ; ++i )
+        {
+            entry.positions.emplace( entry.children[ i ], i );
+        }
+
+        rv = std::cref( entries_.emplace( parent, std::move( entry ) ).first->second );
+    }
+
+    return rv;
+}
+
+auto NeighborhoodCache::size() const
+    -> std::size_t
+{
+    return entries_.size();
+}
+
+auto select_window( UuidVec const& range
+                  , std::size_t const median
+                  , std::size_t const radius )
+    -> UuidVec
+{
+    auto const first = median < radius ? 0 : median - radius;
+    auto const last = std::min( range.size(), median + radius );
+
+    if( first >= last )
+    {
+        return {};
+    }
+
+    return UuidVec{ range.begin() + first, range.begin() + last };
+}
+
+SCENARIO( "NeighborhoodCache holds children for a generation", "[network][neighborhood]" )
+{
+    auto cache = NeighborhoodCache{};
+    auto children = std::map< Uuid, UuidVec >{};
+    auto fetched = 0;
+    auto const fetch_children = [ & ]( Uuid const& parent ) -> Result< UuidVec >
+    {
+        ++fetched;
+
+        return children[ parent ];
+    };
+    auto const p1 = gen_uuid();
+    auto const p2 = gen_uuid();
+    auto const c1 = gen_uuid();
+    auto const c2 = gen_uuid();
+    auto const c3 = gen_uuid();
+
+    children[ p1 ] = { c1, c2, c3 };
+    children[ p2 ] = { c3 };
+
+    GIVEN( "fetched parent" )
+    {
+        auto const& entry = REQUIRE_TRY( cache.fetch( p1, 1, fetch_children ) ).get();
+
+        REQUIRE( entry.children == UuidVec{ c1, c2, c3 } );
+        REQUIRE( entry.positions.at( c3 ) == 2 );
+        REQUIRE( fetched == 1 );
+
+        THEN( "same generation is a hit" )
+        {
+            REQUIRE_TRY( cache.fetch( p1, 1, fetch_children ) );
+            REQUIRE( fetched == 1 );
+
+            REQUIRE_TRY( cache.fetch( p2, 1, fetch_children ) );
+            REQUIRE( fetched == 2 );
+            REQUIRE( cache.size() == 2 );
+        }
+        THEN( "new generation refetches" )
+        {
+            children[ p1 ] = { c2, c1 };
+
+            auto const& refetched = REQUIRE_TRY( cache.fetch( p1, 2, fetch_children ) ).get();
+
+            REQUIRE( refetched.children == UuidVec{ c2, c1 } );
+            REQUIRE( fetched == 2 );
+            REQUIRE( cache.size() == 1 );
+        }
+    }
+}
+
+SCENARIO( "select_window bounds by range", "[network][neighborhood]" )
+{
+    auto const range = UuidVec{ gen_uuid(), gen_uuid(), gen_uuid(), gen_uuid(), gen_uuid() };
+
+    THEN( "window within range" )
+    {
+        REQUIRE( select_window( range, 2, 1 ) == UuidVec{ range[ 1 ], range[ 2 ] } );
+    }
+    THEN( "window clipped at either end" )
+    {
+        REQUIRE( select_window( range, 0, 2 ) == UuidVec{ range[ 0 ], range[ 1 ] } );
+        REQUIRE( select_window( range, 4, 3 ) == UuidVec{ range[ 1 ], range[ 2 ], range[ 3 ], range[ 4 ] } );
+    }
+    THEN( "matches select_median_range" )
+    {
+        for( auto i = std::size_t{ 0 }; i < range.size(); ++i )
+        {
+            REQUIRE( select_window( range, i, 2 ) == select_median_range( range, range[ i ], 2 ) );
+        }
+    }
+}
+
+} // namespace kmap::com
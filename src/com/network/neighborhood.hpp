@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#pragma once
+#ifndef KMAP_NETWORK_NEIGHBORHOOD_HPP
+#define KMAP_NETWORK_NEIGHBORHOOD_HPP
+
+#include "common.hpp"
+#include "util/result.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+namespace kmap::com {
+
+/**
+ * @brief Ordered children, with positions, of the parents along the selection's lineage, so that moving the selection reuses the lists of the parents it stays under.
+ * @note Entries are held for a single generation (see db::QueryCache::generation); any change to the database drops them all on next fetch.
+ */
+class NeighborhoodCache
+{
+public:
+    using FetchChildrenFn = std::function< Result< UuidVec >( Uuid const& ) >;
+
+    struct Entry
+    {
+        UuidVec children = {};
+        std::unordered_map< Uuid, std::size_t, boost::hash< Uuid > > positions = {};
+    };
+
+private:
+    std::uint64_t generation_ = 0;
+    std::unordered_map< Uuid, Entry, boost::hash< Uuid > > entries_ = {};
+
+public:
+    auto clear()
+        -> void;
+    /**
+     * @param fetch_children Returns the ordered children of `parent`, on a miss.
+     */
+    auto fetch( Uuid const& parent
+              , std::uint64_t const generation
+              , FetchChildrenFn const& fetch_children )
+        -> Result< std::reference_wrapper< Entry const > >;
+    auto size() const
+        -> std::size_t;
+};
+
+/**
+ * @brief Returns the entries of `range` from `radius` before position `median` up to `radius` after it, bounded by `range`; select_median_range() by position.
+ */
+[[ nodiscard ]]
+auto select_window( UuidVec const& range
+                  , std::size_t const median
+                  , std::size_t const radius )
+    -> UuidVec;
+
+} // namespace kmap::com
+
+#endif // KMAP_NETWORK_NEIGHBORHOOD_HPP
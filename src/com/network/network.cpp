@@ -83,6 +83,8 @@ auto Network::load()
     auto const rn = KTRY( fetch_component< com::RootNode >() );
 
     selected_node_ = rn->root_node();
+    ancestry_.clear();
+    neighborhood_.clear();
 
     KTRY( load_aliases() );
 
@@ -99,26 +101,22 @@ auto Network::load_aliases()
     auto rv = KMAP_MAKE_RESULT( void );
     auto const db = KTRY( fetch_component< com::Database >() );
     
-    auto const alias_tbl = db->fetch< db::AliasTable >();
-    auto all_aliases = alias_tbl
-                     | rvs::transform([]( auto const& e ){ return AliasLoadItem{ AliasItem{ .src_id = AliasItem::src_type{ e.left().value( ) }
-                                                                                          , .rsrc_id = AliasItem::rsrc_type{ e.left().value() }
-                                                                                          , .dst_id = AliasItem::dst_type{ e.right().value() }
-                                                                                          , .top_id = AliasItem::top_type{ make_alias_id( e.left().value(), e.right().value() ) } } }; } )
-                     | ranges::to< AliasLoadSet >();
+    auto const& alias_tbl = db->fetch< db::AliasTable >();
 
-    // auto& av = all_aliases.get< AliasLoadItem::loaded_type >();
-    auto eq = all_aliases.get< AliasLoadItem::loaded_type >().equal_range( AliasLoadItem::loaded_type{ false } );
-
-    while( eq.first != eq.second )
+    // Only top aliases are persisted, and only those are loaded. Their descendants are materialized as they're fetched.
+    for( auto const& e : alias_tbl )
     {
-        auto const next = *eq.first;
+        auto const src = e.left().value();
+        auto const dst = e.right().value();
 
-        KTRY( load_alias_leaf( next.top().value(), next.src().value(), next.dst().value(), all_aliases ) );
+        KMAP_ENSURE( exists( src ), error_code::network::invalid_node );
+        KMAP_ENSURE( exists( dst ), error_code::network::invalid_node );
 
-        eq = all_aliases.get< AliasLoadItem::loaded_type >().equal_range( AliasLoadItem::loaded_type{ false } );
+        KTRY( astore_.push_alias( make_alias_item( make_alias_id( src, dst ), src, src, dst ) ) );
     }
 
+    KTRY( clear_query_cache() );
+
     rv = outcome::success();
 
     return rv;
@@ -136,6 +134,49 @@ auto Network::alias_store() const
     return astore_;
 }
 
+auto Network::clear_query_cache()
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+
+    auto const db = KTRY( fetch_component< com::Database >() );
+
+    db->query_cache().clear();
+
+    return outcome::success();
+}
+
+auto Network::database() const
+    -> Database const&
+{
+    auto const db = component_slot< com::Database >();
+
+    KMAP_ENSURE_EXCEPT( db ); // Database is a requisite, so outlives Network.
+
+    return *db;
+}
+
+auto Network::fetch_parent_fn() const
+    -> AncestryIndex::FetchParentFn
+{
+    return [ this ]( Uuid const& node ){ return fetch_parent( node ); };
+}
+
+auto Network::record_lineage( Uuid const& ancestor
+                            , Uuid const& descendant ) const
+    -> void
+{
+    auto const& qcache = database().query_cache();
+
+    if( qcache.is_recording() )
+    {
+        for( auto const& node : ancestry_.lineage( descendant, ancestor ) )
+        {
+            qcache.record( node );
+        }
+    }
+}
+
 auto Network::copy_body( Uuid const& src
                        , Uuid const& dst )
     -> Result< void >
@@ -208,6 +249,12 @@ auto Network::create_alias( Uuid const& src
         KTRY( attr::push_order( km, rdst, rsrc ) ); // Resolve src ID gets placed in ordering, rather than the alias ID.
     }
 
+    // Aliases of `rdst` are expanded first, so the new alias is mirrored into each under that alias' top, rather than its own.
+    for( auto const& entry : astore_.fetch_entries( AliasItem::rsrc_type{ rdst } ) )
+    {
+        KTRY( expand_alias( entry.alias() ) );
+    }
+
     auto const pushed_id = KTRY( create_alias_leaf( alias_id, rsrc, rdst ) );
 
     for( auto const& entry : astore_.fetch_entries( AliasItem::rsrc_type{ rdst } ) )
@@ -506,6 +553,308 @@ auto Network::create_child( Uuid const& parent
     return rv;
 }
 
+auto Network::create_subtree( Uuid const& parent
+                            , std::vector< NodeSpec > const& nodes )
+    -> Result< UuidVec >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_NODE( "parent", parent );
+
+    struct Pending
+    {
+        Uuid parent;
+        NodeSpec const* spec;
+    };
+
+    auto rv = KMAP_MAKE_RESULT( UuidVec );
+    auto& km = kmap_inst();
+
+    BC_CONTRACT()
+        BC_POST([ & ]
+        {
+            if( rv )
+            {
+                for( auto const& e : rv.value() )
+                {
+                    BC_ASSERT( KTRYE( fetch_parent( e ) ) == resolve( parent ) );
+                }
+            }
+        })
+    ;
+
+    auto const db = KTRY( fetch_component< com::Database >() );
+    auto const feed_hold = db->change_feed().hold(); // Deliver the subtree as one batch.
+    auto const rparent = alias_store().resolve( parent );
+
+    KMAP_ENSURE( db->node_exists( rparent ), error_code::create_node::invalid_parent );
+
+    // Flatten to pre-order, so that every parent is written before its children.
+    auto pending = std::vector< Pending >{};
+    {
+        auto stack = nodes
+                   | rvs::reverse
+                   | rvs::transform( [ & ]( auto const& e ){ return Pending{ rparent, &e }; } )
+                   | ranges::to< std::vector >();
+
+        while( !stack.empty() )
+        {
+            auto const next = stack.back();
+
+            stack.pop_back();
+            pending.emplace_back( next );
+
+            for( auto const& child : next.spec->children | rvs::reverse )
+            {
+                stack.emplace_back( Pending{ next.spec->id, &child } );
+            }
+        }
+    }
+
+    // Validate in full before writing anything.
+    {
+        auto ids = UuidSet{};
+        auto headings = std::set< std::pair< Uuid, Heading > >{};
+
+        for( auto const& [ p, spec ] : pending )
+        {
+            KMAP_ENSURE( is_valid_heading( spec->heading ), error_code::node::invalid_heading );
+            KMAP_ENSURE( !exists( spec->id ) && ids.emplace( spec->id ).second, error_code::create_node::node_already_exists );
+            KMAP_ENSURE_MSG( headings.emplace( p, spec->heading ).second, error_code::create_node::duplicate_child_heading, spec->heading );
+        }
+        for( auto const& spec : nodes )
+        {
+            KMAP_ENSURE_MSG( !is_child( parent, spec.heading ), error_code::create_node::duplicate_child_heading, fmt::format( "{}:{}", absolute_path_flat( km, parent ), spec.heading ) );
+        }
+    }
+
+    auto const in_attr_tree = attr::is_in_attr_tree( km, rparent );
+    auto const join_ids = []( auto const& specs )
+    {
+        auto const ids = specs
+                       | rvs::transform( []( auto const& e ){ return to_string( e.id ); } )
+                       | ranges::to< std::vector >();
+
+        return ids
+             | rvs::join( '\n' )
+             | ranges::to< std::string >();
+    };
+    auto const push_attr_child = [ & ]( Uuid const& attrn
+                                      , Heading const& heading
+                                      , std::string const& body ) -> Result< void >
+    {
+        auto const n = gen_uuid();
+
+        KTRY( db->push_node( n ) );
+        KTRY( db->push_heading( n, heading ) );
+        KTRY( db->push_title( n, format_title( heading ) ) );
+        KTRY( db->push_child( attrn, n ) );
+        KTRY( db->push_body( n, body ) );
+
+        return outcome::success();
+    };
+
+    for( auto const& [ p, spec ] : pending )
+    {
+        KTRY( create_child_internal( p, spec->id, spec->heading, spec->title.value_or( format_title( spec->heading ) ) ) );
+
+        if( !spec->body.empty() )
+        {
+            KTRY( db->push_body( spec->id, spec->body ) );
+        }
+
+        if( !in_attr_tree )
+        {
+            auto const attrn = KTRY( create_attr_node( *db, spec->id ) );
+
+            KTRY( push_attr_child( attrn, "genesis", std::to_string( present_time() ) ) );
+
+            if( !spec->children.empty() )
+            {
+                KTRY( push_attr_child( attrn, "order", join_ids( spec->children ) ) );
+            }
+        }
+    }
+
+    if( !in_attr_tree && !nodes.empty() )
+    {
+        auto const ordern = KTRY( anchor::node( rparent )
+                                | view2::attr
+                                | view2::child( "order" )
+                                | act2::fetch_or_create_node( km )
+                                | act2::single );
+
+        if( auto const b = fetch_body( ordern )
+          ; b && !b.value().empty() )
+        {
+            KTRY( update_body( ordern, fmt::format( "{}\n{}", b.value(), join_ids( nodes ) ) ) );
+        }
+        else
+        {
+            KTRY( update_body( ordern, join_ids( nodes ) ) );
+        }
+    }
+
+    for( auto const& spec : nodes )
+    {
+        KTRY( create_child_aliases( rparent, spec.id ) );
+    }
+
+    if( auto const estore = fetch_component< com::EventStore >()
+      ; estore )
+    {
+        auto const& estorev = estore.value();
+
+        KTRY( estorev->install_subject( "network" ) );
+        KTRY( estorev->install_verb( "created" ) );
+        KTRY( estorev->install_object( "subtree" ) );
+        KTRY( estorev->fire_event( { "subject.network", "verb.created", "object.subtree" }
+                                 , { { "parent_node", to_string( rparent ) }
+                                   , { "node_count", std::to_string( pending.size() ) } } ) );
+    }
+
+    rv = nodes
+       | rvs::transform( []( auto const& e ){ return e.id; } )
+       | ranges::to< UuidVec >();
+
+    return rv;
+}
+
+SCENARIO( "Network::create_subtree", "[com][network][create_subtree]" )
+{
+    KMAP_COMPONENT_FIXTURE_SCOPED( "network", "root_node" );
+
+    auto& km = Singleton::instance();
+    auto const nw = REQUIRE_TRY( km.fetch_component< com::Network >() );
+    auto const root = nw->root_node();
+
+    GIVEN( "spec of /1.{11,12} and /2" )
+    {
+        auto const spec = std::vector< NodeSpec >{ NodeSpec{ .heading = "1"
+                                                           , .body = "one"
+                                                           , .children = { NodeSpec{ .heading = "11" }
+                                                                         , NodeSpec{ .heading = "12" } } }
+                                                 , NodeSpec{ .heading = "2" } };
+
+        WHEN( "created under root" )
+        {
+            auto const created = REQUIRE_TRY( nw->create_subtree( root, spec ) );
+
+            THEN( "nodes are created in spec order" )
+            {
+                REQUIRE( created == UuidVec{ spec[ 0 ].id, spec[ 1 ].id } );
+                REQUIRE( REQUIRE_TRY( nw->fetch_children_ordered( root ) ) == created );
+                REQUIRE( REQUIRE_TRY( nw->fetch_children_ordered( spec[ 0 ].id ) ) == UuidVec{ spec[ 0 ].children[ 0 ].id, spec[ 0 ].children[ 1 ].id } );
+                REQUIRE( REQUIRE_TRY( nw->fetch_body( spec[ 0 ].id ) ) == "one" );
+                REQUIRE( REQUIRE_TRY( nw->fetch_title( spec[ 1 ].id ) ) == format_title( "2" ) );
+                REQUIRE( ( anchor::node( spec[ 0 ].children[ 1 ].id ) | view2::attr | view2::child( "genesis" ) | act2::exists( km ) ) );
+            }
+            THEN( "children can be appended individually" )
+            {
+                auto const n3 = REQUIRE_TRY( nw->create_child( root, "3" ) );
+
+                REQUIRE( REQUIRE_TRY( nw->fetch_children_ordered( root ) ) == UuidVec{ spec[ 0 ].id, spec[ 1 ].id, n3 } );
+            }
+        }
+    }
+    GIVEN( "spec with duplicate sibling headings" )
+    {
+        auto const spec = std::vector< NodeSpec >{ NodeSpec{ .heading = "1"
+                                                           , .children = { NodeSpec{ .heading = "x" }
+                                                                         , NodeSpec{ .heading = "x" } } } };
+
+        THEN( "nothing is created" )
+        {
+            REQUIRE( test::fail( nw->create_subtree( root, spec ) ) );
+            REQUIRE( !nw->exists( spec[ 0 ].id ) );
+        }
+    }
+}
+
+auto parse_outline( std::string_view const outline )
+    -> Result< std::vector< NodeSpec > >
+{
+    KM_RESULT_PROLOG();
+
+    struct Line
+    {
+        std::size_t indent;
+        std::string title;
+    };
+
+    auto rv = KMAP_MAKE_RESULT( std::vector< NodeSpec > );
+    auto lines = std::vector< Line >{};
+
+    for( auto const& line : outline | rvs::split( '\n' ) )
+    {
+        auto const l = line | ranges::to< std::string >();
+        auto const first = l.find_first_not_of( " \t" );
+        auto const last = l.find_last_not_of( " \t\r" );
+
+        if( first != std::string::npos )
+        {
+            lines.emplace_back( Line{ .indent = first, .title = l.substr( first, last - first + 1 ) } );
+        }
+    }
+
+    auto next = lines.begin();
+    auto const nest = [ & ]( auto const& self
+                           , std::size_t const indent ) -> std::vector< NodeSpec >
+    {
+        auto specs = std::vector< NodeSpec >{};
+
+        while( next != lines.end() && next->indent == indent )
+        {
+            auto spec = NodeSpec{ .heading = format_heading( next->title ), .title = next->title };
+
+            ++next;
+
+            if( next != lines.end() && next->indent > indent )
+            {
+                spec.children = self( self, next->indent );
+            }
+
+            specs.emplace_back( std::move( spec ) );
+        }
+
+        return specs;
+    };
+    auto specs = lines.empty()
+               ? std::vector< NodeSpec >{}
+               : nest( nest, lines.front().indent );
+
+    KMAP_ENSURE_MSG( next == lines.end(), error_code::common::conversion_failed, fmt::format( "inconsistent indentation at: '{}'", next->title ) );
+
+    rv = std::move( specs );
+
+    return rv;
+}
+
+SCENARIO( "parse_outline", "[com][network][create_subtree]" )
+{
+    GIVEN( "nested outline" )
+    {
+        auto const specs = REQUIRE_TRY( parse_outline( "One\n  One One\n    One One One\n\n  One Two\r\nTwo\n" ) );
+
+        THEN( "lines nest by indentation" )
+        {
+            REQUIRE( specs.size() == 2 );
+            REQUIRE( specs[ 0 ].title == Title{ "One" } );
+            REQUIRE( specs[ 0 ].heading == format_heading( "One" ) );
+            REQUIRE( specs[ 0 ].children.size() == 2 );
+            REQUIRE( specs[ 0 ].children[ 0 ].children.size() == 1 );
+            REQUIRE( specs[ 0 ].children[ 1 ].title == Title{ "One Two" } );
+            REQUIRE( specs[ 1 ].children.empty() );
+        }
+    }
+    GIVEN( "outline returning to an unopened indentation" )
+    {
+        THEN( "it's refused" )
+        {
+            REQUIRE( test::fail( parse_outline( "One\n    One One\n  One Two" ) ) );
+        }
+    }
+}
+
 auto Network::create_alias_leaf( Uuid const& top
                                , Uuid const& src 
                                , Uuid const& dst )
@@ -538,21 +887,61 @@ auto Network::create_alias_leaf( Uuid const& top
     auto const alias_item = make_alias_item( top, src, rsrc, dst );
     auto const alias_id = KTRY( astore_.push_alias( alias_item ) );
 
-    for( auto const& child : fetch_children( src ) )
+    KTRY( clear_query_cache() );
+
+    rv = alias_id;
+
+    return rv;
+}
+
+auto Network::expand_alias( Uuid const& alias ) const
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH( "alias", alias );
+
+    auto rv = KMAP_MAKE_RESULT( void );
+
+    if( astore_.is_pending( alias ) )
     {
-        if( is_alias( child ) )
-        {
-            auto const entry = KTRY( astore_.fetch_entry( child ) );
+        auto const entry = KTRY( astore_.fetch_entry( alias ) );
 
-            KTRY( create_alias_leaf( entry.top().value(), entry.rsrc().value(), alias_id ) );
-        }
-        else
+        astore_.erase_pending( alias );
+
+        for( auto const& child : fetch_children( entry.rsrc().value() ) )
         {
-            KTRY( create_alias_leaf( top, child, alias_id ) );
+            auto const item = KTRY( make_mirror_item( entry, child ) );
+
+            KTRY( astore_.push_alias( item ) );
         }
     }
 
-    rv = alias_id;
+    rv = outcome::success();
+
+    return rv;
+}
+
+auto Network::make_mirror_item( AliasItem const& parent
+                               , Uuid const& child ) const
+    -> Result< AliasItem >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH( "parent", parent.alias() );
+        KM_RESULT_PUSH( "child", child );
+
+    auto rv = result::make_result< AliasItem >();
+
+    // Real children are mirrored under the parent alias' top; alias children keep their own.
+    if( is_alias( child ) )
+    {
+        auto const centry = KTRY( astore_.fetch_entry( child ) );
+
+        rv = make_alias_item( centry.top().value(), centry.rsrc().value(), centry.rsrc().value(), parent.alias() );
+    }
+    else
+    {
+        rv = make_alias_item( parent.top().value(), child, child, parent.alias() );
+    }
 
     return rv;
 }
@@ -663,6 +1052,8 @@ auto Network::erase_alias_desc( Uuid const& id )
     }
 
     KTRY( astore.erase_alias( AliasItem::alias_type{ id } ) );
+    KTRY( clear_query_cache() );
+    ancestry_.erase( id );
 
     rv = outcome::success();
 
@@ -681,6 +1072,8 @@ auto Network::erase_alias_leaf( Uuid const& id )
     KMAP_ENSURE( !is_top_alias( id ), error_code::node::invalid_alias );
 
     KTRY( alias_store().erase_alias( AliasItem::alias_type{ id } ) );
+    KTRY( clear_query_cache() );
+    ancestry_.erase( id );
 
     // if( auto const estore = fetch_component< com::EventStore >()
     //   ; estore )
@@ -729,6 +1122,8 @@ auto Network::erase_alias_root( Uuid const& id )
     }
 
     KTRY( alias_store().erase_alias( AliasItem::alias_type{ id } ) ); // TODO: What happens if this fails? Need to undo db->erase_alias, for correctness.
+    KTRY( clear_query_cache() );
+    ancestry_.erase( id );
 
     {
         auto const db = KTRY( fetch_component< com::Database >() );
@@ -778,30 +1173,7 @@ auto Network::erase_node_internal( Uuid const& id )
     }
     else
     {
-        // Delete children.
-        auto const children = [ & ]
-        {
-            // TODO: Unify when attributes are allowed to be ordered.
-            if( attr::is_in_attr_tree( km, id ) )
-            {
-                return anchor::node( id )
-                     | view2::child
-                     | act2::to_node_vec( km );
-            }
-            else
-            {
-                return anchor::node( id )
-                     | view2::child
-                     | view2::order
-                     | act2::to_node_vec( km );
-            }
-        }();
-        for( auto const& e : children | views::reverse ) // Not necessary to erase in reverse order, but it seems like a reasonable requirement (FILO)
-        {
-            KTRY( erase_node_internal( e ) );
-        }
-
-        KTRY( erase_node_leaf( id ) );
+        KTRY( erase_node_subtree( id ) );
     }
 
     rv = outcome::success();
@@ -809,7 +1181,7 @@ auto Network::erase_node_internal( Uuid const& id )
     return rv;
 }
 
-auto Network::erase_node_leaf( Uuid const& id )
+auto Network::erase_node_subtree( Uuid const& id )
     -> Result< void >
 {
     KM_RESULT_PROLOG();
@@ -823,67 +1195,137 @@ auto Network::erase_node_leaf( Uuid const& id )
         {
             BC_ASSERT( id == resolve( id ) );
         })
-        BC_POST([ &
-                , parent = fetch_parent( id ) ]
+        BC_POST([ & ]
         {
             if( rv )
             {
                 BC_ASSERT( !exists( id ) );
-
-                if( parent ) // Not root
-                {
-                    BC_ASSERT( exists( parent.value() ) );
-                    BC_ASSERT( !attr::is_in_order( km, parent.value(), id ) );
-                }
             }
         })
     ;
 
     KMAP_ENSURE( exists( id ), error_code::network::invalid_node );
     KMAP_ENSURE( id != km.root_node_id(), error_code::network::invalid_node );
-    KMAP_ENSURE( fetch_children( id ).empty(), error_code::network::invalid_node ); // Only applies to non-top-alias. AliasStore::erase_alias destroys descendants.
 
     auto const db = KTRY( fetch_component< com::Database >() );
-    auto const aliases = astore_.fetch_aliases( AliasItem::rsrc_type{ id } );
-    auto const desc_aliases = aliases
-                            | rvs::filter( [ & ]( auto const& n ){ return !is_top_alias( n ); } )
-                            | ranges::to< std::set< Uuid > >();
-    auto const top_aliases = aliases
-                           | rvs::filter( [ & ]( auto const& n ){ return is_top_alias( n ); } )
-                           | ranges::to< std::set< Uuid > >();
+    auto const feed_hold = db->change_feed().hold(); // Deliver the subtree as one batch.
+
+    // Closure: the subtree, attribute trees included, parents before children.
+    auto doomed = UuidVec{ id };
+    auto doomed_set = UuidUnSet{ id };
 
-    // TODO: Are not root and non-root alias children mutually exclusive?
-    //       What is an example where they could co-exist?
-    for( auto const& dalias : desc_aliases )
+    for( auto i = std::size_t{ 0 }
+       ; i < doomed.size()
+       ; ++i )
     {
-        KTRY( erase_alias_leaf( dalias ) );
+        auto const node = doomed[ i ];
+        auto next = KTRY( db->fetch_children( node ) );
+
+        if( auto const attrn = db->fetch_attr( node )
+          ; attrn )
+        {
+            next.emplace( attrn.value() );
+        }
+
+        for( auto const& e : next )
+        {
+            doomed.emplace_back( e );
+            doomed_set.emplace( e );
+        }
     }
-    for( auto const& talias : top_aliases )
+
+    // Aliases dependent on the closure: those placed within it, those of its nodes placed outside it, and those mirroring `id` under aliases of its ancestors.
+    // Erasing these alias roots cascades to their alias descendants.
+    auto alias_roots = UuidSet{};
+    auto alias_edges = std::set< std::pair< Uuid, Uuid > >{}; // Persisted (src, dst) of erased top aliases.
+    auto order_pops = std::map< Uuid, UuidSet >{}; // Surviving parent => children to drop from its order.
+
+    if( !attr::is_in_attr_tree( km, id ) )
     {
-        KTRY( erase_alias_root( talias ) );
+        order_pops[ KTRY( fetch_parent( id ) ) ].emplace( id );
     }
 
-    if( !attr::is_in_attr_tree( km, id ) )
+    for( auto const& node : doomed )
     {
-        auto const parent = KTRY( fetch_parent( id ) );
+        for( auto const& alias : astore_.fetch_aliases( AliasItem::rsrc_type{ node } ) )
+        {
+            if( is_top_alias( alias ) )
+            {
+                auto const dst = KTRY( fetch_parent( alias ) );
+
+                alias_roots.emplace( alias );
+                alias_edges.emplace( node, dst );
+
+                if( !doomed_set.contains( dst )
+                 && !attr::is_in_attr_tree( km, dst ) )
+                {
+                    order_pops[ dst ].emplace( node );
+                }
+            }
+            else if( node == id )
+            {
+                alias_roots.emplace( alias );
+            }
+        }
+        for( auto const& alias : astore_.fetch_alias_children( node ) )
+        {
+            alias_roots.emplace( alias );
+            alias_edges.emplace( resolve( alias ), node );
+        }
+    }
 
-        // TODO: Order should be done via event, I think? It's an add-on feature. Unless... event relies on order which complicates things.
-        //       Update: order to become fundamental (database) concept, so ignore this TODO.
-        KTRY( attr::pop_order( km, parent, id ) );
+    for( auto const& alias : alias_roots )
+    {
+        if( is_alias( alias ) ) // May already have gone with an enclosing alias.
+        {
+            KTRY( astore_.erase_alias( AliasItem::alias_type{ alias } ) );
+        }
+    }
+    for( auto const& [ src, dst ] : alias_edges )
+    {
+        KTRY( db->erase_alias( src, dst ) );
+    }
 
-        if( auto const at = fetch_attr_node( id )
-          ; at )
+    // Each surviving parent's order is rewritten once, however many of its children went.
+    for( auto const& [ parent, children ] : order_pops )
+    {
+        auto const attrn = KTRY( db->fetch_attr( parent ) );
+        auto const ordern = KTRY( db->fetch_child( attrn, "order" ) );
+        auto const ordering = KTRY( db->fetch_order( parent ) );
+        auto const remaining = ordering
+                             | rvs::remove_if( [ & ]( auto const& e ){ return children.contains( e ); } )
+                             | rvs::transform( []( auto const& e ){ return to_string( e ); } )
+                             | ranges::to< std::vector >();
+
+        if( remaining.empty() )
+        {
+            KTRY( erase_node_subtree( ordern ) );
+        }
+        else
         {
-            KTRY( erase_attr( at.value() ) );
+            KTRY( update_body( ordern
+                             , remaining
+                             | rvs::join( '\n' )
+                             | ranges::to< std::string >() ) );
         }
     }
 
-    KTRY( db->erase_all( id ) );
+    KTRY( db->erase_all( doomed ) );
+
+    ancestry_.clear();
 
+    if( !alias_roots.empty() )
+    {
+        KTRY( clear_query_cache() );
+    }
+
+    // One event for the subtree; descendants go with it.
     if( auto const estore = fetch_component< com::EventStore >()
       ; estore )
     {
-        KTRY( estore.value()->fire_event( { "subject.network", "verb.erased", "object.node" },  { { "node_id", to_string( id ) } } ) );
+        KTRY( estore.value()->fire_event( { "subject.network", "verb.erased", "object.node" }
+                                        , { { "node_id", to_string( id ) }
+                                          , { "node_count", std::to_string( doomed.size() ) } } ) );
     }
 
     rv = outcome::success();
@@ -926,6 +1368,7 @@ auto Network::erase_attr( Uuid const& id )
     auto const parent = db->fetch_attr_owner( id );
 
     KTRY( db->erase_all( id ) );
+    ancestry_.erase( id );
 
     if( auto const estore = fetch_component< com::EventStore >()
       ; estore )
@@ -957,22 +1400,10 @@ auto Network::distance( Uuid const& ancestor
         })
     ;
 
-    auto rv = uint32_t{};
-    auto traveler = Optional< Uuid >{ descendant };
+    auto const parent_fn = fetch_parent_fn();
+    auto const rv = ancestry_.depth( descendant, parent_fn ) - ancestry_.depth( ancestor, parent_fn );
 
-    while( traveler )
-    {
-        if( traveler != ancestor )
-        {
-            traveler = to_optional( fetch_parent( traveler.value() ) );
-
-            ++rv;
-        }
-        else
-        {
-            traveler.reset();
-        }
-    }
+    record_lineage( ancestor, descendant );
 
     return rv;
 }
@@ -1310,14 +1741,64 @@ SCENARIO( "Network::erase_node erases attributes", "[network][attribute][alias]"
     }
 }
 
+SCENARIO( "Network::erase_node drops erased aliases from surviving orders", "[network][alias][order]" )
+{
+    KMAP_COMPONENT_FIXTURE_SCOPED( "network", "root_node" );
+
+    auto& km = Singleton::instance();
+    auto const nw = REQUIRE_TRY( km.fetch_component< com::Network >() );
+    auto const root = nw->root_node();
+
+    GIVEN( "/1.{a,b,c}, /2.{x}" )
+    {
+        auto const n1 = REQUIRE_TRY( nw->create_child( root, "1" ) );
+        auto const n1a = REQUIRE_TRY( nw->create_child( n1, "a" ) );
+        auto const n1b = REQUIRE_TRY( nw->create_child( n1, "b" ) );
+        auto const n1c = REQUIRE_TRY( nw->create_child( n1, "c" ) );
+        auto const n2 = REQUIRE_TRY( nw->create_child( root, "2" ) );
+        auto const n2x = REQUIRE_TRY( nw->create_child( n2, "x" ) );
+
+        GIVEN( "a, b, and c aliased to /2" )
+        {
+            auto const a2a = REQUIRE_TRY( nw->create_alias( n1a, n2 ) );
+            auto const a2b = REQUIRE_TRY( nw->create_alias( n1b, n2 ) );
+            auto const a2c = REQUIRE_TRY( nw->create_alias( n1c, n2 ) );
+
+            REQUIRE( REQUIRE_TRY( nw->fetch_children_ordered( n2 ) ) == UuidVec{ n2x, a2a, a2b, a2c } );
+
+            WHEN( "erase /1" )
+            {
+                REQUIRE_TRY( nw->erase_node( n1 ) );
+
+                THEN( "/2 retains only its own child" )
+                {
+                    REQUIRE( !nw->exists( a2a ) );
+                    REQUIRE( !nw->exists( a2b ) );
+                    REQUIRE( !nw->exists( a2c ) );
+                    REQUIRE( REQUIRE_TRY( nw->fetch_children_ordered( n2 ) ) == UuidVec{ n2x } );
+                    REQUIRE( REQUIRE_TRY( nw->fetch_children_ordered( root ) ) == UuidVec{ n2 } );
+                }
+            }
+            WHEN( "erase /2" )
+            {
+                REQUIRE_TRY( nw->erase_node( n2 ) );
+
+                THEN( "/1 and its children remain" )
+                {
+                    REQUIRE( REQUIRE_TRY( nw->fetch_children_ordered( n1 ) ) == UuidVec{ n1a, n1b, n1c } );
+                    REQUIRE( nw->alias_store().fetch_aliases( com::AliasItem::rsrc_type{ n1a } ).empty() );
+                }
+            }
+        }
+    }
+}
+
 auto Network::exists( Uuid const& id ) const
     -> bool
 {
-    KM_RESULT_PROLOG();
-
-    auto const db = KTRYE( fetch_component< com::Database >() );
+    auto const& db = database();
 
-    return db->node_exists( alias_store().resolve( id ) );
+    return db.node_exists( alias_store().resolve( id ) );
 }
 
 auto Network::exists( Heading const& heading ) const
@@ -1531,6 +2012,60 @@ auto Network::fetch_aliased_ancestry( Uuid const& id ) const
     return rv;
 }
 
+auto Network::fetch_aliases( Uuid const& node ) const
+    -> UuidSet
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH( "node", node );
+
+    if( !is_alias( node ) )
+    {
+        auto visited = UuidSet{};
+
+        KTRYE( materialize_aliases( node, visited ) );
+    }
+
+    return astore_.fetch_aliases( AliasItem::rsrc_type{ node } );
+}
+
+SCENARIO( "Network::fetch_aliases materializes nested aliases", "[network][alias]" )
+{
+    KMAP_COMPONENT_FIXTURE_SCOPED( "network" );
+
+    auto& km = Singleton::instance();
+    auto const nw = REQUIRE_TRY( km.fetch_component< com::Network >() );
+    auto const root = nw->root_node();
+
+    GIVEN( "/1.1, /2, /3, aliases: /2.1, /3.2" )
+    {
+        auto const n1 = REQUIRE_TRY( nw->create_child( root, "1" ) );
+        auto const n11 = REQUIRE_TRY( nw->create_child( n1, "1" ) );
+        auto const n2 = REQUIRE_TRY( nw->create_child( root, "2" ) );
+        auto const n3 = REQUIRE_TRY( nw->create_child( root, "3" ) );
+        auto const a21 = REQUIRE_TRY( nw->create_alias( n1, n2 ) );
+        auto const a32 = REQUIRE_TRY( nw->create_alias( n2, n3 ) );
+        auto const a211 = make_alias_id( n11, a21 );
+        auto const a321 = make_alias_id( n1, a32 );
+        auto const a3211 = make_alias_id( n11, a321 );
+
+        THEN( "aliases of /1.1 include those nested in /3.2" )
+        {
+            REQUIRE( nw->fetch_aliases( n11 ) == UuidSet{ a211, a3211 } );
+            REQUIRE( REQUIRE_TRY( nw->fetch_parent( a3211 ) ) == a321 );
+            REQUIRE( nw->resolve( a3211 ) == n11 );
+        }
+        THEN( "aliases of /1 include /3.2.1" )
+        {
+            REQUIRE( nw->fetch_aliases( n1 ) == UuidSet{ a21, a321 } );
+        }
+        THEN( "alias children are fetched" )
+        {
+            REQUIRE( nw->fetch_children( a32 ) == UuidSet{ a321 } );
+            REQUIRE( nw->fetch_children( a321 ) == UuidSet{ a3211 } );
+        }
+    }
+}
+
 auto Network::fetch_attr_node( Uuid const& id ) const
     -> Result< Uuid >
 {
@@ -1538,9 +2073,9 @@ auto Network::fetch_attr_node( Uuid const& id ) const
         KM_RESULT_PUSH( "node", id );
 
     auto rv = KMAP_MAKE_RESULT( Uuid );
-    auto const db = KTRY( fetch_component< com::Database >() );
+    auto const& db = database();
 
-    rv = KTRY( db->fetch_attr( alias_store().resolve( id ) ) ); // TODO: resolve( id ) is under debate. Should resolving aliases be done implicitly, or required explicitly? Here, it is implicit.
+    rv = KTRY( db.fetch_attr( alias_store().resolve( id ) ) ); // TODO: resolve( id ) is under debate. Should resolving aliases be done implicitly, or required explicitly? Here, it is implicit.
 
     return rv;
 }
@@ -1561,9 +2096,9 @@ auto Network::fetch_body( Uuid const& node ) const
 
     if( exists( node ) )
     {
-        auto const db = KTRY( fetch_component< com::Database >() );
+        auto const& db = database();
 
-        rv = KTRY( db->fetch_body( alias_store().resolve( node ) ) );
+        rv = std::string{ KTRY( db.fetch_body_view( alias_store().resolve( node ) ) ) };
     }
     else
     {
@@ -1601,11 +2136,16 @@ auto Network::fetch_children( Uuid const& parent ) const
         }
         else
         {
-            auto const db = KTRYE( fetch_component< com::Database >() );
+            auto const& db = database();
 
-            return KTRYE( db->fetch_children( parent ) );
+            return KTRYE( db.fetch_children( parent ) );
         }
     }();
+    if( is_alias( parent ) )
+    {
+        KTRYE( expand_alias( parent ) );
+    }
+
     auto const alias_children = alias_store().fetch_alias_children( parent );
 
     auto const all = views::concat( db_children, alias_children )
@@ -1640,7 +2180,6 @@ auto Network::fetch_children_ordered( Uuid const& parent ) const
 
     KMAP_ENSURE( exists( parent ), error_code::network::invalid_node );
 
-    auto const& km = kmap_inst();
     auto const unord_children = fetch_children( parent );
 
     if( unord_children.empty() )
@@ -1649,33 +2188,33 @@ auto Network::fetch_children_ordered( Uuid const& parent ) const
     }
     else
     {
-        auto const r_to_a_map = unord_children
+        auto const& db = database();
+        auto const ordering = KTRY( db.fetch_order( resolve( parent ) ) );
+        // Ordering lists alias sources, so map those back to the alias children of `parent`.
+        auto const r_to_a_map = alias_store().fetch_alias_children( parent )
                               | rvs::transform( [ & ]( auto const& n ){ return std::pair{ resolve( n ), n }; } )
                               | ranges::to< std::map >();
-        auto const ordering_str = KTRY( anchor::node( parent )
-                                      | view2::attr
-                                      | view2::child( "order" )
-                                      | act2::fetch_body( km ) );
-        auto const split = ordering_str
-                         | rvs::split( '\n' )
-                         | ranges::to< std::vector< std::string > >();
 
         KM_RESULT_PUSH( "unordered_children.size", unord_children.size() );
-        KM_RESULT_PUSH( "ordering.size", split.size() );
-        KMAP_ENSURE( unord_children.size() == split.size(), error_code::common::uncategorized ); 
+        KM_RESULT_PUSH( "ordering.size", ordering.size() );
+        KMAP_ENSURE( unord_children.size() == ordering.size(), error_code::common::uncategorized ); 
 
-        auto const map_resolve = [ & ]( auto const& s )
+        auto const map_resolve = [ & ]( auto const& order_node )
         {  
-            auto const order_node = KTRYE( uuid_from_string( s ) );
-
-            if( !r_to_a_map.contains( order_node ) )
+            if( auto const it = r_to_a_map.find( order_node )
+              ; it != r_to_a_map.end() )
+            {
+                return it->second;
+            }
+            else if( !unord_children.contains( order_node ) )
             {
-                KMAP_THROW_EXCEPTION_MSG( fmt::format( "mismatch between children and order nodes, for node: {}\n", s ) );
+                KMAP_THROW_EXCEPTION_MSG( fmt::format( "mismatch between children and order nodes, for node: {}\n", to_string( order_node ) ) );
             }
-            return r_to_a_map.at( order_node );
+
+            return order_node;
         };
 
-        rv = split
+        rv = ordering
            | rvs::transform( map_resolve )
            | ranges::to< std::vector >();
     }
@@ -1886,11 +2425,23 @@ auto Network::fetch_heading( Uuid const& node ) const
 
     auto rv = KMAP_MAKE_RESULT( Heading );
 
+    rv = Heading{ KTRY( fetch_heading_view( node ) ) };
+
+    return rv;
+}
+
+auto Network::fetch_heading_view( Uuid const& node ) const
+    -> Result< std::string_view >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = KMAP_MAKE_RESULT( std::string_view );
+
     if( exists( node ) )
     {
-        auto const db = KTRY( fetch_component< com::Database >() );
+        auto const& db = database();
 
-        rv = KMAP_TRY( db->fetch_heading( alias_store().resolve( node ) ) );
+        rv = KTRY( db.fetch_heading_view( alias_store().resolve( node ) ) );
     }
     else
     {
@@ -1923,55 +2474,16 @@ auto Network::fetch_nodes( Heading const& heading ) const
 auto Network::fetch_ordering_position( Uuid const& node ) const
     -> Result< uint32_t >
 {
-    using Map = std::vector< std::pair< Uuid, uint64_t > >;
-
     KM_RESULT_PROLOG();
         KM_RESULT_PUSH( "node", node );
 
     auto rv = KMAP_MAKE_RESULT( uint32_t );
-
-    auto const& km = kmap_inst();
+    auto const db = KTRY( fetch_component< com::Database >() );
     auto const parent = KTRY( fetch_parent( node ) );
-    auto const children = fetch_children( parent );
-    auto const rnode = resolve( node );
-
-    BC_ASSERT( !children.empty() );
-
-    auto map = Map{};
-    auto const porder = KTRY( view::make( parent )
-                            | view::resolve
-                            | view::attr
-                            | view::child( "order" )
-                            | view::fetch_node( km ) );
-    auto const body = KTRY( fetch_body( porder ) );
-    auto id_ordinal_map = std::map< Uuid, uint64_t >{};
-    auto const ids = body
-                   | views::split( '\n' )
-                   | to< std::vector< std::string > >();
-
-    for( auto const [ i, s ] : ids | views::enumerate )
-    {
-        auto const idi = KTRYE( to_uuid( s ) );
-
-        BC_ASSERT( !alias_store().is_alias( idi ) );
 
-        id_ordinal_map.emplace( idi, i );
-    }
-    
-    // TODO: This is more of a sanity check, right? Not exactly something that would go in Release.
-    for( auto const& e : children )
-    {
-        if( !id_ordinal_map.contains( alias_store().resolve( e ) ) )
-        {
-            for( auto const& ord : id_ordinal_map )
-            {
-                fmt::print( "ord: {}, alias?:{}\n", ord.first, to_string( alias_store().resolve( ord.first ) ) );
-            }
-            KMAP_THROW_EXCEPTION_MSG( fmt::format( "failed to find ordering ({}) for child: {}", to_string( parent ), to_string( e ) ) );
-        }
-    }
+    BC_ASSERT( !fetch_children( parent ).empty() );
 
-    rv = id_ordinal_map.at( rnode );
+    rv = static_cast< uint32_t >( KTRY( db->fetch_order_position( resolve( parent ), resolve( node ) ) ) );
 
     return rv;
 }
@@ -2079,7 +2591,7 @@ auto Network::fetch_parent( Uuid const& child ) const
         // KM_RESULT_PUSH( "child", child ); // Warning: This is prone to recursive invocation if fetch_parent itself fails, as AbsPathFlat uses fetch_parent to describe the arg node.
 
     auto rv = KMAP_MAKE_RESULT( Uuid );
-    auto const db = KTRY( fetch_component< com::Database >() );
+    auto const& db = database();
 
     if( is_alias( child ) )
     {
@@ -2087,9 +2599,9 @@ auto Network::fetch_parent( Uuid const& child ) const
     }
     else
     {
-        // TODO: Hypothetically, db->fetch_parent could return an error for a reason other than that of not finding the parent.
+        // TODO: Hypothetically, db.fetch_parent could return an error for a reason other than that of not finding the parent.
         //       I don't think, at time of writing, this is possible, but this should probably propagate any other error returned.
-        if( auto const p = db->fetch_parent( child )
+        if( auto const p = db.fetch_parent( child )
           ; p )
         {
             rv = p.value();
@@ -2177,9 +2689,9 @@ auto Network::fetch_title( Uuid const& id ) const
 
     if( exists( id ) )
     {
-        auto const db = KTRY( fetch_component< com::Database >() );
+        auto const& db = database();
 
-        rv = db->fetch_title( alias_store().resolve( id ) ).value();
+        rv = Title{ KTRY( db.fetch_title_view( alias_store().resolve( id ) ) ) };
     }
     else
     {
@@ -2297,10 +2809,14 @@ auto Network::move_node( Uuid const& from
 
         KTRY( db->erase_child( from_parent, from ) );
         KTRY( db->push_child( to, from ) );
+        ancestry_.clear(); // Depths throughout the moved subtree, aliases included, are now stale.
 
         KTRY( attr::pop_order( km, from_parent, from ) );
         KTRY( attr::push_order( km, to, from ) );
 
+        KTRY( sync_aliases( from_parent ) );
+        KTRY( sync_aliases( to ) );
+
         if( auto const estore = fetch_component< com::EventStore >()
           ; estore )
         {
@@ -2354,6 +2870,42 @@ SCENARIO( "Network::move_node", "[network][iface][move_node][order]" )
     }
 }
 
+SCENARIO( "Network::move_node patches aliases of both parents", "[network][move_node][alias]" )
+{
+    KMAP_COMPONENT_FIXTURE_SCOPED( "network", "root_node" );
+
+    auto& km = Singleton::instance();
+    auto const nw = REQUIRE_TRY( km.fetch_component< com::Network >() );
+    auto const root = km.root_node_id();
+
+    GIVEN( "/1.1, /2, /3, /4, aliases: /2.1, /4.3" )
+    {
+        auto const n1 = REQUIRE_TRY( nw->create_child( root, "1" ) );
+        auto const n11 = REQUIRE_TRY( nw->create_child( n1, "1" ) );
+        auto const n2 = REQUIRE_TRY( nw->create_child( root, "2" ) );
+        auto const n3 = REQUIRE_TRY( nw->create_child( root, "3" ) );
+        auto const n4 = REQUIRE_TRY( nw->create_child( root, "4" ) );
+        auto const a21 = REQUIRE_TRY( nw->create_alias( n1, n2 ) );
+        auto const a43 = REQUIRE_TRY( nw->create_alias( n3, n4 ) );
+
+        REQUIRE( nw->fetch_children( a21 ) == UuidSet{ make_alias_id( n11, a21 ) } );
+        REQUIRE( nw->fetch_children( a43 ).empty() );
+
+        WHEN( "move /1.1 to /3" )
+        {
+            REQUIRE_TRY( nw->move_node( n11, n3 ) );
+
+            THEN( "mirror leaves /2.1 and joins /4.3" )
+            {
+                REQUIRE( !nw->is_alias( make_alias_id( n11, a21 ) ) );
+                REQUIRE( nw->fetch_children( a21 ).empty() );
+                REQUIRE( REQUIRE_TRY( nw->fetch_children_ordered( a43 ) ) == UuidVec{ make_alias_id( n11, a43 ) } );
+                REQUIRE( nw->fetch_aliases( n11 ) == UuidSet{ make_alias_id( n11, a43 ) } );
+            }
+        }
+    }
+}
+
 // Note: 'children' should be unresolved. TODO: Actually, I suspect this is only a requirement for the precondition, which could always resolve all IDs. To confirm. I believe, when it comes to ordering, the resolved node is the only one used.
 auto Network::reorder_children( Uuid const& parent
                               , std::vector< Uuid > const& children )
@@ -2772,18 +3324,8 @@ auto Network::update_aliases( Uuid const& node )
 
     KMAP_ENSURE( exists( node ), error_code::common::uncategorized );
 
-    auto const rnode = resolve( node );
-    auto const db = KTRY( fetch_component< com::Database >() );
-
-    for( auto const& id : fetch_aliased_ancestry( rnode ) )
-    {
-        auto const dsts = KTRY( db->fetch_alias_destinations( id ) );
-
-        for( auto const& dst : dsts )
-        {
-            KTRY( update_alias( id, dst ) );
-        }
-    }
+    // Headings, bodies and orderings are read through to the source, so only `node`'s children need patching, and only in its aliases.
+    KTRY( sync_aliases( resolve( node ) ) );
 
     rv = outcome::success();
 
@@ -3097,7 +3639,11 @@ auto Network::is_lineal( Uuid const& ancestor
                        , Uuid const& descendant ) const
     -> bool
 {
-    return kmap::is_lineal( *this, ancestor, descendant );
+    auto const rv = ancestry_.is_lineal( ancestor, descendant, fetch_parent_fn() );
+
+    record_lineage( ancestor, descendant );
+
+    return rv;
 }
 
 auto Network::is_lineal( Uuid const& ancestor
@@ -3202,7 +3748,7 @@ auto Network::fetch_child( Uuid const& parent
     {
         for( auto const& e : fetch_children( parent ) )
         {
-            if( heading == KTRY( fetch_heading( e ) ) )
+            if( heading == KTRY( fetch_heading_view( e ) ) )
             {
                 rv = e;
 
@@ -3224,8 +3770,10 @@ auto Network::fetch_visible_nodes_from( Uuid const& id
                                       , unsigned const& vertical_max ) const
     -> std::vector< Uuid >
 { 
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_NODE( "node", id );
+
     auto rv = std::vector< Uuid >{};
-    auto const& km = kmap_inst();
 
     BC_CONTRACT()
         BC_PRE([ & ]
@@ -3244,26 +3792,45 @@ auto Network::fetch_visible_nodes_from( Uuid const& id
         })
     ;
 
-    auto const lineage = anchor::node( id )
-                       | view2::left_lineal
-                       | view2::order
-                       | act2::to_node_vec( km );
-    auto const limited_lineage = lineage
-                               | ranges::views::take_last( horizontal_max )
-                               | ranges::to< std::vector >();
+    auto const db = KTRYE( fetch_component< com::Database >() );
+    auto const generation = db->query_cache().generation();
+    auto const fetch_ordered = [ this ]( Uuid const& parent ){ return fetch_children_ordered( parent ); };
+    auto const limited_lineage = [ & ] // Root-most first.
+    {
+        auto lineage = UuidVec{};
+
+        for( auto next = Optional< Uuid >{ id }
+           ; next && lineage.size() < horizontal_max
+           ; next = to_optional( fetch_parent( next.value() ) ) )
+        {
+            lineage.emplace_back( next.value() );
+        }
+
+        return lineage | views::reverse | to< UuidVec >();
+    }();
 
     auto push = [ &rv ]( auto const& r ) mutable
     {
         rv.insert( rv.end(), r.begin(), r.end() );
     };
 
+    // Siblings are read from the parent's entry, so moving among siblings, or back up the lineage, refetches nothing.
     for( auto const& e : limited_lineage )
     {
-        auto const siblings_ordered = anchor::node( e )
-                                    | view2::sibling_incl
-                                    | view2::order
-                                    | act2::to_node_vec( km );
-        auto const limited_siblings = select_median_range( siblings_ordered, e, vertical_max );
+        auto const limited_siblings = [ & ]
+        {
+            if( auto const parent = fetch_parent( e )
+              ; parent )
+            {
+                auto const& entry = KTRYE( neighborhood_.fetch( parent.value(), generation, fetch_ordered ) ).get();
+
+                return select_window( entry.children, entry.positions.at( e ), vertical_max );
+            }
+            else
+            {
+                return UuidVec{ e };
+            }
+        }();
 
         if( e == id )
         {
@@ -3273,16 +3840,11 @@ auto Network::fetch_visible_nodes_from( Uuid const& id
 
                 if( sibling == id )
                 {
-                    auto const children_ordered = anchor::node( e )
-                                                | view2::child
-                                                | view2::order
-                                                | act2::to_node_vec( km );
-                    auto const limited_children = select_median_range( children_ordered, vertical_max );
+                    auto const& entry = KTRYE( neighborhood_.fetch( id, generation, fetch_ordered ) ).get();
 
-                    push( limited_children );
+                    push( select_window( entry.children, entry.children.size() / 2, vertical_max ) );
                 }
             }
-
         }
         else
         {
@@ -3384,6 +3946,20 @@ SCENARIO( "Network::fetch_visible_nodes_from", "[com][network]" )
 
                         REQUIRE( nv == UuidVec{ root, n1, n2, n3 } );
                     }
+
+                    WHEN( "/4 is created after f( 2, h:3, v:3 )" )
+                    {
+                        REQUIRE( nw->fetch_visible_nodes_from( n2, 3, 3 ) == UuidVec{ root, n1, n2, n3 } );
+
+                        auto const n4 = REQUIRE_TRY( nw->create_child( root, "4" ) );
+
+                        THEN( "f( 2, h:3, v:3 ): /, 1, 2, 3, 4" )
+                        {
+                            auto const nv = nw->fetch_visible_nodes_from( n2, 3, 3 );
+
+                            REQUIRE( nv == UuidVec{ root, n1, n2, n3, n4 } );
+                        }
+                    }
                 }
             }
         }
@@ -3408,7 +3984,10 @@ auto Network::create_child_aliases( Uuid const& src
     for( auto const items = astore.fetch_entries( AliasItem::rsrc_type{ src } )
        ; auto const& item : items )
     {
-        KTRY( create_alias_leaf( item.top().value(), child, item.alias() ) );
+        if( !astore.is_pending( item.alias() ) ) // Otherwise, `child` is mirrored when the alias is expanded.
+        {
+            KTRY( create_alias_leaf( item.top().value(), child, item.alias() ) );
+        }
     }
 
     rv = outcome::success();
@@ -3416,82 +3995,104 @@ auto Network::create_child_aliases( Uuid const& src
     return rv;
 }
 
-auto Network::is_alias( Uuid const& node ) const
-    -> bool
-{
-    return alias_store().is_alias( node );
-}
-
-auto Network::load_alias_leaf( Uuid const& top
-                             , Uuid const& src
-                             , Uuid const& dst
-                             , AliasLoadSet& all_aliases )
+auto Network::sync_aliases( Uuid const& node )
     -> Result< void >
 {
     KM_RESULT_PROLOG();
-        KM_RESULT_PUSH( "top", top );
-        KM_RESULT_PUSH( "src", src );
-        KM_RESULT_PUSH( "dst", dst );
-    
-    // fmt::print( "[load_alias_leaf][src]: {}\n", KTRY( fetch_heading( src ) ) );
-    // fmt::print( "[load_alias_leaf][dst]: {}, parent: {}\n", KTRY( fetch_heading( dst ) ), KTRY( fetch_heading( KTRY( fetch_parent( dst ) ) ) ) );
+        KM_RESULT_PUSH( "node", node );
 
-    auto rv = result::make_result< void >();
-    auto const rsrc = resolve( src );
-    auto const alias_item = make_alias_item( top, src, rsrc, dst );
+    auto rv = KMAP_MAKE_RESULT( void );
 
-    BC_CONTRACT()
-        BC_POST([ & ]
-        {
-            if( rv )
-            {
-                BC_ASSERT( fetch_parent( alias_item.alias() ).has_value() );
-                BC_ASSERT( fetch_parent( alias_item.alias() ).value() == dst );
-            }
-        })
-    ;
+    KMAP_ENSURE( exists( node ), error_code::network::invalid_node );
+    KMAP_ENSURE( !is_alias( node ), error_code::network::invalid_node );
 
-    KMAP_ENSURE( exists( rsrc ), error_code::network::invalid_node );
-    KMAP_ENSURE( exists( dst ), error_code::network::invalid_node );
+    auto const children = fetch_children( node );
+    auto changed = false;
 
-    auto const populate_src = [ & ]( auto const& ts ) -> Result< void >
+    for( auto const items = astore_.fetch_entries( AliasItem::rsrc_type{ node } )
+       ; auto const& item : items )
     {
-        // If "src has alias children", then "create those alias children", so the aliases exist when we need to reference them while populating another alias tree.
-        auto const& dv = all_aliases.get< AliasItem::dst_type >();
+        if( astore_.is_pending( item.alias() ) ) // Expansion will mirror the current children.
+        {
+            continue;
+        }
 
-        for( auto dst_er = dv.equal_range( AliasItem::dst_type{ ts } )
-           ; dst_er.first != dst_er.second
-           ; ++dst_er.first )
+        auto mirrors = UuidSet{};
+
+        for( auto const& child : children )
         {
-            auto const& td = *dst_er.first;
+            auto const mirror = KTRY( make_mirror_item( item, child ) );
 
-            if( !td.loaded() )
+            if( !astore_.is_alias( mirror.alias() ) )
             {
-                KTRY( load_alias_leaf( td.top().value(), td.rsrc().value(), td.dst().value(), all_aliases ) );
+                KTRY( astore_.push_alias( mirror ) );
+
+                changed = true;
             }
+
+            mirrors.emplace( mirror.alias() );
         }
+        for( auto const& stale : astore_.fetch_alias_children( item.alias() ) )
+        {
+            if( !mirrors.contains( stale ) )
+            {
+                KTRY( astore_.erase_alias( AliasItem::alias_type{ stale } ) ); // Its alias descendants go with it.
 
-        return outcome::success();
-    };
-    auto const denote_as_loaded = [ &all_aliases ]( auto const& alias_id )
+                changed = true;
+            }
+        }
+    }
+
+    if( changed )
+    {
+        KTRY( clear_query_cache() );
+        ancestry_.clear();
+    }
+
+    rv = outcome::success();
+
+    return rv;
+}
+
+auto Network::is_alias( Uuid const& node ) const
+    -> bool
+{
+    return alias_store().is_alias( node );
+}
+
+auto Network::materialize_aliases( Uuid const& node
+                                 , UuidSet& visited ) const
+    -> Result< void >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH( "node", node );
+
+    auto rv = KMAP_MAKE_RESULT( void );
+
+    if( visited.emplace( node ).second )
     {
-        auto& av = all_aliases.get< AliasItem::alias_type >();
-        auto const it = av.find( alias_id );
+        // Aliases of `node` are nested in the aliases of its parent and of its top aliases' destinations.
+        auto holders = UuidSet{};
 
-        if( it != av.end() ) // Root alias in this case.
+        if( auto const parent = fetch_parent( node )
+          ; parent )
         {
-            av.modify( it, []( auto& item ){ item.loaded_flag = true; } );
+            holders.emplace( parent.value() );
+        }
+        for( auto const& dst : astore_.fetch_dsts( AliasItem::rsrc_type{ node } ) )
+        {
+            holders.emplace( resolve( dst ) );
         }
-    };
 
-    KTRY( populate_src( rsrc ) );
-    denote_as_loaded( alias_item.alias() );
-    KTRY( astore_.push_alias( alias_item ) );
+        for( auto const& holder : holders )
+        {
+            KTRY( materialize_aliases( holder, visited ) );
 
-    for( auto const rchildren = fetch_children( rsrc )
-       ; auto const rchild : rchildren )
-    {
-        KTRY( load_alias_leaf( alias_item.top().value(), rchild, alias_item.alias(), all_aliases ) );
+            for( auto const& alias : astore_.fetch_aliases( AliasItem::rsrc_type{ holder } ) )
+            {
+                KTRY( expand_alias( alias ) );
+            }
+        }
     }
 
     rv = outcome::success();
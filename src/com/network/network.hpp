@@ -10,17 +10,42 @@
 #include "com/event/event_clerk.hpp"
 #include "com/option/option_clerk.hpp"
 #include "com/network/alias.hpp"
+#include "com/network/ancestry.hpp"
+#include "com/network/neighborhood.hpp"
 #include "common.hpp"
 #include "component.hpp"
 #include "utility.hpp"
 
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <memory>
+#include <vector>
 
 namespace kmap::com {
 
+class Database;
+
+/**
+ * @brief A node, along with its descendants, for Network::create_subtree.
+ */
+struct NodeSpec
+{
+    Uuid id = gen_uuid();
+    Heading heading = {};
+    Optional< Title > title = {}; // Defaults to format_title( heading ).
+    std::string body = {};
+    std::vector< NodeSpec > children = {};
+};
+
+/**
+ * @brief Parses an outline, one title per line, into NodeSpecs for Network::create_subtree. A line indented past the one before it is that line's child.
+ * @note Blank lines are skipped. A line must return to the indentation of an open ancestor or sibling, else the outline is refused.
+ */
+auto parse_outline( std::string_view const outline )
+    -> Result< std::vector< NodeSpec > >;
+
 /**
  * @note: It looks clean to store the JS Network instance as a member here, but the trouble is that emscripten lacks support for JS exception => C++, so any JS exception
  *        raised while execiting `js_new_->call()`s will result in an uncaught (read: cryptic) error lacking details. Is there a way aroud this?
@@ -29,11 +54,13 @@ namespace kmap::com {
  */
 class Network : public Component//< Database >
 {
-    AliasStore astore_ = {};
+    mutable AliasStore astore_ = {}; // Alias children are materialized by const fetches.
     // TODO: Q: Should selected_node_ be a thing? Or does the notion of a selected node only make sense in reference to a visual?
     //       A: I think it makes sense outside the context of a visual. For example, commands operate on the assumption that there's a "current_node".
     //          A visual could be used to change the current node, but the current node shouldn't be dependent on the visual.
     Uuid selected_node_ = Uuid{ 0 };
+    mutable AncestryIndex ancestry_ = {}; // Filled by const lineage queries.
+    mutable NeighborhoodCache neighborhood_ = {}; // Filled by fetch_visible_nodes_from().
 
 public:
     static constexpr auto id = "network";
@@ -75,6 +102,14 @@ public:
                      , Heading const& heading
                      , Title const& title )
         -> Result< Uuid >;
+    /**
+     * @brief Creates `nodes`, and their descendants, as children of `parent`, writing each parent's order once rather than per child.
+     * @return IDs of `nodes`, in order.
+     * @note The spec is validated in full before anything is written. Fires a single "subject.network, verb.created, object.subtree" event.
+     */
+    auto create_subtree( Uuid const& parent
+                       , std::vector< NodeSpec > const& nodes )
+        -> Result< UuidVec >;
     auto erase_node( Uuid const& id )
         -> Result< Uuid >;
     auto erase_attr( Uuid const& id )
@@ -95,6 +130,12 @@ public:
         -> Result< UuidVec >;
     auto fetch_heading( Uuid const& node ) const
         -> Result< Heading >;
+    /**
+     * @brief Borrowing counterpart of fetch_heading, for comparing headings without copying them.
+     * @note Valid until the database cache is next mutated.
+     */
+    auto fetch_heading_view( Uuid const& node ) const
+        -> Result< std::string_view >;
     // TODO [cleanup]: move to attr.hpp? Rather, node.genesis component?
         [[ nodiscard ]]
         auto fetch_genesis_time( Uuid const& id ) const
@@ -163,6 +204,11 @@ public:
     auto exist( Args const&... args ) const -> bool { return ( exists( args ) && ... ); } // Warning: arguments must be explicit for template deduction, so e.g., "/" must be Heading{ "/" }.
     auto fetch_above( Uuid const& id ) const
         -> Result< Uuid >;
+    /**
+     * @brief Returns every alias whose source is `node`, materializing those nested in aliases yet to be expanded.
+     */
+    auto fetch_aliases( Uuid const& node ) const
+        -> UuidSet;
     auto fetch_below( Uuid const& id ) const
         -> Result< Uuid >;
     auto fetch_child( Uuid const& parent 
@@ -238,10 +284,40 @@ public:
         -> Result< Uuid >;
 
 protected:
+    /**
+     * @note Alias store reads aren't tracked as query dependencies, so alias changes drop every cached query.
+     */
+    auto clear_query_cache()
+        -> Result< void >;
+    /**
+     * @brief Returns the Database requisite from its component slot, for read paths run per node.
+     */
+    auto database() const
+        -> Database const&;
+    auto fetch_parent_fn() const
+        -> AncestryIndex::FetchParentFn;
+    /**
+     * @brief Records, to any query being recorded, the nodes whose parents lineage from `ancestor` to `descendant` turned on.
+     * @note The ancestry index answers from memory, bypassing Database::fetch_parent and the recording it does, so a cached query would otherwise miss a move along the lineage.
+     */
+    auto record_lineage( Uuid const& ancestor
+                       , Uuid const& descendant ) const
+        -> void;
     auto create_alias_leaf( Uuid const& top
                           , Uuid const& src
                           , Uuid const& dst )
         -> Result< Uuid >;
+    /**
+     * @brief Materializes the alias children of `alias`, if not already, from the children of its source.
+     */
+    auto expand_alias( Uuid const& alias ) const
+        -> Result< void >;
+    /**
+     * @brief Returns the item mirroring `child`, a child of `parent`'s source, under `parent`.
+     */
+    auto make_mirror_item( AliasItem const& parent
+                         , Uuid const& child ) const
+        -> Result< AliasItem >;
     auto create_child_internal( Uuid const& parent
                               , Uuid const& child
                               , Heading const& heading
@@ -255,11 +331,19 @@ protected:
         -> Result< void >;
     auto erase_node_internal( Uuid const& id )
         -> Result< void >;
-    auto erase_node_leaf( Uuid const& id )
+    /**
+     * @brief Erases `id` along with its descendants, attribute trees, and dependent aliases, in one pass.
+     */
+    auto erase_node_subtree( Uuid const& id )
         -> Result< void >;
     auto create_child_aliases( Uuid const& parent
                              , Uuid const& child )
         -> Result< void >;
+    /**
+     * @brief Patches each expanded alias of `node` to mirror its current children, pushing missing and erasing stale mirrors.
+     */
+    auto sync_aliases( Uuid const& node )
+        -> Result< void >;
     [[ nodiscard ]]
     auto is_child_internal( Uuid const& parent
                           , Uuid const& id ) const
@@ -268,10 +352,11 @@ protected:
     auto is_child_internal( Uuid const& parent
                           , Heading const& id ) const
         -> bool;
-    auto load_alias_leaf( Uuid const& top
-                        , Uuid const& src
-                        , Uuid const& dst
-                        , AliasLoadSet& all_aliases )
+    /**
+     * @brief Expands every alias in which an alias of `node` would be nested.
+     */
+    auto materialize_aliases( Uuid const& node
+                            , UuidSet& visited ) const
         -> Result< void >;
 };
 
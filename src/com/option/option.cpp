@@ -8,6 +8,7 @@
 #include <cmd/command.hpp>
 #include <cmd/parser.hpp>
 #include <com/cmd/command.hpp>
+#include <com/database/db.hpp>
 #include <com/network/network.hpp>
 #include <contract.hpp>
 #include <error/master.hpp>
@@ -33,11 +34,33 @@ OptionStore::OptionStore( Kmap& km
 {
 }
 
+OptionStore::~OptionStore()
+{
+#if !KMAP_NATIVE
+    if( function_cache_subscription_ )
+    {
+        if( auto const db = component_slot< com::Database >()
+          ; db )
+        {
+            db->change_feed().unsubscribe( *function_cache_subscription_ );
+        }
+    }
+#endif // !KMAP_NATIVE
+}
+
 auto OptionStore::initialize()
     -> Result< void >
 {
+    KM_RESULT_PROLOG();
+
     auto rv = result::make_result< void >();
 
+#if !KMAP_NATIVE
+    auto const db = KTRY( fetch_component< com::Database >() );
+
+    function_cache_subscription_ = db->change_feed().subscribe( [ this ]( auto const& batch ){ function_cache_.erase_changed( batch ); } );
+#endif // !KMAP_NATIVE
+
     rv = outcome::success();
 
     return rv;
@@ -187,36 +210,42 @@ auto OptionStore::apply( Uuid const& option )
     auto const action = KTRY( nw->fetch_child( option, "action" ) );
     // auto const action_body = KTRY( action.fetch_body() );
     auto const action_body = KTRY( nw->fetch_body( action ) );
-    auto const code = cmd::parser::parse_body_code( action_body ).value();
     auto const value_node = KTRY( nw->fetch_child( option, "value" ) );
     auto const value_body = KTRY( nw->fetch_body( value_node ) );
-    // TODO: Use similar technique to cmd action to expose "option_value" automatically via fn arg.
-    // fmt::print( "option_store::apply: {}\n", km.absolute_path_flat( option ) );
-    KTRY( boost::apply_visitor( [ & ]( auto const& e ) -> Result< void > // Note: spirit::x3::variant uses boost::variant which is not compatible with std::visit.
-                                {
-                                    using T = std::decay_t< decltype( e ) >;
-
-                                    if constexpr( std::is_same_v< T, cmd::ast::Kscript > )
-                                    {
-                                        KMAP_THROW_EXCEPTION_MSG( "kscript is not supported in a guard node" );
-                                    }
-                                    else if constexpr( std::is_same_v< T, cmd::ast::Javascript > )
-                                    {
-                                        #if !KMAP_NATIVE
-                                        auto const opt_val = fmt::format( "let option_value = {};", value_body );
-                                        auto const pp = KTRYE( js::preprocess( e.code ) );
-
-                                        KTRY( js::eval_void( fmt::format( "{}\n{}", opt_val, pp ) ) );
-                                        #endif // !KMAP_NATIVE
-                                    }
-                                    else
-                                    {
-                                        static_assert( always_false< T >::value, "non-exhaustive visitor!" );
-                                    }
-
-                                    return outcome::success();
-                                }
-                            , code ) );
+
+#if !KMAP_NATIVE
+    auto const compile_action = [ & ]( std::string const& source ) -> Result< emscripten::val >
+    {
+        auto const code = KTRY( cmd::parser::parse_body_code( source ) );
+
+        return boost::apply_visitor( [ & ]( auto const& e ) -> Result< emscripten::val > // Note: spirit::x3::variant uses boost::variant which is not compatible with std::visit.
+                                     {
+                                         using T = std::decay_t< decltype( e ) >;
+
+                                         if constexpr( std::is_same_v< T, cmd::ast::Kscript > )
+                                         {
+                                             KMAP_THROW_EXCEPTION_MSG( "kscript is not supported in a guard node" );
+                                         }
+                                         else if constexpr( std::is_same_v< T, cmd::ast::Javascript > )
+                                         {
+                                             auto const pp = KTRY( js::preprocess( e.code ) );
+
+                                             return js::compile_void( { "option_value" }, pp );
+                                         }
+                                         else
+                                         {
+                                             static_assert( always_false< T >::value, "non-exhaustive visitor!" );
+                                         }
+                                     }
+                                   , code );
+    };
+    auto const compile_value = []( std::string const& source ){ return js::compile_val( {}, fmt::format( "return {};", source ) ); };
+    auto const action_fn = KTRY( function_cache_.fetch_or_compile( action, action_body, compile_action ) );
+    auto const value_fn = KTRY( function_cache_.fetch_or_compile( value_node, value_body, compile_value ) );
+    auto const option_value = KTRY( js::call_val( value_fn ) );
+
+    KTRY( js::call_void( action_fn, option_value ) );
+#endif // !KMAP_NATIVE
     
     rv = outcome::success();
 
@@ -274,7 +303,7 @@ using namespace std::string_literals;
 REGISTER_COMPONENT
 (
     kmap::com::OptionStore
-,   std::set({ "component_store"s, "root_node"s, "network"s })
+,   std::set({ "component_store"s, "database"s, "root_node"s, "network"s })
 ,   "option related functionality"
 );
 
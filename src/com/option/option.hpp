@@ -11,6 +11,10 @@
 #include <component.hpp>
 #include <path/node_view2.hpp>
 
+#if !KMAP_NATIVE
+#include <js/function_cache.hpp>
+#endif // !KMAP_NATIVE
+
 #include <string_view>
 
 namespace kmap
@@ -30,6 +34,11 @@ struct Option
 
 class OptionStore : public Component
 {
+#if !KMAP_NATIVE
+    js::FunctionCache function_cache_ = {}; // Compiled action and value bodies, keyed by node.
+    Optional< com::db::ChangeFeed::SubscriberId > function_cache_subscription_ = {}; // Drops entries of erased or re-bodied nodes.
+#endif // !KMAP_NATIVE
+
 public:
     static constexpr auto id = "option_store";
     constexpr auto name() const -> std::string_view override { return id; }
@@ -37,7 +46,7 @@ public:
     OptionStore( Kmap& km
                , std::set< std::string > const& requisites
                , std::string const& description );
-    virtual ~OptionStore() = default;
+    virtual ~OptionStore();
 
     auto initialize()
         -> Result< void > override;
@@ -70,6 +70,7 @@ namespace kmap {
             { \
                 using ComponentConstructor::ComponentConstructor; \
                 virtual auto construct( kmap::Kmap& km ) const -> std::shared_ptr< kmap::Component > override { return std::static_pointer_cast< kmap::Component >( std::make_shared< type >( km, requisites(), description() ) ); } \
+                virtual auto slot() const -> std::size_t override { return kmap::component_slot_index< type >(); } \
                 virtual ~KMAP_CONCAT( component_ctor, __LINE__ )() = default; \
             }; \
             auto cctor = std::make_shared< KMAP_CONCAT( component_ctor, __LINE__ ) >( type::id, reqs, desc ); \
@@ -94,6 +95,7 @@ namespace kmap {
                 { \
                     using ComponentConstructor::ComponentConstructor; \
                     virtual auto construct( kmap::Kmap& km ) const -> std::shared_ptr< kmap::Component > override { return std::static_pointer_cast< kmap::Component >( std::make_shared< type >( km, requisites(), description() ) ); } \
+                    virtual auto slot() const -> std::size_t override { return kmap::component_slot_index< type >(); } \
                     virtual ~KMAP_CONCAT( component_ctor, __LINE__ )() = default; \
                 }; \
                 auto cctor = std::make_shared< KMAP_CONCAT( component_ctor, __LINE__ ) >( type::id, reqs, desc ); \
@@ -163,6 +165,16 @@ public:
     {
         return kmap_inst().fetch_component< Component >();
     }
+    template< typename Component >
+    auto component_slot()
+    {
+        return kmap_inst().component_slot< Component >();
+    }
+    template< typename Component >
+    auto component_slot() const
+    {
+        return kmap_inst().component_slot< Component >();
+    }
 };
 
 class ComponentConstructor
@@ -198,6 +210,7 @@ public:
     }
 
     // std::shared_ptr< T > type = std::make_shared< T >{};
+    virtual auto slot() const -> std::size_t = 0; // component_slot_index< T >() of the constructed type.
     virtual auto construct( Kmap& kmap ) const -> std::shared_ptr< Component > = 0; // This means that each component needs a Starter and Component. Maybe the Starter can be automated...
 };
 
@@ -5,11 +5,15 @@
  ******************************************************************************/
 #include "component_store.hpp"
 
+#include "com/network/network.hpp"
 #include "component.hpp"
 #include "contract.hpp"
 #include "kmap.hpp"
+#include "test/util.hpp"
 #include "util/result.hpp"
 
+#include <catch2/catch_test_macros.hpp>
+
 #include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/algorithm/count_if.hpp>
 #include <range/v3/algorithm/find_if.hpp>
@@ -17,11 +21,24 @@
 #include <range/v3/view/map.hpp>
 
 #include <set>
+#include <utility>
 
 namespace rvs = ranges::views;
 
 namespace kmap {
 
+namespace detail {
+
+auto next_component_slot()
+    -> std::size_t
+{
+    static auto next = std::size_t{ 0 };
+
+    return next++;
+}
+
+} // namespace detail
+
 ComponentStore::ComponentStore( Kmap& km )
     : km_{ km }
 {
@@ -145,6 +162,12 @@ auto ComponentStore::erase_component( ComponentPtr const com )
         KTRY( erase_component( ranges::find_if( initialized_components_, depends_on_com )->second ) );
     }
 
+    if( auto const it = registered_components_.find( std::string{ com->name() } )
+      ; it != registered_components_.end() )
+    {
+        fill_slot( it->second->slot(), nullptr );
+    }
+
     initialized_components_.erase( std::string{ com->name() } );
 
     rv = outcome::success();
@@ -152,6 +175,18 @@ auto ComponentStore::erase_component( ComponentPtr const com )
     return rv;
 }
 
+auto ComponentStore::fill_slot( std::size_t const index
+                              , Component* const com )
+    -> void
+{
+    if( index >= slots_.size() )
+    {
+        slots_.resize( index + 1, nullptr );
+    }
+
+    slots_[ index ] = com;
+}
+
 // Q: Can I install a component_store_outlet?
 auto ComponentStore::install_standard_events()
     -> Result< void >
@@ -231,6 +266,7 @@ auto ComponentStore::fire_initialized( std::string const& id )
         }
 
         initialized_components_.emplace( name, com );
+        fill_slot( cctor->slot(), com.get() );
 
         if( uninitialized_components_.contains( name ) )
         {
@@ -277,6 +313,7 @@ auto ComponentStore::fire_loaded( std::string const& id )
         KM_LOG_MSG( "[component.store]", fmt::format( "loaded: {}\n", name ) );
 
         initialized_components_.emplace( name, com );
+        fill_slot( cctor->slot(), com.get() );
 
         if( uninitialized_components_.contains( name ) )
         {
@@ -291,4 +328,20 @@ auto ComponentStore::fire_loaded( std::string const& id )
     return rv;
 }
 
+SCENARIO( "ComponentStore::component_slot tracks initialized components", "[component_store]" )
+{
+    KMAP_COMPONENT_FIXTURE_SCOPED( "network" );
+
+    auto& km = Singleton::instance();
+    auto& cstore = km.component_store();
+
+    THEN( "slot holds the initialized component" )
+    {
+        auto const nw = REQUIRE_TRY( km.fetch_component< com::Network >() );
+
+        REQUIRE( cstore.component_slot< com::Network >() == nw.get() );
+        REQUIRE( std::as_const( cstore ).component_slot< com::Network >() == nw.get() );
+    }
+}
+
 } // namespace kmap
@@ -15,6 +15,7 @@
 #include <set>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace kmap
 {
@@ -25,6 +26,25 @@ namespace kmap
 
 namespace kmap {
 
+namespace detail {
+
+auto next_component_slot()
+    -> std::size_t;
+
+} // namespace detail
+
+/**
+ * @brief Dense index of component type `T` into ComponentStore's slot table, assigned on first use.
+ */
+template< typename T >
+auto component_slot_index()
+    -> std::size_t
+{
+    static auto const index = detail::next_component_slot();
+
+    return index;
+}
+
 class ComponentStore
 {
     using ComponentPtr = std::shared_ptr< Component >;
@@ -37,6 +57,7 @@ class ComponentStore
     std::map< std::string, ComponentCtorPtr > registered_components_ = {};
     std::map< std::string, ComponentCtorPtr > uninitialized_components_ = {};
     ComponentMap initialized_components_ = {};
+    std::vector< Component* > slots_ = {}; // Indexed by component_slot_index< T >(). Non-owning views of `initialized_components_`.
 
 public:
     ComponentStore( Kmap& km );
@@ -52,6 +73,26 @@ public:
         -> std::map< std::string, ComponentCtorPtr > const&;
     auto clear()
         -> Result< void >;
+    /**
+     * @brief Non-owning counterpart of fetch_component, for hot paths: a slot load, free of lookup, cast, and refcount.
+     * @note Null unless `T` is initialized. A component's requisites are erased only after it, so a pointer to a requisite outlives the component holding it.
+     */
+    template< typename T >
+    auto component_slot()
+        -> T*
+    {
+        auto const index = component_slot_index< T >();
+
+        return index < slots_.size() ? static_cast< T* >( slots_[ index ] ) : nullptr;
+    }
+    template< typename T >
+    auto component_slot() const
+        -> T const*
+    {
+        auto const index = component_slot_index< T >();
+
+        return index < slots_.size() ? static_cast< T const* >( slots_[ index ] ) : nullptr;
+    }
     auto erase_component( ComponentPtr const com )
         -> Result< void >;
     auto fire_initialized( std::string const& id )
@@ -127,6 +168,11 @@ public:
 
         return rv;
     }
+
+protected:
+    auto fill_slot( std::size_t const index
+                  , Component* const com )
+        -> void;
 };
 
 } // namespace kmap
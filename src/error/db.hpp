@@ -23,6 +23,7 @@ enum class db
 ,   erase_failed
 ,   entry_not_found
 ,   update_failed
+,   schema_mismatch
 };
 
 } // namespace kmap::error_code
@@ -60,6 +61,7 @@ public:
         case db::erase_failed: return "erase failed";
         case db::entry_not_found: return "entry not found";
         case db::update_failed: return "update failed";
+        case db::schema_mismatch: return "schema mismatch";
         }
     }
 };
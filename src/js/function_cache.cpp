@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#include <js/function_cache.hpp>
+
+#include <com/database/query_cache.hpp>
+#include <js/iface.hpp>
+#include <test/util.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string_view>
+
+namespace kmap::js {
+
+auto FunctionCache::clear()
+    -> void
+{
+    entries_.clear();
+}
+
+auto FunctionCache::erase( Uuid const& key )
+    -> void
+{
+    entries_.erase( key );
+}
+
+auto FunctionCache::erase_changed( com::db::ChangeFeed::Batch const& batch )
+    -> void
+{
+    using namespace com::db;
+
+    for( auto const& change : batch )
+    {
+        if( change.table == table_index< BodyTable >
+         || ( change.table == table_index< NodeTable > && change.kind == ChangeKind::erased ) )
+        {
+            erase( change.node );
+        }
+    }
+}
+
+auto FunctionCache::fetch_or_compile( Uuid const& key
+                                    , std::string const& source
+                                    , CompileFn const& compile )
+    -> Result< emscripten::val >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_NODE( "key", key );
+
+    auto rv = KMAP_MAKE_RESULT( emscripten::val );
+    auto const source_hash = std::hash< std::string_view >{}( source );
+
+    if( auto const it = entries_.find( key )
+      ; it != entries_.end() && it->second.source_hash == source_hash )
+    {
+        rv = it->second.fn;
+    }
+    else
+    {
+        auto const fn = KTRY( compile( source ) );
+
+        entries_.insert_or_assign( key, Entry{ .source_hash = source_hash, .fn = fn } );
+
+        rv = fn;
+    }
+
+    return rv;
+}
+
+auto FunctionCache::size() const
+    -> std::size_t
+{
+    return entries_.size();
+}
+
+SCENARIO( "FunctionCache recompiles only changed sources", "[js][function_cache]" )
+{
+    auto cache = FunctionCache{};
+    auto const key = gen_uuid();
+    auto compiled = 0;
+    auto const compile = [ & ]( std::string const& source )
+    {
+        ++compiled;
+
+        return compile_val( {}, source );
+    };
+
+    GIVEN( "compiled source" )
+    {
+        auto const fn = REQUIRE_TRY( cache.fetch_or_compile( key, "return 1;", compile ) );
+
+        REQUIRE( compiled == 1 );
+        REQUIRE( REQUIRE_TRY( call_val( fn ) ).as< int >() == 1 );
+
+        WHEN( "fetched with same source" )
+        {
+            auto const fn2 = REQUIRE_TRY( cache.fetch_or_compile( key, "return 1;", compile ) );
+
+            THEN( "stored function is returned" )
+            {
+                REQUIRE( compiled == 1 );
+                REQUIRE( REQUIRE_TRY( call_val( fn2 ) ).as< int >() == 1 );
+            }
+        }
+        WHEN( "fetched with changed source" )
+        {
+            auto const fn2 = REQUIRE_TRY( cache.fetch_or_compile( key, "return 2;", compile ) );
+
+            THEN( "source is recompiled" )
+            {
+                REQUIRE( compiled == 2 );
+                REQUIRE( cache.size() == 1 );
+                REQUIRE( REQUIRE_TRY( call_val( fn2 ) ).as< int >() == 2 );
+            }
+        }
+        WHEN( "its node's body changes" )
+        {
+            cache.erase_changed( { com::db::Change{ .node = key, .table = com::db::table_index< com::db::BodyTable >, .kind = com::db::ChangeKind::updated } } );
+
+            THEN( "the entry is dropped" )
+            {
+                REQUIRE( cache.size() == 0 );
+            }
+        }
+        WHEN( "its node is erased" )
+        {
+            cache.erase_changed( { com::db::Change{ .node = key, .table = com::db::table_index< com::db::NodeTable >, .kind = com::db::ChangeKind::erased } } );
+
+            THEN( "the entry is dropped" )
+            {
+                REQUIRE( cache.size() == 0 );
+            }
+        }
+        WHEN( "another of its node's tables changes" )
+        {
+            cache.erase_changed( { com::db::Change{ .node = key, .table = com::db::table_index< com::db::HeadingTable >, .kind = com::db::ChangeKind::updated } } );
+
+            THEN( "the entry is kept" )
+            {
+                REQUIRE( cache.size() == 1 );
+            }
+        }
+    }
+}
+
+} // namespace kmap::js
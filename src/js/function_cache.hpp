@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#pragma once
+#ifndef KMAP_JS_FUNCTION_CACHE_HPP
+#define KMAP_JS_FUNCTION_CACHE_HPP
+
+#include <com/database/change_feed.hpp>
+#include <common.hpp>
+#include <util/result.hpp>
+
+#include <emscripten/val.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+
+namespace kmap::js {
+
+/**
+ * @brief Functions compiled from node bodies (e.g., outlet and option actions), so that running an unchanged body is a call, rather than a parse, preprocess, lint, and eval.
+ * @note An entry is recompiled whenever the hash of the source it was compiled from differs from that of the source given.
+ *       Entries of erased nodes, or of nodes whose bodies changed, are dropped via erase_changed(), fed by the database's change feed.
+ */
+class FunctionCache
+{
+    struct Entry
+    {
+        std::size_t source_hash = {};
+        emscripten::val fn = emscripten::val::undefined();
+    };
+
+    std::map< Uuid, Entry > entries_ = {};
+
+public:
+    using CompileFn = std::function< Result< emscripten::val >( std::string const& source ) >;
+
+    auto clear()
+        -> void;
+    auto erase( Uuid const& key )
+        -> void;
+    /**
+     * @brief Erases the entries of nodes erased, or whose bodies were updated or erased, in `batch`.
+     */
+    auto erase_changed( com::db::ChangeFeed::Batch const& batch )
+        -> void;
+    auto fetch_or_compile( Uuid const& key
+                         , std::string const& source
+                         , CompileFn const& compile )
+        -> Result< emscripten::val >;
+    auto size() const
+        -> std::size_t;
+};
+
+} // namespace kmap::js
+
+#endif // KMAP_JS_FUNCTION_CACHE_HPP
@@ -228,50 +228,95 @@ SCENARIO( "js::move_element", "[js_iface]" )
     }
 }
 
-auto eval_val( std::string const& expr )
-    -> Result< emscripten::val >
-{
-    using emscripten::val;
-
-    KM_RESULT_PROLOG();
-        KM_RESULT_PUSH( "expr", expr );
+namespace {
 
-    auto rv = KMAP_MAKE_RESULT( val ); 
-    auto constexpr script =
+/**
+ * Function of `{}` params, with `{}` body, guarded s.t. exceptions thrown within are reported and `undefined` returned, rather than unwinding through C++ frames.
+ */
+auto constexpr guarded_function =
 R"%%%(
-(
-    function()
+function( {} )
+{{
+    try
     {{
-        try
-        {{
-            {}
-        }}
-        catch( err )
+        {}
+    }}
+    catch( err )
+    {{
+        if( is_cpp_exception( err ) )
         {{
-            if( is_cpp_exception( err ) )
+            if( kmap.is_signal_exception( err ) )
             {{
-                if( kmap.is_signal_exception( err ) )
-                {{
-                    console.log( 'signal exception recieved' );
-                    throw err;
-                }}
-                else
-                {{
-                    console.error( '[kmap][error] std::exception encountered:' );
-                    // print std exception
-                    kmap.print_std_exception( err );
-                }}
+                console.log( 'signal exception recieved' );
+                throw err;
             }}
-            else // Javascript exception
+            else
             {{
-                console.error( '\n[kmap][error] JS exception: ' + err + '\n' );
+                console.error( '[kmap][error] std::exception encountered:' );
+                // print std exception
+                kmap.print_std_exception( err );
             }}
-            return undefined;
         }}
+        else // Javascript exception
+        {{
+            console.error( '\n[kmap][error] JS exception: ' + err + '\n' );
+        }}
+        return undefined;
     }}
-)();
+}}
 )%%%";
-    auto const eval_str = io::format( script, expr );
+
+auto compile_function( std::vector< std::string > const& params
+                     , std::string const& body )
+    -> Result< emscripten::val >
+{
+    using emscripten::val;
+
+    KM_RESULT_PROLOG();
+
+    auto rv = KMAP_MAKE_RESULT( val );
+    auto const joined_params = params
+                             | views::join( ',' )
+                             | to< std::string >();
+    auto const fn = KTRY( eval_val( io::format( "return {};", io::format( guarded_function, joined_params, body ) ) ) );
+
+    KMAP_ENSURE( fn.typeOf().as< std::string >() == "function", error_code::js::eval_failed );
+
+    rv = fn;
+
+    return rv;
+}
+
+} // namespace anonymous
+
+auto compile_val( std::vector< std::string > const& params
+                , std::string const& body )
+    -> Result< emscripten::val >
+{
+    KM_RESULT_PROLOG();
+
+    return KTRY( compile_function( params, body ) );
+}
+
+auto compile_void( std::vector< std::string > const& params
+                 , std::string const& body )
+    -> Result< emscripten::val >
+{
+    KM_RESULT_PROLOG();
+
+    return KTRY( compile_function( params, fmt::format( "{}\nreturn kmap.eval_success();", body ) ) );
+}
+
+auto eval_val( std::string const& expr )
+    -> Result< emscripten::val >
+{
+    using emscripten::val;
+
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH( "expr", expr );
+
+    auto rv = KMAP_MAKE_RESULT( val ); 
+    auto const eval_str = io::format( "( {} )();", io::format( guarded_function, "", expr ) );
 
     KMAP_ENSURE( lint( eval_str ), error_code::js::lint_failed );
 
@@ -34,6 +34,19 @@ auto create_child_element( std::string const& parent_id
 auto create_html_canvas( std::string const& id )
     -> Result< void >;
 #if !KMAP_NATIVE
+/**
+ * @brief Compiles `body`, expected to return a value, into a function of `params`, to be invoked via call_val().
+ * @note Exceptions are handled within the function as for eval_val(). Linting occurs once, here, rather than per call.
+ */
+auto compile_val( std::vector< std::string > const& params
+                , std::string const& body )
+    -> Result< emscripten::val >;
+/**
+ * @brief Compiles `body` into a function of `params`, to be invoked via call_void().
+ */
+auto compile_void( std::vector< std::string > const& params
+                 , std::string const& body )
+    -> Result< emscripten::val >;
 auto eval_val( std::string const& expr )
     -> Result< emscripten::val >;
 #endif // !KMAP_NATIVE
@@ -122,6 +135,43 @@ auto call_rvoid( std::string const& name
     return outcome::success();
 }
 
+template< typename... Args >
+auto call_val( emscripten::val const& fn
+             , Args&&... args )
+    -> Result< emscripten::val >
+{
+    using emscripten::val;
+
+    KM_RESULT_PROLOG();
+
+    auto rv = KMAP_MAKE_RESULT( val );
+    auto const res = fn( std::forward< Args >( args )... );
+
+    KMAP_ENSURE_MSG( !res.isNull() && !res.isUndefined(), error_code::js::eval_failed, "compiled function failed to return a result" );
+
+    rv = res;
+
+    return rv;
+}
+
+template< typename... Args >
+auto call_void( emscripten::val const& fn
+              , Args&&... args )
+    -> Result< void >
+{
+    using emscripten::val;
+
+    KM_RESULT_PROLOG();
+
+    auto const res = KTRY( call_val( fn, std::forward< Args >( args )... ) );
+    auto const eval_succ_ref = val::global( "kmap" )[ "EvalSuccess" ];
+
+    KMAP_ENSURE( eval_succ_ref.as< bool >(), error_code::js::eval_failed );
+    KMAP_ENSURE( res.instanceof( eval_succ_ref ), error_code::js::eval_failed );
+
+    return outcome::success();
+}
+
 template< typename RT >
 auto eval( std::string const& expr )
     -> Result< RT >
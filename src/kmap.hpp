@@ -54,6 +54,16 @@ public:
     {
         return component_store().fetch_component< Component >();
     }
+    template< typename Component >
+    auto component_slot()
+    {
+        return component_store().component_slot< Component >();
+    }
+    template< typename Component >
+    auto component_slot() const
+    {
+        return component_store().component_slot< Component >();
+    }
     auto has_component_system(){ return component_store_ != nullptr; } // Hack...?
     // TODO: Belongs in com::ResourceStore. Actually unused for now, but can lay dormant there.
         [[ maybe_unused ]]
@@ -467,7 +467,7 @@ struct [[ deprecated( "Use PathDeciderSm instead" ) ]] HeadingPathSm
 
                 auto const node_and_aliases = [ & ]
                 {
-                    auto all = nw->alias_store().fetch_aliases( com::AliasItem::rsrc_type{ nid } );
+                    auto all = nw->fetch_aliases( nid );
 
                     all.emplace( nid );
 
@@ -826,7 +826,7 @@ auto complete_any( Kmap const& kmap
 
         auto const node_and_aliases = [ & ]
         {
-            auto all = nw->alias_store().fetch_aliases( com::AliasItem::rsrc_type{ nid } );
+            auto all = nw->fetch_aliases( nid );
 
             all.emplace( nid );
 
@@ -1323,9 +1323,11 @@ auto fetch_descendants( Kmap const& kmap
     KM_RESULT_PROLOG();
         KM_RESULT_PUSH_NODE( "root", root );
 
-    auto const nw = KTRY( kmap.fetch_component< com::Network >() );
+    auto const nw = kmap.component_slot< com::Network >();
     auto rs = UuidSet{};
 
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
     if( auto const children = nw->fetch_children( root )
       ; !children.empty() )
     {
@@ -1520,7 +1522,7 @@ auto disambiguate_path( Kmap const& km
         auto combined = nonaliases;
         for( auto const& e : nonaliases )
         {
-            auto const dsts = nw->alias_store().fetch_aliases( com::AliasItem::rsrc_type{ e } );
+            auto const dsts = nw->fetch_aliases( e );
             
             combined.insert( dsts.begin(), dsts.end() );
         }
@@ -1814,30 +1816,7 @@ auto is_lineal( com::Network const& nw
               , Uuid const& descendant )
     -> bool
 {
-    auto child = descendant;
-    auto parent = nw.fetch_parent( child );
-
-    while( parent )
-    {
-        if( child == ancestor )
-        {
-            return true;
-        }
-        else
-        {
-            child = parent.value();
-            parent = nw.fetch_parent( child );
-        }
-    }
-
-    if( child == ancestor ) // Account for .root being ancestor.
-    {
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+    return nw.is_lineal( ancestor, descendant );
 }
 
 auto is_lineal( com::Network const& nw
@@ -218,9 +218,11 @@ auto fetch_descendants( KMap const& kmap
         KM_RESULT_PUSH_NODE( "root", root );
 
     auto rv = kmap::result::make_result< UuidSet >();
-    auto const nw = KTRY( kmap.template fetch_component< com::Network >() );
+    auto const nw = kmap.template component_slot< com::Network >(); // Per node, so skips fetch_component's lookup.
     auto matches = UuidSet{};
 
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
     if( pred( root ) )
     {
         matches.emplace( root );
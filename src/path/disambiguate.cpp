@@ -213,7 +213,7 @@ auto disambiguate_path3( Kmap const& km
         auto combined = nonaliases;
         for( auto const& e : nonaliases )
         {
-            auto const dsts = nw->alias_store().fetch_aliases( com::AliasItem::rsrc_type{ e } );
+            auto const dsts = nw->fetch_aliases( e );
             
             combined.insert( dsts.begin(), dsts.end() );
         }
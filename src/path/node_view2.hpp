@@ -87,23 +87,15 @@ auto operator|( TetherCT< AnchorType, TailLink > const& tether
     -> TetherCT< AnchorType, NextLink >
 {
     auto nlink = link;
+    auto root = Link::LinkPtr{ std::make_unique< TailLink >( tether.tail_link ) };
 
-    if( auto prev = std::ref( nlink.prev() )
-      ; prev.get() )
+    if( link.prev() )
     {
-        auto last = prev;
-
-        while( prev.get() )
-        {
-            last = prev;
-            prev = std::ref( prev.get()->prev() );
-        }
-
-        last.get()->prev( { std::make_unique< TailLink >( tether.tail_link ) } );
+        nlink.prev( Link::LinkPtr{ link.prev()->graft( std::move( root ) ) } );
     }
     else
     {
-        nlink.prev( { std::make_unique< TailLink >( tether.tail_link ) } );
+        nlink.prev( std::move( root ) );
     }
 
     return TetherCT< AnchorType, NextLink >{ tether.anchor, nlink };
@@ -37,7 +37,7 @@ auto operator|( Tether const& lhs
     BC_CONTRACT()
         BC_PRE([ & ]
         {
-            BC_ASSERT( lhs.anchor );
+            BC_ASSERT( lhs.anchor() );
         })
         BC_POST([ & ]
         {
@@ -49,9 +49,9 @@ auto operator|( Tether const& lhs
     ;
 
     auto const ctx = FetchContext{ rhs.km, lhs };
-    auto const av = lhs.anchor->fetch( ctx );
+    auto const av = lhs.anchor()->fetch( ctx );
 
-    if( !lhs.tail_link )
+    if( !lhs.tail_link() )
     {
         KMAP_ENSURE( av.size() == 1, error_code::common::uncategorized );
 
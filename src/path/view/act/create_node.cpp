@@ -49,11 +49,11 @@ auto operator|( Tether const& lhs
     else
     {
         auto const fctx = FetchContext{ rhs.km, lhs };
-        auto ns = lhs.anchor->fetch( fctx );
+        auto ns = lhs.anchor()->fetch( fctx );
         auto const links = [ & ]
         {
             auto rlinks = std::deque< Link::LinkPtr >{};
-            auto link = lhs.tail_link;
+            auto link = lhs.tail_link();
             while( link )
             {
                 rlinks.emplace_front( link );
@@ -82,7 +82,7 @@ auto operator|( Tether const& lhs
                 //       user desires only a single output.
                 KMAP_ENSURE( ns.size() == 1, error_code::common::uncategorized );
 
-                DerivationLink& dlink = KTRY( result::dyn_cast< DerivationLink >( link.get() ) );
+                DerivationLink const& dlink = KTRY( result::dyn_cast< DerivationLink const >( link.get() ) );
 
                 auto const cs = KTRY( dlink.create( CreateContext{ rhs.km, fctx.tether }, ns.begin()->id ) );
 
@@ -47,11 +47,11 @@ auto operator|( Tether const& lhs
     else
     {
         auto const fctx = FetchContext{ rhs.km, lhs };
-        auto ns = lhs.anchor->fetch( fctx );
+        auto ns = lhs.anchor()->fetch( fctx );
         auto const links = [ & ]
         {
             auto rlinks = std::deque< Link::LinkPtr >{};
-            auto link = lhs.tail_link;
+            auto link = lhs.tail_link();
             while( link )
             {
                 rlinks.emplace_front( link );
@@ -77,7 +77,7 @@ auto operator|( Tether const& lhs
             {
                 // TODO: One major difficulty: what happens if create fails? The whole operation should undo - but I don't have facilities for that at this point.
 
-                DerivationLink& dlink = KTRY( result::dyn_cast< DerivationLink >( link.get() ) );
+                DerivationLink const& dlink = KTRY( result::dyn_cast< DerivationLink const >( link.get() ) );
 
                 KMAP_ENSURE( ns.size() == 1, error_code::common::uncategorized ); // TODO: Is it true that ns.size always makes sense to be 1?
 
@@ -11,6 +11,7 @@
 #include <kmap.hpp>
 #include <path/view/anchor/anchor.hpp>
 #include <path/view/derivation_link.hpp>
+#include <path/view/optimize.hpp>
 #include <path/view/transformation_link.hpp>
 
 #include <catch2/catch_test_macros.hpp>
@@ -40,57 +41,63 @@ auto operator|( Tether const& lhs
     auto const db = KTRY( rhs.ctx.km.fetch_component< com::Database >() );
     auto& qcache = db->query_cache();
 
-    if( auto const qr = qcache.fetch( lhs )
+    if( auto qr = qcache.fetch( lhs )
       ; qr )
     {
-        rv = qr.value();
+        rv = std::move( qr ).value();
     }
     else
     {
-        auto fs = lhs.anchor->fetch( rhs.ctx );
-        auto const links = [ & ]
+        // Cached under the tether as written; evaluated as rewritten, from the anchor set the planner has already fetched.
+        auto anchored = lhs.anchor()->fetch( rhs.ctx );
+        auto const plan = KTRY( optimize( rhs.ctx, lhs, anchored ) );
+        auto const eval = [ & ]() -> Result< FetchSet >
         {
-            auto rlinks = std::deque< Link::LinkPtr >{};
-            auto link = lhs.tail_link;
-            while( link )
-            {
-                rlinks.emplace_front( link );
-                link = link->prev();
-            }
-            return rlinks;
-        }();
-
-        for( auto const& link : links )
-        {
-            auto next_fs = decltype( fs ){};
+            KM_RESULT_PROLOG();
 
-            if( auto const tlink = result::dyn_cast< view2::TransformationLink const >( link.get() )
-              ; tlink )
+            auto fs = std::move( anchored );
+            auto const links = [ & ]
             {
-                TransformationLink const& tlinkv = tlink.value();
+                auto rlinks = std::deque< Link::LinkPtr >{};
+                auto link = plan.tail_link();
+                while( link )
+                {
+                    rlinks.emplace_front( link );
+                    link = link->prev();
+                }
+                return rlinks;
+            }();
 
-                next_fs = KTRY( tlinkv.fetch( rhs.ctx, fs ) );
-            }
-            else 
+            for( auto const& link : links )
             {
-                for( auto const& node : fs )
+                auto next_fs = decltype( fs ){};
+
+                if( auto const tlink = result::dyn_cast< view2::TransformationLink const >( link.get() )
+                  ; tlink )
                 {
-                    auto const tfs = KTRY( fetch( link, rhs.ctx, node.id ) );
+                    TransformationLink const& tlinkv = tlink.value();
 
-                    next_fs.insert( tfs.begin(), tfs.end() );
+                    next_fs = KTRY( tlinkv.fetch( rhs.ctx, fs ) );
+                }
+                else 
+                {
+                    next_fs = KTRY( fetch( link, rhs.ctx, fs ) ); // Whole frontier at once.
                 }
+
+                fs = std::move( next_fs );
             }
 
-            fs = next_fs;
-        }
+            return fs;
+        };
 
-        {
-            auto const ns = fs;
-            KTRYE( const_cast< com::db::QueryCache& >( qcache ).push( lhs, ns ) ); // TODO: WARNING FLAGS!!! VERY TEMPORARY! const_cast a no-no!
-            KMAP_ENSURE_EXCEPT( qcache.fetch( lhs ) );
-        }
+        // Reads made while evaluating are recorded, so the result is dropped only when something it read changes.
+        auto recording = com::db::ScopedRecording{ qcache };
+        auto fs = eval();
+        auto const deps = recording.end();
+
+        rv = KTRY( std::move( fs ) ); // Intermediate sets are handed off by move; the only copy made is the one the cache retains.
 
-        rv = fs;
+        KTRYE( const_cast< com::db::QueryCache& >( qcache ).push( lhs, rv, deps ) ); // TODO: WARNING FLAGS!!! VERY TEMPORARY! const_cast a no-no!
     }
 
     return rv;
@@ -47,9 +47,8 @@ auto operator|( Tether const& lhs
     auto rv = result::make_result< UuidVec >();
     auto const ctx = FetchContext{ rhs.km, lhs };
     auto const fs = KTRY( lhs | to_fetch_set( ctx ) );
-    auto const& fsv = fs.get< random_access_index >();
 
-    rv = fsv
+    rv = fs
         | rvs::transform( []( auto const& e ){ return e.id; } )
         | ranges::to< UuidVec >();
 
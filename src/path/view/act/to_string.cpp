@@ -55,16 +55,16 @@ auto operator|( Tether const& lhs
               , ToString const& rhs )
     -> std::string
 {
-    if( lhs.tail_link )
+    if( lhs.tail_link() )
     {
         return fmt::format( "{}|{}"
-                        , lhs.anchor->to_string()
-                        , ( *lhs.tail_link ) | to_string );
+                        , lhs.anchor()->to_string()
+                        , ( *lhs.tail_link() ) | to_string );
     }
     else
     {
         return fmt::format( "{}"
-                          , lhs.anchor->to_string() );
+                          , lhs.anchor()->to_string() );
     }
 }
 
@@ -14,6 +14,7 @@
 #include <path/view/anchor/node.hpp>
 #include <path/view/parent.hpp>
 #include <path/view/resolve.hpp>
+#include <path/view/semi_join.hpp>
 #include <path/view/tether.hpp>
 #include <test/util.hpp>
 
@@ -115,6 +116,102 @@ auto Alias::fetch( FetchContext const& ctx
     }
 }
 
+auto Alias::fetch( FetchContext const& ctx
+                 , FetchSet const& fs ) const
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< FetchSet >();
+
+    if( pred_ )
+    {
+        rv = KTRY( DerivationLink::fetch( ctx, fs ) );
+    }
+    else
+    {
+        auto const nw = ctx.km.component_slot< com::Network >();
+
+        KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+        auto aliases = FetchSet{};
+
+        for( auto const& node : fs )
+        {
+            for( auto const& c : nw->fetch_children( node.id ) )
+            {
+                if( nw->is_alias( c ) )
+                {
+                    aliases.emplace( LinkNode{ .id = c } );
+                }
+            }
+        }
+
+        rv = aliases;
+    }
+
+    return rv;
+}
+
+auto Alias::fetch_sources( FetchContext const& ctx
+                         , Optional< FetchSet > const& targets ) const
+    -> Result< Optional< FetchSet > >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Optional< FetchSet > >();
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto reach = Optional< FetchSet >{}; // Candidate aliases; link and tether predicates are left to run forward.
+
+    if( pred_ )
+    {
+        if( auto const p = std::get_if< char const* >( &pred_.value() ) )
+        {
+            reach = KTRY( fetch_headed( ctx, *p, targets ) );
+        }
+        else if( auto const p = std::get_if< std::string >( &pred_.value() ) )
+        {
+            reach = KTRY( fetch_headed( ctx, *p, targets ) );
+        }
+        else if( auto const p = std::get_if< Uuid >( &pred_.value() ) )
+        {
+            reach = narrow( FetchSet{ LinkNode{ .id = *p } }, targets );
+        }
+    }
+    else
+    {
+        reach = targets;
+    }
+
+    if( reach )
+    {
+        auto parents = FetchSet{};
+
+        for( auto const& e : reach.value() )
+        {
+            if( nw->is_alias( e.id ) )
+            {
+                if( auto const parent = nw->fetch_parent( e.id )
+                  ; parent )
+                {
+                    parents.emplace( LinkNode{ .id = parent.value() } );
+                }
+            }
+        }
+
+        rv = Optional< FetchSet >{ parents };
+    }
+    else
+    {
+        rv = Optional< FetchSet >{};
+    }
+
+    return rv;
+}
+
 SCENARIO( "view::Alias::fetch", "[node_view][alias]" )
 {
     KMAP_COMPONENT_FIXTURE_SCOPED( "root_node", "network" );
@@ -11,6 +11,7 @@
 #include "path/view/child.hpp"
 #include "path/view/common.hpp"
 #include "path/view/direct_desc.hpp"
+#include "path/view/semi_join.hpp"
 #include "test/util.hpp"
 #include "util/result.hpp"
 
@@ -37,7 +38,7 @@ auto AllOf::create( CreateContext const& ctx
     for( auto const& ls = links()
        ; auto const& link : ls )
     {
-        DerivationLink& dlink = KTRY( result::dyn_cast< DerivationLink >( link.get() ) );
+        DerivationLink const& dlink = KTRY( result::dyn_cast< DerivationLink const >( link.get() ) );
         if( ctx.option.skip_existing ) // e.g., fetch_or_create
         {
             if( auto const fc = KTRY( dlink.fetch( FetchContext{ ctx.km, ctx.tether }, root ) )
@@ -86,6 +87,60 @@ auto AllOf::fetch( FetchContext const& ctx
     return rset;
 }
 
+auto AllOf::fetch_sources( FetchContext const& ctx
+                         , Optional< FetchSet > const& targets ) const
+    -> Result< Optional< FetchSet > >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Optional< FetchSet > >();
+    auto sources = Optional< FetchSet >{}; // Satisfying every link.
+    auto reaching = Optional< FetchSet >{}; // Reaching `targets` through some link.
+
+    for( auto const& ls = links()
+       ; auto const& link : ls )
+    {
+        auto const satisfying = KTRY( view2::fetch_satisfying( ctx, *link, sources ) );
+
+        if( !satisfying )
+        {
+            rv = Optional< FetchSet >{};
+
+            return rv;
+        }
+
+        sources = satisfying;
+
+        if( targets )
+        {
+            auto const reached = KTRY( view2::fetch_sources( ctx, *link, targets ) );
+
+            if( !reached )
+            {
+                rv = Optional< FetchSet >{};
+
+                return rv;
+            }
+
+            if( !reaching )
+            {
+                reaching = FetchSet{};
+            }
+
+            reaching.value().insert( reached.value().begin(), reached.value().end() );
+        }
+    }
+
+    if( sources && reaching )
+    {
+        sources = narrow( sources.value(), reaching );
+    }
+
+    rv = sources;
+
+    return rv;
+}
+
 SCENARIO( "view::AllOf::fetch", "[node_view][all_of]" )
 {
     KMAP_COMPONENT_FIXTURE_SCOPED( "root_node", "network" );
@@ -48,6 +48,7 @@ public:
 
 protected:
     auto compare_less( Link const& rhs ) const -> bool override;
+    auto own_fingerprint() const -> Fingerprint override { return fingerprint_of( typeid( *this ), pred_ ); }
 };
 
 auto const ancestor = Ancestor{};
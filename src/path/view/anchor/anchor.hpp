@@ -27,7 +27,12 @@ public:
     virtual auto clone() const -> std::unique_ptr< Anchor > = 0;
     virtual auto fetch( FetchContext const& ctx ) const -> FetchSet = 0;
     virtual auto to_string() const -> std::string = 0;
+    /**
+     * @brief Structural hash of this anchor. Defaults to the anchor's type; anchors with state combine it in.
+     */
+    virtual auto fingerprint() const -> Fingerprint { return make_fingerprint( typeid( *this ).name() ); }
     auto operator<( Anchor const& other ) const -> bool { return compare_less( other ); }
+    auto operator==( Anchor const& other ) const -> bool { return !compare_less( other ) && !other.compare_less( *this ); }
 
     // operator Tether() const { return Tether{ clone() }; }
 
@@ -24,6 +24,12 @@ auto Node::fetch( FetchContext const& ctx ) const
          | ranges::to< FetchSet >();
 }
 
+auto Node::fingerprint() const
+    -> Fingerprint
+{
+    return fingerprint_of( typeid( *this ), nodes );
+}
+
 auto Node::to_string() const
     -> std::string
 {
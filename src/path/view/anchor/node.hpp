@@ -26,6 +26,7 @@ public:
 
     auto clone() const -> std::unique_ptr< Anchor > override { return { std::make_unique< std::decay_t< decltype( *this ) > >( *this ) }; }
     auto fetch( FetchContext const& ctx ) const -> FetchSet override;
+    auto fingerprint() const -> Fingerprint override;
     auto to_string() const -> std::string override;
 
 protected:
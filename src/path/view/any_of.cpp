@@ -11,10 +11,18 @@
 #include "path/view/child.hpp"
 #include "path/view/common.hpp"
 #include "path/view/direct_desc.hpp"
+#include "path/view/semi_join.hpp"
 #include "test/util.hpp"
 #include "util/result.hpp"
 
 #include <catch2/catch_test_macros.hpp>
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/join.hpp>
+#include <range/v3/view/transform.hpp>
+
+#include <string>
+
+namespace rvs = ranges::views;
 
 namespace kmap::view2 {
 
@@ -50,6 +58,35 @@ auto AnyOf::fetch( FetchContext const& ctx
     return rset;
 }
 
+auto AnyOf::fetch_sources( FetchContext const& ctx
+                         , Optional< FetchSet > const& targets ) const
+    -> Result< Optional< FetchSet > >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Optional< FetchSet > >();
+    auto sources = FetchSet{};
+
+    for( auto const& ls = links()
+       ; auto const& link : ls )
+    {
+        auto const reached = KTRY( view2::fetch_sources( ctx, *link, targets ) );
+
+        if( !reached )
+        {
+            rv = Optional< FetchSet >{};
+
+            return rv;
+        }
+
+        sources.insert( reached.value().begin(), reached.value().end() );
+    }
+
+    rv = Optional< FetchSet >{ sources };
+
+    return rv;
+}
+
 auto AnyOf::new_link() const
     -> std::unique_ptr< Link >
 {
@@ -62,7 +99,12 @@ auto AnyOf::to_string() const
     if( auto const& ls = links()
       ; !ls.empty() )
     {
-        return "any_of( 'TODO' )";
+        auto const lstrs = ls
+                         | rvs::transform( [ & ]( auto const& lp ){ return *lp | act::to_string; } )
+                         | rvs::join( ',' )
+                         | ranges::to< std::string >();
+
+        return fmt::format( "any_of( {} )", lstrs );
     }
     else
     {
@@ -49,6 +49,33 @@ auto Attr::fetch( FetchContext const& ctx
     return rv;
 }
 
+auto Attr::fetch( FetchContext const& ctx
+                , FetchSet const& fs ) const
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< FetchSet >();
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto attrs = FetchSet{};
+
+    for( auto const& node : fs )
+    {
+        if( auto const attr = nw->fetch_attr_node( node.id )
+          ; attr )
+        {
+            attrs.emplace( LinkNode{ .id = attr.value() } );
+        }
+    }
+
+    rv = attrs;
+
+    return rv;
+}
+
 SCENARIO( "view::Attr::fetch", "[node_view][attr]" )
 {
     KMAP_COMPONENT_FIXTURE_SCOPED( "root_node", "network" );
@@ -6,6 +6,7 @@
 #include "path/view/child.hpp"
 
 #include "com/network/network.hpp"
+#include "path/view/semi_join.hpp"
 #include "util/result.hpp"
 #include <contract.hpp>
 
@@ -83,7 +84,7 @@ auto Child::fetch( FetchContext const& ctx
                 auto const children = KTRY( view2::child.fetch( ctx, node ) );
 
                 return children
-                     | rvs::filter( [ & ]( auto const& e ){ return pred == KTRYE( nw->fetch_heading( e.id ) ); } )
+                     | rvs::filter( [ & ]( auto const& e ){ return pred == KTRYE( nw->fetch_heading_view( e.id ) ); } )
                      | ranges::to< FetchSet >();
             }
         ,   [ & ]( Uuid const& pred ) -> Result< FetchSet >
@@ -117,6 +118,120 @@ auto Child::fetch( FetchContext const& ctx
     }
 }
 
+auto Child::fetch( FetchContext const& ctx
+                 , FetchSet const& fs ) const
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< FetchSet >();
+
+    if( pred_ && std::holds_alternative< LinkPtr >( pred_.value() ) )
+    {
+        rv = KTRY( DerivationLink::fetch( ctx, fs ) );
+    }
+    else
+    {
+        auto const nw = ctx.km.component_slot< com::Network >();
+
+        KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+        auto const heading = [ & ]() -> Optional< std::string >
+        {
+            if( pred_ )
+            {
+                if( auto const p = std::get_if< char const* >( &pred_.value() ) ){ return std::string{ *p }; }
+                if( auto const p = std::get_if< std::string >( &pred_.value() ) ){ return *p; }
+            }
+
+            return boost::none;
+        }();
+        auto const id = pred_ ? std::get_if< Uuid >( &pred_.value() ) : nullptr;
+        auto children = FetchSet{};
+
+        for( auto const& node : fs )
+        {
+            for( auto const& c : nw->fetch_children( node.id ) )
+            {
+                if( ( !id || c == *id )
+                 && ( !heading || heading.value() == KTRYE( nw->fetch_heading_view( c ) ) ) )
+                {
+                    children.emplace( LinkNode{ .id = c } );
+                }
+            }
+        }
+
+        rv = children;
+    }
+
+    return rv;
+}
+
+auto Child::fetch_sources( FetchContext const& ctx
+                         , Optional< FetchSet > const& targets ) const
+    -> Result< Optional< FetchSet > >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Optional< FetchSet > >();
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto reach = Optional< FetchSet >{}; // Children satisfying the predicate.
+
+    if( pred_ )
+    {
+        auto dispatch = util::Dispatch
+        {
+            [ & ]( char const* pred ) -> Result< Optional< FetchSet > >
+            {
+                return Optional< FetchSet >{ KTRY( fetch_headed( ctx, pred, targets ) ) };
+            }
+        ,   [ & ]( std::string const& pred ) -> Result< Optional< FetchSet > >
+            {
+                return Optional< FetchSet >{ KTRY( fetch_headed( ctx, pred, targets ) ) };
+            }
+        ,   [ & ]( Uuid const& pred ) -> Result< Optional< FetchSet > >
+            {
+                return Optional< FetchSet >{ narrow( FetchSet{ LinkNode{ .id = pred } }, targets ) };
+            }
+        ,   [ & ]( LinkPtr const& pred ) -> Result< Optional< FetchSet > >
+            {
+                return KTRY( fetch_satisfying( ctx, *pred, targets ) );
+            }
+        };
+
+        reach = KTRY( std::visit( dispatch, pred_.value() ) );
+    }
+    else
+    {
+        reach = targets;
+    }
+
+    if( reach )
+    {
+        auto parents = FetchSet{};
+
+        for( auto const& e : reach.value() )
+        {
+            if( auto const p = nw->fetch_parent( e.id )
+              ; p )
+            {
+                parents.emplace( LinkNode{ .id = p.value() } );
+            }
+        }
+
+        rv = Optional< FetchSet >{ parents };
+    }
+    else
+    {
+        rv = Optional< FetchSet >{};
+    }
+
+    return rv;
+}
+
 auto Child::new_link() const
     -> std::unique_ptr< Link >
 {
@@ -8,15 +8,11 @@
 #define KMAP_PATH_NODE_VIEW2_COMMON_HPP
 
 #include <common.hpp>
+#include <path/view/fetch_set.hpp>
 
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/random_access_index.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index_container.hpp>
-
+#include <cstdint>
 #include <memory>
-
-namespace bmi = boost::multi_index;
+#include <string_view>
 
 namespace kmap {
     class Kmap;
@@ -24,20 +20,34 @@ namespace kmap {
 
 namespace kmap::view2 {
 
-struct LinkNode
+/**
+ * @brief Structural hash of an anchor, link chain, or tether. Equal structures share a fingerprint; the converse needn't hold.
+ */
+using Fingerprint = std::uint64_t;
+
+/**
+ * @note 64-bit FNV-1a, so fingerprints are the same width on wasm32 as elsewhere.
+ */
+constexpr auto make_fingerprint( std::string_view const s )
+    -> Fingerprint
 {
-    Uuid id = {};
+    auto rv = Fingerprint{ 0xcbf29ce484222325ull };
 
-    std::strong_ordering operator<=>( LinkNode const& ) const = default;
-};
-struct random_access_index {};
+    for( auto const c : s )
+    {
+        rv ^= static_cast< unsigned char >( c );
+        rv *= 0x100000001b3ull;
+    }
+
+    return rv;
+}
 
-using FetchSet = bmi::multi_index_container< LinkNode 
-                                           , bmi::indexed_by< bmi::hashed_unique< bmi::tag< decltype( LinkNode::id ) > // TODO: Shouldn't this tag be unordered_index? And the other tag ordered_index?
-                                                                                , bmi::member< LinkNode
-                                                                                             , decltype( LinkNode::id )
-                                                                                             , &LinkNode::id > >
-                                                            , bmi::random_access< bmi::tag< random_access_index > > > >;
+constexpr auto combine_fingerprints( Fingerprint const seed
+                                   , Fingerprint const v )
+    -> Fingerprint
+{
+    return seed ^ ( v + 0x9e3779b97f4a7c15ull + ( seed << 12 ) + ( seed >> 4 ) );
+}
 
 class Tether;
 
@@ -5,11 +5,58 @@
  ******************************************************************************/
 #include <path/view/derivation_link.hpp>
 
+#include <com/network/network.hpp>
+#include <kmap.hpp>
+#include <path/view/alias.hpp>
+#include <path/view/anchor/node.hpp>
+#include <path/view/attr.hpp>
+#include <path/view/child.hpp>
+#include <path/view/desc.hpp>
+#include <path/view/parent.hpp>
+#include <path/view/resolve.hpp>
+#include <path/view/sibling.hpp>
+#include <path/view/tether.hpp>
+#include <test/util.hpp>
+
 #include <catch2/catch_test_macros.hpp>
 
 namespace kmap::view2
 {
 
+auto DerivationLink::fetch( FetchContext const& ctx
+                          , FetchSet const& fs ) const
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< FetchSet >();
+    auto merged = FetchSet{};
+
+    for( auto const& node : fs )
+    {
+        auto const nfs = KTRY( fetch( ctx, node.id ) );
+
+        merged.insert( nfs.begin(), nfs.end() );
+    }
+
+    rv = merged;
+
+    return rv;
+}
+
+auto DerivationLink::fetch_sources( FetchContext const& ctx
+                                  , Optional< FetchSet > const& targets ) const
+    -> Result< Optional< FetchSet > >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Optional< FetchSet > >();
+
+    rv = Optional< FetchSet >{};
+
+    return rv;
+}
+
 auto fetch( Link const* link
           , FetchContext const& ctx
           , Uuid const& node )
@@ -27,7 +74,7 @@ auto fetch( Link const* link
     return rv;
 }
 
-auto fetch( PolymorphicValue< Link > const& plink
+auto fetch( Link::LinkPtr const& plink
           , FetchContext const& ctx
           , Uuid const& node )
     -> Result< FetchSet >
@@ -35,4 +82,75 @@ auto fetch( PolymorphicValue< Link > const& plink
     return fetch( plink.get(), ctx, node );
 }
 
+auto fetch( Link const* link
+          , FetchContext const& ctx
+          , FetchSet const& fs )
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH( "fs.size", fs.size() );
+
+    auto rv = result::make_result< FetchSet >();
+
+    DerivationLink const& dlink = KTRY( result::dyn_cast< DerivationLink const >( link ) );
+
+    rv = KTRY( dlink.fetch( ctx, fs ) );
+
+    return rv;
+}
+
+auto fetch( Link::LinkPtr const& plink
+          , FetchContext const& ctx
+          , FetchSet const& fs )
+    -> Result< FetchSet >
+{
+    return fetch( plink.get(), ctx, fs );
+}
+
+SCENARIO( "DerivationLink batched fetch matches node-by-node fetch", "[node_view][link]" )
+{
+    KMAP_COMPONENT_FIXTURE_SCOPED( "root_node", "network" );
+
+    auto& km = Singleton::instance();
+    auto const nw = REQUIRE_TRY( km.fetch_component< com::Network >() );
+    auto const root = nw->root_node();
+    auto const n1 = REQUIRE_TRY( nw->create_child( root, "1" ) );
+    auto const n2 = REQUIRE_TRY( nw->create_child( root, "2" ) );
+    auto const n11 = REQUIRE_TRY( nw->create_child( n1, "1" ) );
+    auto const n111 = REQUIRE_TRY( nw->create_child( n11, "1" ) );
+    auto const n21 = REQUIRE_TRY( nw->create_child( n2, "1" ) );
+    auto const a12 = REQUIRE_TRY( nw->create_alias( n2, n1 ) );
+    auto const tether = Tether{ anchor::node( root ) };
+    auto const ctx = FetchContext{ km, tether };
+    auto const frontier = FetchSet{ LinkNode{ .id = root }, LinkNode{ .id = n1 }, LinkNode{ .id = n2 }, LinkNode{ .id = n11 }, LinkNode{ .id = n111 }, LinkNode{ .id = n21 }, LinkNode{ .id = a12 } };
+    auto const to_set = []( FetchSet const& fs )
+    {
+        auto rs = UuidSet{};
+
+        for( auto const& e : fs )
+        {
+            rs.emplace( e.id );
+        }
+
+        return rs;
+    };
+    auto const check = [ & ]( DerivationLink const& link )
+    {
+        auto const batched = REQUIRE_TRY( link.fetch( ctx, frontier ) );
+        auto const by_node = REQUIRE_TRY( link.DerivationLink::fetch( ctx, frontier ) );
+
+        return to_set( batched ) == to_set( by_node );
+    };
+
+    REQUIRE( check( view2::child ) );
+    REQUIRE( check( view2::child( "1" ) ) );
+    REQUIRE( check( view2::child( n11 ) ) );
+    REQUIRE( check( view2::parent ) );
+    REQUIRE( check( view2::attr ) );
+    REQUIRE( check( view2::alias ) );
+    REQUIRE( check( view2::desc ) );
+    REQUIRE( check( view2::sibling_incl ) );
+    REQUIRE( check( view2::resolve ) );
+}
+
 } // namespace kmap::view2
@@ -26,16 +26,34 @@ public:
 
     virtual auto create( CreateContext const& ctx, Uuid const& root ) const -> Result< UuidSet > = 0;
     virtual auto fetch( FetchContext const& ctx, Uuid const& root ) const -> Result< FetchSet > = 0;
+    /**
+     * @brief Set-at-a-time counterpart of fetch( ctx, root ): the union of fetching each node of `fs`.
+     * @note Defaults to fetching node by node. Overridden where a frontier can be fetched more cheaply as a whole.
+     */
+    virtual auto fetch( FetchContext const& ctx, FetchSet const& fs ) const -> Result< FetchSet >;
+    /**
+     * @brief The link walked backwards: nodes `n` for which fetch( ctx, n ) is nonempty and, given `targets`, meets `targets`.
+     * @note Returns none where that set is unbounded (e.g., unpredicated `child` sans `targets`) or the link can't be walked backwards. Defaults to none.
+     */
+    virtual auto fetch_sources( FetchContext const& ctx, Optional< FetchSet > const& targets ) const -> Result< Optional< FetchSet > >;
 };
 
 auto fetch( Link const* link
           , FetchContext const& ctx
           , Uuid const& node )
     -> Result< FetchSet >;
-auto fetch( PolymorphicValue< Link > const& plink
+auto fetch( Link::LinkPtr const& plink
           , FetchContext const& ctx
           , Uuid const& node )
     -> Result< FetchSet >;
+auto fetch( Link const* link
+          , FetchContext const& ctx
+          , FetchSet const& fs )
+    -> Result< FetchSet >;
+auto fetch( Link::LinkPtr const& plink
+          , FetchContext const& ctx
+          , FetchSet const& fs )
+    -> Result< FetchSet >;
 
 } // namespace kmap::view2
 
@@ -10,10 +10,16 @@
 #include "kmap.hpp"
 #include "path.hpp"
 #include "path/act/value_or.hpp"
+#include "path/node_view2.hpp"
+#include "path/view/child.hpp"
+#include "path/view/optimize.hpp"
+#include "path/view/semi_join.hpp"
 #include "test/util.hpp"
 #include "util/result.hpp"
+#include "utility.hpp"
 
 #include <catch2/catch_test_macros.hpp>
+#include <range/v3/range/conversion.hpp>
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/transform.hpp>
 
@@ -21,6 +27,79 @@ namespace rvs = ranges::views;
 
 namespace kmap::view2 {
 
+namespace {
+
+// One walk for the whole frontier: a subtree shared by several frontier nodes is visited once.
+auto fetch_frontier_descendants( FetchContext const& ctx
+                               , FetchSet const& fs )
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< FetchSet >();
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto descs = FetchSet{};
+    auto pending = fs
+                 | rvs::transform( []( auto const& e ){ return e.id; } )
+                 | ranges::to< UuidVec >();
+
+    while( !pending.empty() )
+    {
+        auto const next = pending.back();
+
+        pending.pop_back();
+
+        for( auto const& c : nw->fetch_children( next ) )
+        {
+            if( descs.emplace( LinkNode{ .id = c } ).second )
+            {
+                pending.emplace_back( c );
+            }
+        }
+    }
+
+    rv = descs;
+
+    return rv;
+}
+
+// As optimize's desc | q rule: testing `pred` forward from each descendant costs the subtree's size; by semi-join, each satisfying node walks up toward the frontier.
+auto favors_semi_join( FetchContext const& ctx
+                     , Link const& pred
+                     , FetchSet const& fs )
+    -> Result< bool >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< bool >();
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto const cm = KTRY( make_cost_model( ctx ) );
+
+    if( auto const sources = estimate_sources( cm, pred )
+      ; sources )
+    {
+        auto const subtree = fs.contains( nw->root_node() )
+                           ? cm.nodes
+                           : static_cast< double >( fs.size() ) * cm.subtree;
+
+        rv = sources.value() * cm.depth < subtree;
+    }
+    else
+    {
+        rv = false;
+    }
+
+    return rv;
+}
+
+} // namespace
+
 auto Desc::create( CreateContext const& ctx
                  , Uuid const& root ) const
     -> Result< UuidSet >
@@ -44,7 +123,6 @@ auto Desc::fetch( FetchContext const& ctx
             }
         ,   [ & ]( std::string const& pred ) -> Result< FetchSet >
             {
-                auto const nw = KTRY( ctx.km.fetch_component< com::Network >() );
                 auto const dns = decide_path( ctx.km, node, node, pred ) | view::act::value_or( UuidVec{} );
                 auto const tform = [ & ]( auto const& c )
                 {
@@ -56,7 +134,9 @@ auto Desc::fetch( FetchContext const& ctx
             }
         ,   [ & ]( Uuid const& pred ) -> Result< FetchSet >
             {
-                auto const nw = KTRY( ctx.km.fetch_component< com::Network >() );
+                auto const nw = ctx.km.component_slot< com::Network >();
+
+                KMAP_ENSURE( nw, error_code::common::uncategorized );
 
                 if( is_ancestor( *nw, node, pred ) )
                 {
@@ -69,12 +149,7 @@ auto Desc::fetch( FetchContext const& ctx
             }
         ,   [ & ]( LinkPtr const& pred ) -> Result< FetchSet >
             {
-                auto const nw = KTRY( ctx.km.fetch_component< com::Network >() );
-                auto const descs = KTRY( desc.fetch( ctx, node ) );
-
-                return descs 
-                     | rvs::filter( [ & ]( auto const& c ){ return anchor::node( c.id ) | pred | act2::exists( ctx.km ); } )
-                     | ranges::to< FetchSet >();
+                return KTRY( fetch( ctx, FetchSet{ LinkNode{ .id = node } } ) ); // A frontier of one, so the strategy is decided by the same cost check.
             }
         };
 
@@ -82,7 +157,6 @@ auto Desc::fetch( FetchContext const& ctx
     }
     else
     {
-        auto const nw = KTRY( ctx.km.fetch_component< com::Network >() );
         auto const descs = KTRY( fetch_descendants( ctx.km, node ) );
 
         return descs
@@ -91,10 +165,174 @@ auto Desc::fetch( FetchContext const& ctx
     }
 }
 
+auto Desc::fetch( FetchContext const& ctx
+                , FetchSet const& fs ) const
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< FetchSet >();
+
+    if( pred_ )
+    {
+        if( auto const p = std::get_if< LinkPtr >( &pred_.value() )
+          ; p )
+        {
+            auto const& pred = **p;
+            auto const satisfying = KTRY( favors_semi_join( ctx, pred, fs ) )
+                                  ? KTRY( fetch_satisfying( ctx, pred ) )
+                                  : Optional< FetchSet >{};
+
+            if( satisfying )
+            {
+                // Found once for the frontier; what lies below it is kept.
+                rv = KTRY( filter_descendants( ctx, fs, satisfying.value() ) );
+            }
+            else
+            {
+                auto const descs = KTRY( fetch_frontier_descendants( ctx, fs ) );
+
+                rv = descs 
+                   | rvs::filter( [ & ]( auto const& c ){ return anchor::node( c.id ) | *p | act2::exists( ctx.km ); } )
+                   | ranges::to< FetchSet >();
+            }
+        }
+        else
+        {
+            rv = KTRY( DerivationLink::fetch( ctx, fs ) );
+        }
+    }
+    else
+    {
+        rv = KTRY( fetch_frontier_descendants( ctx, fs ) );
+    }
+
+    return rv;
+}
+
+auto Desc::fetch_sources( FetchContext const& ctx
+                        , Optional< FetchSet > const& targets ) const
+    -> Result< Optional< FetchSet > >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Optional< FetchSet > >();
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto reach = Optional< FetchSet >{}; // Descendants satisfying the predicate; headings are left to decide_path.
+
+    if( pred_ )
+    {
+        if( auto const p = std::get_if< Uuid >( &pred_.value() ) )
+        {
+            reach = narrow( FetchSet{ LinkNode{ .id = *p } }, targets );
+        }
+        else if( auto const p = std::get_if< LinkPtr >( &pred_.value() ) )
+        {
+            reach = KTRY( fetch_satisfying( ctx, **p, targets ) );
+        }
+    }
+    else
+    {
+        reach = targets;
+    }
+
+    if( reach )
+    {
+        auto ancestors = FetchSet{};
+
+        for( auto const& e : reach.value() )
+        {
+            for( auto parent = to_optional( nw->fetch_parent( e.id ) )
+               ; parent
+               ; parent = to_optional( nw->fetch_parent( parent.value() ) ) )
+            {
+                if( !ancestors.emplace( LinkNode{ .id = parent.value() } ).second )
+                {
+                    break; // The rest of the lineage was walked from an earlier node.
+                }
+            }
+        }
+
+        rv = Optional< FetchSet >{ ancestors };
+    }
+    else
+    {
+        rv = Optional< FetchSet >{};
+    }
+
+    return rv;
+}
+
 SCENARIO( "view::Desc::fetch", "[node_view][desc]" )
 {
     KMAP_COMPONENT_FIXTURE_SCOPED( "root_node", "network" );
 
+    auto& km = Singleton::instance();
+    auto const nw = REQUIRE_TRY( km.fetch_component< com::Network >() );
+    auto const root = nw->root_node();
+
+    GIVEN( "/1.2.x, /1.3, /4.x" )
+    {
+        auto const n1 = REQUIRE_TRY( nw->create_child( root, "1" ) );
+        auto const n12 = REQUIRE_TRY( nw->create_child( n1, "2" ) );
+        REQUIRE_TRY( nw->create_child( n12, "x" ) );
+        REQUIRE_TRY( nw->create_child( n1, "3" ) );
+        auto const n4 = REQUIRE_TRY( nw->create_child( root, "4" ) );
+        REQUIRE_TRY( nw->create_child( n4, "x" ) );
+
+        auto const forward = [ & ]( Uuid const& node )
+        {
+            return REQUIRE_TRY( fetch_descendants( km, node ) )
+                 | rvs::filter( [ & ]( auto const& e ){ return anchor::node( e ) | view2::child( "x" ) | act2::exists( km ); } )
+                 | ranges::to< UuidSet >();
+        };
+
+        THEN( "desc( child( 'x' ) ) agrees with testing each descendant, from a small subtree and from root" )
+        {
+            REQUIRE(( anchor::node( n1 ) | view2::desc( view2::child( "x" ) ) | act2::to_node_set( km ) ) == forward( n1 ));
+            REQUIRE(( anchor::node( root ) | view2::desc( view2::child( "x" ) ) | act2::to_node_set( km ) ) == forward( root ));
+            REQUIRE(( anchor::node( root ) | view2::desc( view2::child( "x" ) ) | act2::to_node_set( km ) ) == UuidSet{ n12, n4 });
+        }
+        THEN( "a frontier of several nodes agrees with its nodes taken one at a time" )
+        {
+            auto const both = anchor::node( UuidSet{ n1, n4 } ) | view2::desc( view2::child( "x" ) ) | act2::to_node_set( km );
+            auto expected = forward( n1 );
+
+            expected.merge( forward( n4 ) );
+
+            REQUIRE( both == expected );
+        }
+    }
+    GIVEN( "/a.m.b, /o, and a cached desc( b ) from a" )
+    {
+        auto const na = REQUIRE_TRY( nw->create_child( root, "a" ) );
+        auto const nm = REQUIRE_TRY( nw->create_child( na, "m" ) );
+        auto const nb = REQUIRE_TRY( nw->create_child( nm, "b" ) );
+        auto const no = REQUIRE_TRY( nw->create_child( root, "o" ) );
+
+        REQUIRE(( anchor::node( na ) | view2::desc( nb ) | act2::to_node_set( km ) ) == UuidSet{ nb });
+
+        WHEN( "b's body changes, dropping the entry, and it's re-cached from the warm lineage index" )
+        {
+            REQUIRE_TRY( nw->update_body( nb, "changed" ) );
+            REQUIRE(( anchor::node( na ) | view2::desc( nb ) | act2::to_node_set( km ) ) == UuidSet{ nb });
+
+            WHEN( "m is moved out from under a" )
+            {
+                REQUIRE_TRY( nw->move_node( nm, no ) );
+
+                THEN( "b is no longer a descendant of a" )
+                {
+                    REQUIRE(( anchor::node( na ) | view2::desc( nb ) | act2::to_node_set( km ) ).empty() );
+                    REQUIRE(( anchor::node( no ) | view2::desc( nb ) | act2::to_node_set( km ) ) == UuidSet{ nb });
+                }
+            }
+        }
+    }
+
     // auto& km = Singleton::instance();
     // auto const nw = REQUIRE_TRY( km.fetch_component< com::Network >() );
     // auto const root = nw->root_node();
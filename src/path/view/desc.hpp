@@ -36,12 +36,15 @@ public:
     auto clone() const -> std::unique_ptr< Link > override { return { std::make_unique< std::decay_t< decltype( *this ) > >( *this ) }; }
     auto create( CreateContext const& ctx, Uuid const& root ) const -> Result< UuidSet > override;
     auto fetch( FetchContext const& ctx, Uuid const& node ) const -> Result< FetchSet > override;
+    auto fetch( FetchContext const& ctx, FetchSet const& fs ) const -> Result< FetchSet > override;
+    auto fetch_sources( FetchContext const& ctx, Optional< FetchSet > const& targets ) const -> Result< Optional< FetchSet > > override;
     auto new_link() const -> std::unique_ptr< Link > override;
     auto pred() const -> std::optional< PredVariant > const& { return pred_; }
     auto to_string() const -> std::string override;
 
 protected:
     auto compare_less( Link const& rhs ) const -> bool override;
+    auto own_fingerprint() const -> Fingerprint override { return fingerprint_of( typeid( *this ), pred_ ); }
 };
 
 auto const desc = Desc{};
@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#include <path/view/fetch_set.hpp>
+
+#include <contract.hpp>
+#include <utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <range/v3/algorithm/all_of.hpp>
+#include <range/v3/algorithm/find_if.hpp>
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/iota.hpp>
+#include <range/v3/view/transform.hpp>
+
+#include <vector>
+
+namespace rvs = ranges::views;
+
+namespace kmap::view2 {
+
+FetchSet::FetchSet( std::initializer_list< LinkNode > nodes )
+{
+    reserve( nodes.size() );
+    insert( nodes.begin(), nodes.end() );
+}
+
+auto FetchSet::contains( Uuid const& id ) const
+    -> bool
+{
+    return find( id ) != end();
+}
+
+auto FetchSet::find( Uuid const& id ) const
+    -> const_iterator
+{
+    if( index_.empty() )
+    {
+        return ranges::find_if( nodes_, [ & ]( auto const& e ){ return e.id == id; } );
+    }
+    else if( auto const it = index_.find( id )
+           ; it != index_.end() )
+    {
+        return nodes_.begin() + it->second;
+    }
+    else
+    {
+        return end();
+    }
+}
+
+auto FetchSet::insert( LinkNode const& node )
+    -> std::pair< const_iterator, bool >
+{
+    if( auto const it = find( node.id )
+      ; it != end() )
+    {
+        return { it, false };
+    }
+
+    nodes_.emplace_back( node );
+
+    if( !index_.empty() )
+    {
+        index_.emplace( node.id, nodes_.size() - 1 );
+    }
+    else if( nodes_.size() > index_threshold )
+    {
+        index_.reserve( nodes_.size() * 2 );
+
+        for( auto i = size_type{ 0 }
+           ; i < nodes_.size()
+           ; ++i )
+        {
+            index_.emplace( nodes_[ i ].id, i );
+        }
+    }
+
+    BC_ASSERT( index_.empty() || index_.size() == nodes_.size() );
+
+    return { std::prev( end() ), true };
+}
+
+auto FetchSet::reserve( size_type const n )
+    -> void
+{
+    nodes_.reserve( n );
+
+    if( n > index_threshold )
+    {
+        index_.reserve( n );
+    }
+}
+
+auto operator==( FetchSet const& lhs
+               , FetchSet const& rhs )
+    -> bool
+{
+    return lhs.size() == rhs.size()
+        && ranges::all_of( lhs, [ & ]( auto const& e ){ return rhs.contains( e.id ); } );
+}
+
+SCENARIO( "FetchSet keeps unique nodes in insertion order", "[node_view][fetch_set]" )
+{
+    GIVEN( "ids" )
+    {
+        auto const ids = rvs::iota( 0, 40 )
+                       | rvs::transform( []( auto ){ return gen_uuid(); } )
+                       | ranges::to< std::vector< Uuid > >();
+
+        WHEN( "a single node is inserted" )
+        {
+            auto fs = FetchSet{};
+
+            REQUIRE( fs.emplace( ids[ 0 ] ).second );
+            REQUIRE( !fs.emplace( ids[ 0 ] ).second );
+
+            THEN( "it's held inline" )
+            {
+                REQUIRE( fs.size() == 1 );
+                REQUIRE( fs.contains( ids[ 0 ] ) );
+                REQUIRE( !fs.contains( ids[ 1 ] ) );
+            }
+        }
+        WHEN( "more nodes are inserted than are scanned" )
+        {
+            auto fs = FetchSet{};
+
+            for( auto const& id : ids )
+            {
+                REQUIRE( fs.emplace( id ).second );
+            }
+            for( auto const& id : ids )
+            {
+                REQUIRE( !fs.emplace( id ).second );
+            }
+
+            THEN( "membership and order hold across the index" )
+            {
+                REQUIRE( fs.size() == ids.size() );
+                REQUIRE( ( fs | rvs::transform( []( auto const& e ){ return e.id; } ) | ranges::to< std::vector< Uuid > >() ) == ids );
+                REQUIRE( fs.find( ids[ 30 ] ) == fs.begin() + 30 );
+                REQUIRE( !fs.contains( gen_uuid() ) );
+            }
+            THEN( "copies and moves are equal" )
+            {
+                auto const copied = fs;
+                auto moved = FetchSet{};
+
+                moved = std::move( fs );
+
+                REQUIRE( copied == moved );
+                REQUIRE( moved.contains( ids.back() ) );
+            }
+        }
+        THEN( "equality disregards order" )
+        {
+            REQUIRE( FetchSet{ { .id = ids[ 0 ] }, { .id = ids[ 1 ] } } == FetchSet{ { .id = ids[ 1 ] }, { .id = ids[ 0 ] } } );
+            REQUIRE( !( FetchSet{ { .id = ids[ 0 ] } } == FetchSet{ { .id = ids[ 1 ] } } ) );
+        }
+    }
+}
+
+} // namespace kmap::view2
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#pragma once
+#ifndef KMAP_PATH_NODE_VIEW2_FETCH_SET_HPP
+#define KMAP_PATH_NODE_VIEW2_FETCH_SET_HPP
+
+#include <common.hpp>
+
+#include <boost/container/small_vector.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+namespace kmap::view2 {
+
+struct LinkNode
+{
+    Uuid id = {};
+
+    std::strong_ordering operator<=>( LinkNode const& ) const = default;
+};
+
+/**
+ * @brief The nodes reached by a link step: unique by id, iterated in insertion order.
+ * @note Adapts to size. Up to inline_capacity nodes are held inline, so single-node steps don't allocate. Up to index_threshold nodes, membership is a scan;
+ *       beyond it, an open-addressing index of positions, held flat, is built and thereafter maintained.
+ */
+class FetchSet
+{
+public:
+    static constexpr std::size_t inline_capacity = 4;
+    static constexpr std::size_t index_threshold = 16;
+
+    using value_type = LinkNode;
+    using size_type = std::size_t;
+    using container_type = boost::container::small_vector< LinkNode, inline_capacity >;
+    using const_iterator = container_type::const_iterator;
+    using iterator = const_iterator;
+
+private:
+    container_type nodes_ = {}; // Insertion order.
+    boost::unordered_flat_map< Uuid, size_type, boost::hash< Uuid > > index_ = {}; // id => position in nodes_. Empty until size() exceeds index_threshold.
+
+public:
+    FetchSet() = default;
+    FetchSet( std::initializer_list< LinkNode > nodes );
+    template< typename InputIt >
+    FetchSet( InputIt first
+            , InputIt last )
+    {
+        insert( first, last );
+    }
+
+    auto begin() const -> const_iterator { return nodes_.begin(); }
+    auto end() const -> const_iterator { return nodes_.end(); }
+    auto size() const -> size_type { return nodes_.size(); }
+    auto empty() const -> bool { return nodes_.empty(); }
+
+    auto contains( Uuid const& id ) const
+        -> bool;
+    /**
+     * @brief Constructs a LinkNode from `args`, appending it unless its id is already present.
+     * @return The node's position and whether it was appended, as std::set::emplace.
+     */
+    template< typename... Args >
+    auto emplace( Args&&... args )
+        -> std::pair< const_iterator, bool >
+    {
+        return insert( LinkNode{ std::forward< Args >( args )... } );
+    }
+    auto find( Uuid const& id ) const
+        -> const_iterator;
+    auto insert( LinkNode const& node )
+        -> std::pair< const_iterator, bool >;
+    template< typename InputIt >
+    auto insert( InputIt first
+               , InputIt last )
+        -> void
+    {
+        for( ; first != last ; ++first )
+        {
+            insert( LinkNode{ *first } );
+        }
+    }
+    auto reserve( size_type const n )
+        -> void;
+
+    /**
+     * @note Set equality: insertion order is disregarded.
+     */
+    friend auto operator==( FetchSet const& lhs
+                          , FetchSet const& rhs )
+        -> bool;
+};
+
+} // namespace kmap::view2
+
+#endif // KMAP_PATH_NODE_VIEW2_FETCH_SET_HPP
@@ -9,6 +9,7 @@
 #include "path/view/child.hpp"
 #include "path/view/desc.hpp"
 #include "test/util.hpp"
+#include "utility.hpp"
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -16,10 +17,36 @@
 
 namespace kmap::view2 {
 
+Link::Link( Link const& other )
+    : prev_{ other.prev_ }
+{
+}
+
+auto Link::operator=( Link const& other )
+    -> Link&
+{
+    prev_ = other.prev_;
+    fingerprint_.reset();
+
+    return *this;
+}
+
+auto Link::prev( LinkPtr nprev )
+    -> void
+{
+    prev_ = std::move( nprev );
+    fingerprint_.reset();
+
+    if( prev_ )
+    {
+        prev_->fingerprint();
+    }
+}
+
 bool Link::operator<( Link const& other ) const
 {
-    auto const tp = prev();
-    auto const op = other.prev();
+    auto const& tp = prev();
+    auto const& op = other.prev();
 
     if( tp && op )
     {
@@ -42,6 +69,105 @@ bool Link::operator<( Link const& other ) const
     }
 }
 
+auto Link::fingerprint() const
+    -> Fingerprint
+{
+    if( !fingerprint_ )
+    {
+        fingerprint_ = prev_
+                     ? combine_fingerprints( prev_->fingerprint(), own_fingerprint() )
+                     : own_fingerprint();
+    }
+
+    return *fingerprint_;
+}
+
+auto Link::own_fingerprint() const
+    -> Fingerprint
+{
+    return fingerprint_of( typeid( *this ) );
+}
+
+auto fingerprint_of( char const* s )
+    -> Fingerprint
+{
+    return make_fingerprint( s );
+}
+
+auto fingerprint_of( std::string const& s )
+    -> Fingerprint
+{
+    return make_fingerprint( s );
+}
+
+auto fingerprint_of( Uuid const& id )
+    -> Fingerprint
+{
+    return make_fingerprint( std::string_view{ reinterpret_cast< char const* >( id.data ), id.size() } );
+}
+
+auto fingerprint_of( UuidSet const& ids )
+    -> Fingerprint
+{
+    auto rv = make_fingerprint( "set" );
+
+    for( auto const& id : ids )
+    {
+        rv = combine_fingerprints( rv, fingerprint_of( id ) );
+    }
+
+    return rv;
+}
+
+auto fingerprint_of( Link::LinkPtr const& link )
+    -> Fingerprint
+{
+    return link ? link->fingerprint() : make_fingerprint( "null" );
+}
+
+auto fingerprint_of( std::type_info const& type )
+    -> Fingerprint
+{
+    return make_fingerprint( type.name() );
+}
+
+auto Link::graft( LinkPtr root ) const
+    -> std::unique_ptr< Link >
+{
+    auto rv = clone();
+
+    if( prev_ )
+    {
+        rv->prev( LinkPtr{ prev_->graft( std::move( root ) ) } );
+    }
+    else
+    {
+        rv->prev( std::move( root ) );
+    }
+
+    return rv;
+}
+
+auto Link::operator==( Link const& other ) const
+    -> bool
+{
+    auto lhs = this;
+    auto rhs = &other;
+
+    while( lhs && rhs )
+    {
+        if( lhs->compare_less( *rhs ) || rhs->compare_less( *lhs ) )
+        {
+            return false;
+        }
+
+        lhs = lhs->prev().get();
+        rhs = rhs->prev().get();
+    }
+
+    return lhs == rhs; // Both chains exhausted.
+}
+
 SCENARIO( "view::Link::operator<", "[node_view][link]" )
 {
     // case: single link comparison
@@ -96,6 +222,59 @@ SCENARIO( "view::Link::operator<", "[node_view][link]" )
     }
 }
 
+SCENARIO( "view::Link::fingerprint", "[node_view][link]" )
+{
+    THEN( "structurally equal links share a fingerprint, and are equal" )
+    {
+        auto const caca1 = view2::child( "alpha" ) | view2::child( "alpha" );
+        auto const caca2 = view2::child( "alpha" ) | view2::child( "alpha" );
+
+        REQUIRE( caca1.fingerprint() == caca2.fingerprint() );
+        REQUIRE( caca1 == caca2 );
+    }
+    THEN( "links differing in predicate or chain are unequal" )
+    {
+        auto const ca = view2::child( "alpha" );
+        auto const cb = view2::child( "beta" );
+        auto const cac = view2::child( "alpha" ) | view2::child;
+        auto const cc = view2::child | view2::child;
+
+        REQUIRE( ca.fingerprint() != cb.fingerprint() );
+        REQUIRE( !( ca == cb ) );
+        REQUIRE( cac.fingerprint() != cc.fingerprint() );
+        REQUIRE( !( cac == cc ) );
+        REQUIRE( !( cc == view2::child ) );
+    }
+    THEN( "a chain's fingerprint folds its own over its prefix's" )
+    {
+        auto const cac = view2::child( "alpha" ) | view2::child;
+
+        REQUIRE( cac.fingerprint() == combine_fingerprints( view2::child( "alpha" ).fingerprint(), view2::child.fingerprint() ) );
+    }
+    THEN( "a predicated copy of a fingerprinted link is fingerprinted afresh" )
+    {
+        auto const c = view2::child;
+        auto const cf = c.fingerprint();
+        auto const ca = c( "alpha" );
+        auto cb = ca;
+
+        REQUIRE( ca.fingerprint() != cf );
+        REQUIRE( ca.fingerprint() == view2::child( "alpha" ).fingerprint() );
+
+        cb = c;
+
+        REQUIRE( cb.fingerprint() == cf );
+    }
+    THEN( "predicates of different kinds are distinguished" )
+    {
+        auto const id = gen_uuid();
+
+        REQUIRE( view2::child( id ).fingerprint() == view2::child( id ).fingerprint() );
+        REQUIRE( view2::child( id ).fingerprint() != view2::child( gen_uuid() ).fingerprint() );
+        REQUIRE( view2::child( view2::desc( "alpha" ) ).fingerprint() != view2::child( view2::desc( "beta" ) ).fingerprint() );
+    }
+}
+
 SCENARIO( "view::operator|Link Link", "[node_view][link]" )
 {
     GIVEN( "c: view::child, d: view::desc" )
@@ -138,4 +317,34 @@ SCENARIO( "view::operator|Link Link", "[node_view][link]" )
     }
 }
 
+SCENARIO( "view::operator|Link Link shares prefixes", "[node_view][link]" )
+{
+    GIVEN( "cc: view::child( 'a' ) | view::child( 'b' )" )
+    {
+        auto const cc = view2::child( "a" ) | view2::child( "b" );
+
+        THEN( "cc | d shares cc's prefix" )
+        {
+            auto const ccd = cc | view2::desc;
+
+            REQUIRE( ccd.prev() );
+            REQUIRE( ccd.prev()->prev().get() == cc.prev().get() );
+        }
+        THEN( "copying cc shares its prefix" )
+        {
+            auto const cc2 = cc;
+
+            REQUIRE( cc2.prev().get() == cc.prev().get() );
+            REQUIRE( cc2 == cc );
+        }
+        THEN( "d | cc grafts d ahead of cc's head, leaving cc as it was" )
+        {
+            auto const dcc = view2::desc | cc;
+
+            REQUIRE( dcc == ( view2::desc | view2::child( "a" ) | view2::child( "b" ) ) );
+            REQUIRE( cc.prev()->prev().get() == nullptr );
+        }
+    }
+}
+
 } // namespace kmap::view2
@@ -8,35 +8,60 @@
 #define KMAP_PATH_NODE_VIEW2_LINK_HPP
 
 #include "common.hpp"
-#include "util/polymorphic_value.hpp"
+#include "util/shared_value.hpp"
 
 #include <compare>
 #include <concepts>
+#include <optional>
+#include <string>
 #include <typeindex>
 #include <typeinfo>
+#include <variant>
+#include <vector>
 
 namespace kmap::view2 {
 
 
+// Links, once held by a LinkPtr, are immutable, so chains share their prefixes: copying a link, or a tether, copies no more than its tail.
 class Link
 {
 public:
-    using LinkPtr = PolymorphicValue< Link >;
+    using LinkPtr = SharedValue< Link >;
 
 private:
     LinkPtr prev_ = {};
+    mutable std::optional< Fingerprint > fingerprint_ = std::nullopt; // Memo of fingerprint(). Not carried by copies, as derived state (e.g., pred_) is set on a fresh copy.
 
 public:
+    Link() = default;
+    Link( Link const& other );
     virtual ~Link() = default;
 
-    auto prev() -> LinkPtr& { return prev_; }
+    auto operator=( Link const& other ) -> Link&;
+
     auto prev() const -> LinkPtr const& { return prev_; }
-    auto prev( LinkPtr&& nprev ) -> void { prev_ = std::move( nprev ); }
-    auto prev( LinkPtr const& nprev ) -> void { prev_ = nprev->clone(); }
+    /**
+     * @note The new prev()'s fingerprint is computed, if not already, as it's linked, so a chain built link by link fingerprints each link once.
+     */
+    auto prev( LinkPtr nprev ) -> void;
     virtual auto clone() const -> std::unique_ptr< Link > = 0;
+    /**
+     * @brief Returns a copy of this chain with `root` linked ahead of its head.
+     * @note Each link of this chain is copied, as each needs a new prev(); `root` is shared.
+     */
+    auto graft( LinkPtr root ) const -> std::unique_ptr< Link >;
     virtual auto new_link() const -> std::unique_ptr< Link > = 0; // TODO: Should unique_ptr< Link > be replaced with Link&, as all Links, by convention, should have a const global variable that could be returned, right?
     virtual auto to_string() const -> std::string = 0;
+    /**
+     * @brief Structural hash of this link and its prev() chain: combine( prev()->fingerprint(), own_fingerprint() ).
+     * @note Memoized, and prefixes are shared, so this is O(1) for any link whose prev() was linked by prev( nprev ).
+     */
+    auto fingerprint() const -> Fingerprint;
     bool operator<( Link const& other ) const;
+    /**
+     * @brief Equivalence under operator<, decided link by link along both chains rather than by two recursive orderings.
+     */
+    auto operator==( Link const& other ) const -> bool;
     // TODO: Enable after Emscripten supports std types for operator<=> (optional, variant, type_info, etc.)
     // std::strong_ordering operator<=>( Link const& rhs ) const { return compare( rhs ); }
     // auto operator==( Link const& rhs ) const -> bool { return compare( rhs ) == 0; }
@@ -50,8 +75,61 @@ public:
 
 protected:
     virtual auto compare_less( Link const& other ) const -> bool = 0;
+    /**
+     * @brief Structural hash of this link alone, disregarding prev().
+     * @note Defaults to the link's type; links with state (predicates, operands) combine it in.
+     */
+    virtual auto own_fingerprint() const -> Fingerprint;
 };
 
+auto fingerprint_of( char const* s ) -> Fingerprint;
+auto fingerprint_of( std::string const& s ) -> Fingerprint;
+auto fingerprint_of( Uuid const& id ) -> Fingerprint;
+auto fingerprint_of( UuidSet const& ids ) -> Fingerprint;
+auto fingerprint_of( Link::LinkPtr const& link ) -> Fingerprint;
+auto fingerprint_of( Tether const& tether ) -> Fingerprint;
+auto fingerprint_of( std::type_info const& type ) -> Fingerprint;
+
+template< typename T >
+auto fingerprint_of( std::vector< T > const& ts )
+    -> Fingerprint
+{
+    auto rv = make_fingerprint( "vector" );
+
+    for( auto const& t : ts )
+    {
+        rv = combine_fingerprints( rv, fingerprint_of( t ) );
+    }
+
+    return rv;
+}
+
+template< typename... Ts >
+auto fingerprint_of( std::variant< Ts... > const& v )
+    -> Fingerprint
+{
+    return combine_fingerprints( static_cast< Fingerprint >( v.index() )
+                               , std::visit( []( auto const& e ){ return fingerprint_of( e ); }, v ) );
+}
+
+template< typename T >
+auto fingerprint_of( std::optional< T > const& opt )
+    -> Fingerprint
+{
+    return opt ? fingerprint_of( *opt ) : make_fingerprint( "nullopt" );
+}
+
+/**
+ * @brief Own fingerprint of a link of type `type` with state `state`.
+ */
+template< typename T >
+auto fingerprint_of( std::type_info const& type
+                   , T const& state )
+    -> Fingerprint
+{
+    return combine_fingerprints( fingerprint_of( type ), fingerprint_of( state ) );
+}
+
 template< typename Lhs >
     requires std::derived_from< Lhs, Link >
 auto compare_links( Lhs const& lhs
@@ -81,23 +159,15 @@ auto operator|( Lhs const& lhs
     -> Rhs
 {
     auto nrhs = rhs;
+    auto root = Link::LinkPtr{ std::make_unique< Lhs >( lhs ) };
 
-    if( auto prev = std::ref( nrhs.prev() )
-      ; prev.get() )
+    if( rhs.prev() )
     {
-        auto last = prev;
-
-        while( prev.get() )
-        {
-            last = prev;
-            prev = std::ref( prev.get()->prev() );
-        }
-
-        last.get()->prev( { std::make_unique< Lhs >( lhs ) } );
+        nrhs.prev( Link::LinkPtr{ rhs.prev()->graft( std::move( root ) ) } );
     }
     else
     {
-        nrhs.prev( { std::make_unique< Lhs >( lhs ) } );
+        nrhs.prev( std::move( root ) );
     }
 
     return nrhs;
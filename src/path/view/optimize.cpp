@@ -0,0 +1,590 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#include <path/view/optimize.hpp>
+
+#include <com/database/db.hpp>
+#include <com/network/network.hpp>
+#include <contract.hpp>
+#include <kmap.hpp>
+#include <path/node_view2.hpp>
+#include <path/view/act/to_string.hpp>
+#include <path/view/alias.hpp>
+#include <path/view/all_of.hpp>
+#include <path/view/any_of.hpp>
+#include <path/view/child.hpp>
+#include <path/view/derivation_link.hpp>
+#include <path/view/desc.hpp>
+#include <path/view/direct_desc.hpp>
+#include <path/view/exactly.hpp>
+#include <path/view/parent.hpp>
+#include <path/view/resolve.hpp>
+#include <path/view/sibling.hpp>
+#include <test/util.hpp>
+#include <utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <range/v3/algorithm/all_of.hpp>
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/split.hpp>
+#include <range/v3/view/transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace rvs = ranges::views;
+
+namespace kmap::view2 {
+
+namespace {
+
+using Links = std::vector< std::unique_ptr< Link > >; // Head to tail, each detached from its prev() until relinked.
+
+auto detach( Link const& link )
+    -> std::unique_ptr< Link >
+{
+    auto rv = link.clone();
+
+    rv->prev( Link::LinkPtr{} );
+
+    return rv;
+}
+
+template< typename PredVariant >
+auto estimate_pred( CostModel const& cm
+                  , std::optional< PredVariant > const& pred
+                  , double const scale )
+    -> Optional< double >
+{
+    if( !pred )
+    {
+        return boost::none;
+    }
+
+    auto const dispatch = util::Dispatch
+    {
+        [ & ]( char const* p ) -> Optional< double > { return cm.headed( p ) * scale; }
+    ,   [ & ]( std::string const& p ) -> Optional< double > { return cm.headed( p ) * scale; }
+    ,   [ & ]( Uuid const& p ) -> Optional< double > { return scale; }
+    ,   [ & ]( Link::LinkPtr const& p ) -> Optional< double >
+        {
+            if( auto const e = estimate_sources( cm, *p )
+              ; e )
+            {
+                return e.value() * scale;
+            }
+            else
+            {
+                return boost::none;
+            }
+        }
+    ,   [ & ]( Tether const& p ) -> Optional< double > { return scale; }
+    };
+
+    return std::visit( dispatch, pred.value() );
+}
+
+// Mirrors DerivationLink::fetch_sources( ctx, none ): how many nodes the link reaches, where that's bounded.
+auto estimate_reach( CostModel const& cm
+                   , Link const& link )
+    -> Optional< double >
+{
+    if( auto const l = dynamic_cast< Child const* >( &link ) )
+    {
+        return estimate_pred( cm, l->pred(), 1.0 );
+    }
+    else if( auto const l = dynamic_cast< Parent const* >( &link ) )
+    {
+        return estimate_pred( cm, l->pred(), 1.0 );
+    }
+    else if( auto const l = dynamic_cast< Alias const* >( &link ) )
+    {
+        if( l->pred()
+         && ( std::holds_alternative< Link::LinkPtr >( l->pred().value() )
+           || std::holds_alternative< Tether >( l->pred().value() ) ) )
+        {
+            return boost::none;
+        }
+
+        return estimate_pred( cm, l->pred(), cm.alias_ratio );
+    }
+    else if( auto const l = dynamic_cast< Resolve const* >( &link ) )
+    {
+        return estimate_pred( cm, l->pred(), 1.0 + cm.alias_ratio );
+    }
+    else if( auto const l = dynamic_cast< Desc const* >( &link ) )
+    {
+        if( l->pred()
+         && ( std::holds_alternative< char const* >( l->pred().value() )
+           || std::holds_alternative< std::string >( l->pred().value() ) ) )
+        {
+            return boost::none;
+        }
+
+        return estimate_pred( cm, l->pred(), cm.depth );
+    }
+    else if( auto const l = dynamic_cast< AllOf const* >( &link ) )
+    {
+        auto rv = Optional< double >{};
+
+        for( auto const& sl : l->links() )
+        {
+            if( auto const e = estimate_sources( cm, *sl )
+              ; e )
+            {
+                rv = rv ? std::min( rv.value(), e.value() ) : e.value();
+            }
+            else
+            {
+                return boost::none;
+            }
+        }
+
+        return rv;
+    }
+    else if( auto const l = dynamic_cast< AnyOf const* >( &link ) )
+    {
+        auto rv = 0.0;
+
+        for( auto const& sl : l->links() )
+        {
+            if( auto const e = estimate_sources( cm, *sl )
+              ; e )
+            {
+                rv += e.value();
+            }
+            else
+            {
+                return boost::none;
+            }
+        }
+
+        return rv;
+    }
+    else
+    {
+        return boost::none;
+    }
+}
+
+auto heading_of( std::optional< std::variant< char const*, std::string, Uuid > > const& pred )
+    -> Optional< std::string >
+{
+    if( pred )
+    {
+        if( auto const p = std::get_if< char const* >( &pred.value() ) ){ return std::string{ *p }; }
+        if( auto const p = std::get_if< std::string >( &pred.value() ) ){ return *p; }
+    }
+
+    return boost::none;
+}
+
+// direct_desc( "a.b" ) => child( "a" ) | child( "b" )
+auto expand_direct_desc( Links& links )
+    -> bool
+{
+    for( auto it = links.begin()
+       ; it != links.end()
+       ; ++it )
+    {
+        if( auto const dd = dynamic_cast< DirectDesc const* >( it->get() )
+          ; dd )
+        {
+            auto const pred = dd->pred();
+            auto expanded = Links{};
+
+            if( !pred )
+            {
+                expanded.emplace_back( detach( view2::child ) );
+            }
+            else if( auto const id = std::get_if< Uuid >( &pred.value() ) )
+            {
+                expanded.emplace_back( detach( view2::child( *id ) ) );
+            }
+            else if( auto const path = heading_of( pred )
+                   ; path )
+            {
+                auto const headings = path.value()
+                                    | rvs::split( '.' )
+                                    | rvs::transform( []( auto const& e ){ return e | ranges::to< std::string >(); } )
+                                    | ranges::to< StringVec >();
+
+                if( ranges::all_of( headings, []( auto const& h ){ return is_valid_heading( h ); } ) )
+                {
+                    for( auto const& h : headings )
+                    {
+                        expanded.emplace_back( detach( view2::child( h ) ) );
+                    }
+                }
+            }
+
+            if( !expanded.empty() )
+            {
+                it = links.erase( it );
+                links.insert( it, std::make_move_iterator( expanded.begin() ), std::make_move_iterator( expanded.end() ) );
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// resolve | resolve( p ), resolve( p ) | resolve => resolve( p )
+auto collapse_resolve( Links& links )
+    -> bool
+{
+    for( auto i = std::size_t{ 1 }
+       ; i < links.size()
+       ; ++i )
+    {
+        auto const lhs = dynamic_cast< Resolve const* >( links[ i - 1 ].get() );
+        auto const rhs = dynamic_cast< Resolve const* >( links[ i ].get() );
+
+        if( lhs && rhs )
+        {
+            if( !lhs->pred() )
+            {
+                links.erase( links.begin() + ( i - 1 ) );
+
+                return true;
+            }
+            else if( !rhs->pred() )
+            {
+                links.erase( links.begin() + i );
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// parent | child( p ) => sibling_incl( p )
+auto fold_siblings( Links& links
+                  , bool const anchor_parented )
+    -> bool
+{
+    // Children, descendants and aliases all have parents.
+    auto const parented = [ & ]( std::size_t const i )
+    {
+        if( i == 0 )
+        {
+            return anchor_parented;
+        }
+        else
+        {
+            auto const prev = links[ i - 1 ].get();
+
+            return dynamic_cast< Child const* >( prev ) != nullptr
+                || dynamic_cast< Desc const* >( prev ) != nullptr
+                || dynamic_cast< DirectDesc const* >( prev ) != nullptr
+                || dynamic_cast< Alias const* >( prev ) != nullptr;
+        }
+    };
+
+    for( auto i = std::size_t{ 0 }
+       ; i + 1 < links.size()
+       ; ++i )
+    {
+        auto const parent = dynamic_cast< Parent const* >( links[ i ].get() );
+        auto const child = dynamic_cast< Child const* >( links[ i + 1 ].get() );
+
+        // Only where sibling_incl fetches the whole frontier at once; a link predicate is tested node by node either way.
+        if( parent && !parent->pred()
+         && child && !( child->pred() && std::holds_alternative< Link::LinkPtr >( child->pred().value() ) )
+         && parented( i ) )
+        {
+            auto sibling = [ & ]
+            {
+                if( child->pred() )
+                {
+                    return std::visit( []( auto const& p ){ return detach( view2::sibling_incl( p ) ); }, child->pred().value() );
+                }
+                else
+                {
+                    return detach( view2::sibling_incl );
+                }
+            }();
+
+            links.erase( links.begin() + i, links.begin() + i + 2 );
+            links.insert( links.begin() + i, std::move( sibling ) );
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// desc | q => desc( q' ) | q
+auto push_below_desc( Links& links
+                    , CostModel const& cm
+                    , double const anchor_desc )
+    -> bool
+{
+    for( auto i = std::size_t{ 0 }
+       ; i + 1 < links.size()
+       ; ++i )
+    {
+        auto const desc = dynamic_cast< Desc const* >( links[ i ].get() );
+
+        if( !desc || desc->pred() )
+        {
+            continue;
+        }
+
+        auto const& next = *links[ i + 1 ];
+        auto pushed = std::unique_ptr< Link >{};
+        auto sources = Optional< double >{};
+        auto qlinks = std::size_t{};
+
+        // A descendant reaches something through q only if it satisfies q'. For exactly, as for all_of, every link must reach something.
+        if( auto const q = dynamic_cast< Exactly const* >( &next ) )
+        {
+            auto const qp = AllOf{ q->links() };
+
+            pushed = detach( view2::desc( qp ) );
+            sources = estimate_sources( cm, qp );
+            qlinks = q->links().size();
+        }
+        else if( auto const q = dynamic_cast< AllOf const* >( &next ) )
+        {
+            auto const qp = AllOf{ q->links() };
+
+            pushed = detach( view2::desc( qp ) );
+            sources = estimate_sources( cm, qp );
+            qlinks = q->links().size();
+        }
+        else if( auto const q = dynamic_cast< AnyOf const* >( &next ) )
+        {
+            auto const qp = AnyOf{ q->links() };
+
+            pushed = detach( view2::desc( qp ) );
+            sources = estimate_sources( cm, qp );
+            qlinks = q->links().size();
+        }
+
+        if( !pushed || !sources )
+        {
+            continue;
+        }
+
+        // Forward, each of q's links runs from each descendant; by semi-join, each of q's sources walks up toward the frontier.
+        auto const forward = ( i == 0 ? anchor_desc : cm.subtree ) * static_cast< double >( qlinks );
+        auto const semi = sources.value() * cm.depth;
+
+        if( semi < forward )
+        {
+            links[ i ] = std::move( pushed );
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace anon
+
+auto make_cost_model( FetchContext const& ctx )
+    -> Result< CostModel >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< CostModel >();
+    auto const db = ctx.km.component_slot< com::Database >();
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( db, error_code::common::uncategorized );
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto const& cache = db->cache();
+    auto const& headings = cache.fetch< com::db::HeadingTable >().underlying().get< com::db::right_ordered >();
+    auto const nodes = std::max( 1.0, static_cast< double >( cache.fetch< com::db::NodeTable >().underlying().size() ) );
+    auto const aliases = static_cast< double >( cache.fetch< com::db::AliasTable >().underlying().size() );
+    auto const top = [ & ]
+    {
+        if( auto const cs = cache.fetch_values< com::db::ChildTable >( com::db::Parent{ nw->root_node() } )
+          ; cs )
+        {
+            return std::max( 1.0, static_cast< double >( cs.value().size() ) );
+        }
+        else
+        {
+            return 1.0;
+        }
+    }();
+    auto cm = CostModel{ .nodes = nodes
+                       , .alias_ratio = aliases / nodes
+                       , .depth = std::max( 1.0, std::log2( nodes ) )
+                       , .subtree = nodes / top };
+
+    cm.headed = [ &headings, ratio = cm.alias_ratio ]( std::string const& heading )
+    {
+        return static_cast< double >( headings.count( heading ) ) * ( 1.0 + ratio );
+    };
+
+    rv = cm;
+
+    return rv;
+}
+
+auto estimate_sources( CostModel const& cm
+                     , Link const& pred )
+    -> Optional< double >
+{
+    auto rv = Optional< double >{};
+
+    // Tail to head, so the first bounded link found is the last, from which fetch_sources starts.
+    for( auto link = &pred
+       ; link != nullptr
+       ; link = link->prev().get() )
+    {
+        if( !dynamic_cast< DerivationLink const* >( link ) )
+        {
+            return boost::none;
+        }
+        else if( !rv )
+        {
+            rv = estimate_reach( cm, *link );
+        }
+    }
+
+    return rv;
+}
+
+auto optimize( FetchContext const& ctx
+             , Tether const& tether )
+    -> Result< Tether >
+{
+    return optimize( ctx, tether, tether.anchor()->fetch( ctx ) );
+}
+
+auto optimize( FetchContext const& ctx
+             , Tether const& tether
+             , FetchSet const& anchored )
+    -> Result< Tether >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Tether >();
+
+    if( !tether.tail_link() )
+    {
+        rv = tether;
+
+        return rv;
+    }
+
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto links = Links{};
+
+    for( auto link = tether.tail_link().get()
+       ; link != nullptr
+       ; link = link->prev().get() )
+    {
+        links.insert( links.begin(), detach( *link ) );
+    }
+
+    auto const cm = KTRY( make_cost_model( ctx ) );
+    auto const anchor_parented = ranges::all_of( anchored, [ & ]( auto const& e ){ return nw->fetch_parent( e.id ).has_value(); } );
+    auto const anchor_desc = anchored.contains( nw->root_node() )
+                           ? cm.nodes
+                           : static_cast< double >( anchored.size() ) * cm.subtree;
+
+    auto rewritten = false;
+
+    while( expand_direct_desc( links )
+        || collapse_resolve( links )
+        || fold_siblings( links, anchor_parented )
+        || push_below_desc( links, cm, anchor_desc ) )
+    {
+        rewritten = true;
+    }
+
+    if( rewritten )
+    {
+        auto tail = Link::LinkPtr{};
+
+        for( auto& link : links )
+        {
+            link->prev( std::move( tail ) );
+
+            tail = Link::LinkPtr{ std::move( link ) };
+        }
+
+        rv = Tether{ tether.anchor(), std::move( tail ) };
+    }
+    else
+    {
+        rv = tether; // Shares the chain as written.
+    }
+
+    return rv;
+}
+
+SCENARIO( "optimize rewrites tethers without changing what they fetch", "[node_view][optimize]" )
+{
+    KMAP_COMPONENT_FIXTURE_SCOPED( "root_node", "network" );
+
+    auto& km = Singleton::instance();
+    auto const nw = REQUIRE_TRY( km.fetch_component< com::Network >() );
+    auto const root = nw->root_node();
+    auto const tether = Tether{ anchor::node( root ) };
+    auto const ctx = FetchContext{ km, tether };
+    auto const plan = [ & ]( Tether const& t )
+    {
+        auto const opt = REQUIRE_TRY( optimize( ctx, t ) );
+
+        REQUIRE(( opt | act::to_node_set( km ) ) == ( t | act::to_node_set( km ) ));
+
+        return *opt.tail_link() | act::to_string;
+    };
+
+    GIVEN( "/1.requisite, /1.2.3, /2.requisite.x" )
+    {
+        auto const n1 = REQUIRE_TRY( nw->create_child( root, "1" ) );
+        REQUIRE_TRY( nw->create_child( n1, "requisite" ) );
+        auto const n12 = REQUIRE_TRY( nw->create_child( n1, "2" ) );
+        REQUIRE_TRY( nw->create_child( n12, "3" ) );
+        auto const n2 = REQUIRE_TRY( nw->create_child( root, "2" ) );
+        auto const n2r = REQUIRE_TRY( nw->create_child( n2, "requisite" ) );
+        REQUIRE_TRY( nw->create_child( n2r, "x" ) );
+
+        THEN( "direct_desc( <path> ) becomes a chain of child( <heading> )" )
+        {
+            REQUIRE( plan( anchor::node( root ) | view2::direct_desc( "1.2.3" ) ) == "child( '1' )|child( '2' )|child( '3' )" );
+        }
+        THEN( "repeated resolve collapses" )
+        {
+            REQUIRE( plan( anchor::node( root ) | view2::child( "1" ) | view2::resolve | view2::resolve ) == "child( '1' )|resolve" );
+        }
+        THEN( "parent | child folds into sibling_incl below a child" )
+        {
+            REQUIRE( plan( anchor::node( root ) | view2::child( "1" ) | view2::parent | view2::child( "2" ) ) == "child( '1' )|sibling_incl( '2' )" );
+        }
+        THEN( "parent | child doesn't fold where the frontier may be parentless" )
+        {
+            REQUIRE( plan( anchor::node( root ) | view2::parent | view2::child ) == "parent|child" );
+        }
+        THEN( "desc | exactly is narrowed by semi-join" )
+        {
+            REQUIRE( plan( anchor::node( root ) | view2::desc | view2::exactly( view2::child( "requisite" ) ) ) == "desc( all_of( child( 'requisite' ) ) )|exactly( child( 'requisite' ) )" );
+        }
+        THEN( "desc | any_of is narrowed by semi-join" )
+        {
+            REQUIRE( plan( anchor::node( root ) | view2::desc | view2::any_of( view2::child( "x" ), view2::child( "3" ) ) ) == "desc( any_of( child( 'x' ),child( '3' ) ) )|any_of( child( 'x' ),child( '3' ) )" );
+        }
+    }
+}
+
+} // namespace kmap::view2
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#pragma once
+#ifndef KMAP_PATH_NODE_VIEW2_OPTIMIZE_HPP
+#define KMAP_PATH_NODE_VIEW2_OPTIMIZE_HPP
+
+#include <common.hpp>
+#include <path/view/common.hpp>
+#include <path/view/link.hpp>
+#include <path/view/tether.hpp>
+#include <util/result.hpp>
+
+#include <functional>
+#include <string>
+
+// Rewrites a tether, ahead of fetching it, into an equivalent that's cheaper to evaluate.
+
+namespace kmap::view2 {
+
+/**
+ * @brief Estimates the cost of evaluating links from the cardinalities of the database tables.
+ * @note Tables are read from the cache directly, so planning a query isn't recorded as a dependency of it.
+ */
+struct CostModel
+{
+    double nodes = 1.0; // |NodeTable|
+    double alias_ratio = 0.0; // |AliasTable| / |NodeTable|
+    double depth = 1.0; // Length of an ancestry walk: log2( nodes ), as if the tree were balanced.
+    double subtree = 1.0; // Size of a subtree below the root: nodes spread over the root's children.
+    std::function< double( std::string const& ) > headed = {}; // Nodes headed `heading`, aliases included.
+};
+
+auto make_cost_model( FetchContext const& ctx )
+    -> Result< CostModel >;
+/**
+ * @brief Returns the estimated size of fetch_sources( ctx, pred ), or none where fetch_sources would return none.
+ */
+auto estimate_sources( CostModel const& cm
+                     , Link const& pred )
+    -> Optional< double >;
+/**
+ * @brief Returns a tether fetching the same nodes as `tether`, rewritten by rule:
+ *        - direct_desc( "a.b" ) => child( "a" ) | child( "b" ), for a path of plain headings.
+ *        - resolve | resolve( p ), resolve( p ) | resolve => resolve( p ).
+ *        - parent | child( p ) => sibling_incl( p ), where nothing reaching `parent` can be parentless, as sibling_incl keeps a parentless node.
+ *        - desc | q => desc( q' ) | q, for q an exactly, all_of or any_of, and q' an all_of or any_of of q's links, where the cost model favors semi-join.
+ */
+auto optimize( FetchContext const& ctx
+             , Tether const& tether )
+    -> Result< Tether >;
+/**
+ * @param anchored: tether.anchor()->fetch( ctx ), for a caller that goes on to evaluate the rewritten tether from it.
+ * @note The anchor isn't rewritten, so `anchored` is also the rewritten tether's anchor set.
+ */
+auto optimize( FetchContext const& ctx
+             , Tether const& tether
+             , FetchSet const& anchored )
+    -> Result< Tether >;
+
+} // namespace kmap::view2
+
+#endif // KMAP_PATH_NODE_VIEW2_OPTIMIZE_HPP
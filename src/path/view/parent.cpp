@@ -7,6 +7,7 @@
 
 #include "com/network/network.hpp"
 #include "kmap.hpp"
+#include "path/view/semi_join.hpp"
 #include "utility.hpp"
 
 #include <catch2/catch_test_macros.hpp>
@@ -75,9 +76,7 @@ auto Parent::fetch( FetchContext const& ctx
                   ; parent )
                 {
                     auto const t = KTRY( pred | act::to_fetch_set( ctx ) );
-                    auto const& idv = t.get< Uuid >();
-
-                    if( idv.contains( parent.value() ) )
+                    if( t.contains( parent.value() ) )
                     {
                         fs = FetchSet{ LinkNode{ .id = parent.value() } };
                     }
@@ -105,6 +104,105 @@ auto Parent::fetch( FetchContext const& ctx
     }
 }
 
+auto Parent::fetch( FetchContext const& ctx
+                  , FetchSet const& fs ) const
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< FetchSet >();
+
+    if( pred_ )
+    {
+        rv = KTRY( DerivationLink::fetch( ctx, fs ) );
+    }
+    else
+    {
+        auto const nw = ctx.km.component_slot< com::Network >();
+
+        KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+        auto parents = FetchSet{};
+
+        for( auto const& node : fs )
+        {
+            if( auto const parent = nw->fetch_parent( node.id )
+              ; parent )
+            {
+                parents.emplace( LinkNode{ .id = parent.value() } );
+            }
+        }
+
+        rv = parents;
+    }
+
+    return rv;
+}
+
+auto Parent::fetch_sources( FetchContext const& ctx
+                          , Optional< FetchSet > const& targets ) const
+    -> Result< Optional< FetchSet > >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Optional< FetchSet > >();
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto reach = Optional< FetchSet >{}; // Parents satisfying the predicate.
+
+    if( pred_ )
+    {
+        auto dispatch = util::Dispatch
+        {
+            [ & ]( char const* pred ) -> Result< FetchSet >
+            {
+                return KTRY( fetch_headed( ctx, pred, targets ) );
+            }
+        ,   [ & ]( std::string const& pred ) -> Result< FetchSet >
+            {
+                return KTRY( fetch_headed( ctx, pred, targets ) );
+            }
+        ,   [ & ]( Uuid const& pred ) -> Result< FetchSet >
+            {
+                return narrow( FetchSet{ LinkNode{ .id = pred } }, targets );
+            }
+        ,   [ & ]( Tether const& pred ) -> Result< FetchSet >
+            {
+                return narrow( KTRY( pred | act::to_fetch_set( ctx ) ), targets );
+            }
+        };
+
+        reach = KTRY( std::visit( dispatch, pred_.value() ) );
+    }
+    else
+    {
+        reach = targets;
+    }
+
+    if( reach )
+    {
+        auto children = FetchSet{};
+
+        for( auto const& e : reach.value() )
+        {
+            for( auto const& c : nw->fetch_children( e.id ) )
+            {
+                children.emplace( LinkNode{ .id = c } );
+            }
+        }
+
+        rv = Optional< FetchSet >{ children };
+    }
+    else
+    {
+        rv = Optional< FetchSet >{};
+    }
+
+    return rv;
+}
+
 auto Parent::new_link() const
     -> std::unique_ptr< Link >
 {
@@ -94,6 +94,9 @@ public:
 
     virtual auto create( CreateContext const& ctx, Uuid const& root ) const -> Result< UuidSet > = 0;
     virtual auto fetch( FetchContext const& ctx, Uuid const& node ) const -> Result< FetchSet > = 0;
+
+protected:
+    auto own_fingerprint() const -> Fingerprint override { return fingerprint_of( typeid( *this ), links_ ); }
 };
 
 } // namespace kmap::view2
@@ -8,6 +8,7 @@
 #include "com/network/network.hpp"
 #include "contract.hpp"
 #include "path/view/act/abs_path.hpp"
+#include "path/view/semi_join.hpp"
 
 #include <catch2/catch_test_macros.hpp>
 #include <range/v3/algorithm/sort.hpp>
@@ -106,6 +107,105 @@ auto Resolve::fetch( FetchContext const& ctx
     }
 }
 
+auto Resolve::fetch( FetchContext const& ctx
+                   , FetchSet const& fs ) const
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< FetchSet >();
+
+    if( pred_ )
+    {
+        rv = KTRY( DerivationLink::fetch( ctx, fs ) );
+    }
+    else
+    {
+        auto const nw = ctx.km.component_slot< com::Network >();
+
+        KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+        rv = fs
+           | rvs::transform( [ & ]( auto const& e ){ return LinkNode{ .id = nw->resolve( e.id ) }; } )
+           | ranges::to< FetchSet >();
+    }
+
+    return rv;
+}
+
+auto Resolve::fetch_sources( FetchContext const& ctx
+                           , Optional< FetchSet > const& targets ) const
+    -> Result< Optional< FetchSet > >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Optional< FetchSet > >();
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto reach = Optional< FetchSet >{}; // Resolutions satisfying the predicate.
+
+    if( pred_ )
+    {
+        auto dispatch = util::Dispatch
+        {
+            [ & ]( char const* pred ) -> Result< Optional< FetchSet > >
+            {
+                return Optional< FetchSet >{ KTRY( fetch_headed( ctx, pred, targets ) ) };
+            }
+        ,   [ & ]( std::string const& pred ) -> Result< Optional< FetchSet > >
+            {
+                return Optional< FetchSet >{ KTRY( fetch_headed( ctx, pred, targets ) ) };
+            }
+        ,   [ & ]( Uuid const& pred ) -> Result< Optional< FetchSet > >
+            {
+                return Optional< FetchSet >{ narrow( FetchSet{ LinkNode{ .id = pred } }, targets ) };
+            }
+        ,   [ & ]( LinkPtr const& pred ) -> Result< Optional< FetchSet > >
+            {
+                return KTRY( fetch_satisfying( ctx, *pred, targets ) );
+            }
+        ,   [ & ]( Tether const& pred ) -> Result< Optional< FetchSet > >
+            {
+                return Optional< FetchSet >{ narrow( KTRY( pred | act::to_fetch_set( ctx ) ), targets ) };
+            }
+        };
+
+        reach = KTRY( std::visit( dispatch, pred_.value() ) );
+    }
+    else
+    {
+        reach = targets;
+    }
+
+    if( reach )
+    {
+        auto sources = FetchSet{};
+
+        for( auto const& e : reach.value() )
+        {
+            if( !nw->is_alias( e.id ) ) // Only a non-alias is a resolution.
+            {
+                sources.emplace( e );
+
+                for( auto const& alias : nw->fetch_aliases( e.id ) )
+                {
+                    sources.emplace( LinkNode{ .id = alias } );
+                }
+            }
+        }
+
+        rv = Optional< FetchSet >{ sources };
+    }
+    else
+    {
+        rv = Optional< FetchSet >{};
+    }
+
+    return rv;
+}
+
 auto Resolve::new_link() const
     -> std::unique_ptr< Link >
 {
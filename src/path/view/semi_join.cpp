@@ -0,0 +1,339 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#include <path/view/semi_join.hpp>
+
+#include <com/network/network.hpp>
+#include <contract.hpp>
+#include <kmap.hpp>
+#include <path/node_view2.hpp>
+#include <path/view/derivation_link.hpp>
+#include <test/util.hpp>
+#include <utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace kmap::view2 {
+
+auto fetch_headed( FetchContext const& ctx
+                 , std::string const& heading
+                 , Optional< FetchSet > const& within )
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+        KM_RESULT_PUSH_STR( "heading", heading );
+
+    auto rv = result::make_result< FetchSet >();
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto headed = FetchSet{};
+
+    if( within )
+    {
+        for( auto const& e : within.value() )
+        {
+            if( auto const h = nw->fetch_heading( e.id )
+              ; h && h.value() == heading )
+            {
+                headed.emplace( e );
+            }
+        }
+    }
+    else
+    {
+        // Aliases aren't in the heading index, but share their source's heading.
+        for( auto const& node : nw->fetch_nodes( heading ) )
+        {
+            headed.emplace( LinkNode{ .id = node } );
+
+            for( auto const& alias : nw->fetch_aliases( node ) )
+            {
+                headed.emplace( LinkNode{ .id = alias } );
+            }
+        }
+    }
+
+    rv = headed;
+
+    return rv;
+}
+
+auto fetch_sources( FetchContext const& ctx
+                  , Link const& pred
+                  , Optional< FetchSet > const& targets )
+    -> Result< Optional< FetchSet > >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Optional< FetchSet > >();
+    auto links = std::vector< DerivationLink const* >{}; // Head to tail.
+    auto walkable = true;
+
+    for( auto link = &pred
+       ; link != nullptr
+       ; link = link->prev().get() )
+    {
+        if( auto const dlink = dynamic_cast< DerivationLink const* >( link )
+          ; dlink )
+        {
+            links.insert( links.begin(), dlink );
+        }
+        else
+        {
+            walkable = false; // E.g., a TransformationLink, whose result needn't be a union over nodes.
+
+            break;
+        }
+    }
+
+    auto sources = Optional< FetchSet >{};
+    auto next = links.size(); // Links [ next, size ) have been walked into `sources`.
+
+    if( !walkable )
+    {
+        next = 0;
+    }
+    else if( targets )
+    {
+        sources = targets;
+    }
+    else
+    {
+        while( next > 0 && !sources )
+        {
+            --next;
+
+            sources = KTRY( links[ next ]->fetch_sources( ctx, boost::none ) );
+        }
+
+        if( sources && next + 1 < links.size() )
+        {
+            // The links after the bounded one run forward from what it reaches; those reached nodes bound the targets it must meet.
+            auto suffix = Link::LinkPtr{};
+
+            for( auto i = next + 1
+               ; i < links.size()
+               ; ++i )
+            {
+                auto link = links[ i ]->clone();
+
+                link->prev( std::move( suffix ) );
+
+                suffix = Link::LinkPtr{ std::move( link ) };
+            }
+
+            auto const reached = KTRY( links[ next ]->fetch( ctx, sources.value() ) );
+            auto met = FetchSet{};
+
+            for( auto const& e : reached )
+            {
+                if( anchor::node( e.id ) | suffix | act::exists( ctx.km ) )
+                {
+                    met.emplace( e );
+                }
+            }
+
+            sources = KTRY( links[ next ]->fetch_sources( ctx, met ) );
+        }
+    }
+
+    while( sources && next > 0 )
+    {
+        --next;
+
+        sources = KTRY( links[ next ]->fetch_sources( ctx, sources ) );
+    }
+
+    rv = sources;
+
+    return rv;
+}
+
+auto fetch_satisfying( FetchContext const& ctx
+                     , Link const& pred
+                     , Optional< FetchSet > const& within )
+    -> Result< Optional< FetchSet > >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< Optional< FetchSet > >();
+
+    if( auto const sources = KTRY( fetch_sources( ctx, pred ) )
+      ; sources )
+    {
+        rv = Optional< FetchSet >{ narrow( sources.value(), within ) };
+    }
+    else if( within )
+    {
+        auto const plink = Link::LinkPtr{ pred.clone() };
+        auto satisfying = FetchSet{};
+
+        for( auto const& e : within.value() )
+        {
+            if( anchor::node( e.id ) | plink | act::exists( ctx.km ) )
+            {
+                satisfying.emplace( e );
+            }
+        }
+
+        rv = Optional< FetchSet >{ satisfying };
+    }
+    else
+    {
+        rv = Optional< FetchSet >{};
+    }
+
+    return rv;
+}
+
+auto filter_descendants( FetchContext const& ctx
+                       , FetchSet const& roots
+                       , FetchSet const& nodes )
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< FetchSet >();
+    auto const nw = ctx.km.component_slot< com::Network >();
+
+    KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+    auto descs = FetchSet{};
+    auto below = std::unordered_map< Uuid, bool, boost::hash< Uuid > >{}; // Whether a node is a root or lies below one. Shared by walks meeting at a common ancestor.
+
+    for( auto const& e : nodes )
+    {
+        auto walked = UuidVec{};
+        auto found = false;
+
+        for( auto parent = to_optional( nw->fetch_parent( e.id ) )
+           ; parent
+           ; parent = to_optional( nw->fetch_parent( parent.value() ) ) )
+        {
+            if( auto const it = below.find( parent.value() )
+              ; it != below.end() )
+            {
+                found = it->second;
+
+                break;
+            }
+            else if( roots.contains( parent.value() ) )
+            {
+                found = true;
+
+                break;
+            }
+
+            walked.emplace_back( parent.value() );
+        }
+
+        for( auto const& w : walked )
+        {
+            below.emplace( w, found );
+        }
+
+        if( found )
+        {
+            descs.emplace( e );
+        }
+    }
+
+    rv = descs;
+
+    return rv;
+}
+
+auto narrow( FetchSet const& fs
+           , Optional< FetchSet > const& within )
+    -> FetchSet
+{
+    if( within )
+    {
+        auto rs = FetchSet{};
+
+        for( auto const& e : fs )
+        {
+            if( within.value().contains( e.id ) )
+            {
+                rs.emplace( e );
+            }
+        }
+
+        return rs;
+    }
+    else
+    {
+        return fs;
+    }
+}
+
+SCENARIO( "predicates are evaluated by semi-join", "[node_view][semi_join]" )
+{
+    KMAP_COMPONENT_FIXTURE_SCOPED( "root_node", "network" );
+
+    auto& km = Singleton::instance();
+    auto const nw = REQUIRE_TRY( km.fetch_component< com::Network >() );
+    auto const root = nw->root_node();
+    auto const tether = Tether{ anchor::node( root ) };
+    auto const ctx = FetchContext{ km, tether };
+
+    GIVEN( "/1.requisite.x, /2.requisite, /3.x" )
+    {
+        auto const n1 = REQUIRE_TRY( nw->create_child( root, "1" ) );
+        auto const n1r = REQUIRE_TRY( nw->create_child( n1, "requisite" ) );
+        REQUIRE_TRY( nw->create_child( n1r, "x" ) );
+        auto const n2 = REQUIRE_TRY( nw->create_child( root, "2" ) );
+        REQUIRE_TRY( nw->create_child( n2, "requisite" ) );
+        auto const n3 = REQUIRE_TRY( nw->create_child( root, "3" ) );
+        REQUIRE_TRY( nw->create_child( n3, "x" ) );
+
+        THEN( "bounded predicate is walked backwards" )
+        {
+            auto const sources = REQUIRE_TRY( fetch_sources( ctx, view2::child( "requisite" ) ) );
+
+            REQUIRE( sources );
+            REQUIRE( sources.value().size() == 2 );
+            REQUIRE( sources.value().contains( n1 ) );
+            REQUIRE( sources.value().contains( n2 ) );
+        }
+        THEN( "links after the bounded link run forward" )
+        {
+            auto const sources = REQUIRE_TRY( fetch_sources( ctx, view2::child( "requisite" ) | view2::child ) );
+
+            REQUIRE( sources );
+            REQUIRE( sources.value().size() == 1 );
+            REQUIRE( sources.value().contains( n1 ) );
+        }
+        THEN( "unbounded predicate isn't walked" )
+        {
+            REQUIRE( !REQUIRE_TRY( fetch_sources( ctx, view2::child | view2::child ) ) );
+        }
+        THEN( "desc( pred ) matches forward evaluation" )
+        {
+            auto const ns = anchor::node( root ) | view2::desc( view2::child( "requisite" ) | view2::child ) | act::to_node_set( km );
+
+            REQUIRE( ns == UuidSet{ n1 } );
+        }
+
+        GIVEN( "alias of /1 under /3" )
+        {
+            auto const a31 = REQUIRE_TRY( nw->create_alias( n1, n3 ) );
+
+            THEN( "alias is found through its source's heading" )
+            {
+                auto const ns = anchor::node( n3 ) | view2::desc( view2::child( "requisite" ) ) | act::to_node_set( km );
+
+                REQUIRE( ns == UuidSet{ a31 } );
+            }
+        }
+    }
+}
+
+} // namespace kmap::view2
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#pragma once
+#ifndef KMAP_PATH_NODE_VIEW2_SEMI_JOIN_HPP
+#define KMAP_PATH_NODE_VIEW2_SEMI_JOIN_HPP
+
+#include <common.hpp>
+#include <path/view/common.hpp>
+#include <path/view/link.hpp>
+#include <util/result.hpp>
+
+#include <string>
+
+// Predicate evaluation by semi-join: rather than run a predicate forward from each candidate node, walk it backwards, once, from the nodes it could reach.
+
+namespace kmap::view2 {
+
+/**
+ * @brief Returns the nodes, aliases included, headed `heading`; from the heading index, or, given `within`, by filtering `within`.
+ */
+auto fetch_headed( FetchContext const& ctx
+                 , std::string const& heading
+                 , Optional< FetchSet > const& within = boost::none )
+    -> Result< FetchSet >;
+/**
+ * @brief Returns the nodes `n` for which `anchor::node( n ) | pred` is nonempty and, given `targets`, meets `targets`.
+ * @note Starts from the last link of `pred` whose reach is bounded (see DerivationLink::fetch_sources), runs any links after it forward from what it reaches,
+ *       then walks the links before it backwards. Returns none if no link bounds the reach, or a link can't be walked backwards.
+ */
+auto fetch_sources( FetchContext const& ctx
+                  , Link const& pred
+                  , Optional< FetchSet > const& targets = boost::none )
+    -> Result< Optional< FetchSet > >;
+/**
+ * @brief Returns the nodes `n`, of `within` if given, for which `anchor::node( n ) | pred` is nonempty.
+ * @note Falls back to running `pred` forward from each node of `within` where `pred` can't be walked backwards. None if neither applies.
+ */
+auto fetch_satisfying( FetchContext const& ctx
+                     , Link const& pred
+                     , Optional< FetchSet > const& within = boost::none )
+    -> Result< Optional< FetchSet > >;
+/**
+ * @brief Returns those of `nodes` lying strictly below a node of `roots`, by walking up from each, so the subtrees of `roots` needn't be enumerated.
+ */
+auto filter_descendants( FetchContext const& ctx
+                       , FetchSet const& roots
+                       , FetchSet const& nodes )
+    -> Result< FetchSet >;
+auto narrow( FetchSet const& fs
+           , Optional< FetchSet > const& within )
+    -> FetchSet;
+
+} // namespace kmap::view2
+
+#endif // KMAP_PATH_NODE_VIEW2_SEMI_JOIN_HPP
@@ -48,7 +48,7 @@ auto SiblingIncl::fetch( FetchContext const& ctx
                 auto const nw = KTRY( ctx.km.fetch_component< com::Network >() );
 
                 return sibling_incls
-                     | rvs::filter( [ & ]( auto const& e ){ return pred == KTRYE( nw->fetch_heading( e.id ) ); } )
+                     | rvs::filter( [ & ]( auto const& e ){ return pred == KTRYE( nw->fetch_heading_view( e.id ) ); } )
                      | ranges::to< FetchSet >();
             }
         ,   [ & ]( Uuid const& pred ) -> Result< FetchSet >
@@ -128,6 +128,75 @@ auto SiblingIncl::fetch( FetchContext const& ctx
     }
 }
 
+auto SiblingIncl::fetch( FetchContext const& ctx
+                       , FetchSet const& fs ) const
+    -> Result< FetchSet >
+{
+    KM_RESULT_PROLOG();
+
+    auto rv = result::make_result< FetchSet >();
+
+    if( pred_
+     && ( std::holds_alternative< LinkPtr >( pred_.value() )
+       || std::holds_alternative< Tether >( pred_.value() ) ) )
+    {
+        rv = KTRY( DerivationLink::fetch( ctx, fs ) );
+    }
+    else
+    {
+        auto const nw = ctx.km.component_slot< com::Network >();
+
+        KMAP_ENSURE( nw, error_code::common::uncategorized );
+
+        auto const heading = [ & ]() -> Optional< std::string >
+        {
+            if( pred_ )
+            {
+                if( auto const p = std::get_if< char const* >( &pred_.value() ) ){ return std::string{ *p }; }
+                if( auto const p = std::get_if< std::string >( &pred_.value() ) ){ return *p; }
+            }
+
+            return boost::none;
+        }();
+        auto const id = pred_ ? std::get_if< Uuid >( &pred_.value() ) : nullptr;
+        auto const matches = [ & ]( Uuid const& n )
+        {
+            return ( !id || n == *id )
+                && ( !heading || heading.value() == KTRYE( nw->fetch_heading_view( n ) ) );
+        };
+
+        // Nodes sharing a parent share siblings, so each parent's children are fetched once.
+        auto siblings = FetchSet{};
+        auto visited = UuidSet{};
+
+        for( auto const& node : fs )
+        {
+            if( auto const parent = nw->fetch_parent( node.id )
+              ; parent )
+            {
+                if( visited.emplace( parent.value() ).second )
+                {
+                    for( auto const& c : nw->fetch_children( parent.value() ) )
+                    {
+                        if( matches( c ) )
+                        {
+                            siblings.emplace( LinkNode{ .id = c } );
+                        }
+                    }
+                }
+            }
+            else if( matches( node.id ) ) // node is root.
+            {
+                siblings.emplace( LinkNode{ .id = node.id } );
+            }
+        }
+
+        rv = siblings;
+    }
+
+    return rv;
+}
+
 SCENARIO( "view::SiblingIncl::fetch", "[node_view][sibling_incl]" )
 {
     KMAP_COMPONENT_FIXTURE_SCOPED( "root_node", "network" );
@@ -5,46 +5,85 @@
  ******************************************************************************/
 #include "tether.hpp"
 
+#include "path/node_view2.hpp"
 #include "path/view/act/to_string.hpp"
 #include "path/view/anchor/anchor.hpp"
+#include "test/util.hpp"
 
 #include <catch2/catch_test_macros.hpp>
 
 namespace kmap::view2 {
 
 Tether::Tether( Anchor::AnchorPtr anc )
-    : anchor{ std::move( anc ) }
+    : anchor_{ std::move( anc ) }
+    , fingerprint_{ anchor_->fingerprint() }
 {
 }
 
 Tether::Tether( Anchor::AnchorPtr anc
               , Link::LinkPtr tlink )
-    : anchor{ std::move( anc ) }
-    , tail_link{ std::move( tlink ) }
+    : anchor_{ std::move( anc ) }
+    , tail_link_{ std::move( tlink ) }
+    , fingerprint_{ tail_link_
+                  ? combine_fingerprints( anchor_->fingerprint(), tail_link_->fingerprint() )
+                  : anchor_->fingerprint() }
 {
 }
 
 auto Tether::operator<( Tether const& other ) const
     -> bool
 {
-    if( ( *anchor ) < ( *other.anchor ) )
+    if( ( *anchor_ ) < ( *other.anchor_ ) )
     {
         return true;
     }
-    else if( ( *other.anchor ) < ( *anchor ) )
+    else if( ( *other.anchor_ ) < ( *anchor_ ) )
     {
         return false;
     }
-    else if( !tail_link || !other.tail_link )
+    else if( !tail_link_ || !other.tail_link_ )
     {
-        return tail_link < other.tail_link;
+        return tail_link_ < other.tail_link_;
     }
     else
     {
-        return ( *tail_link ) < ( *other.tail_link );
+        return ( *tail_link_ ) < ( *other.tail_link_ );
     }
 }
 
+auto Tether::operator==( Tether const& other ) const
+    -> bool
+{
+    if( fingerprint_ != other.fingerprint_
+     || !( ( *anchor_ ) == ( *other.anchor_ ) ) )
+    {
+        return false;
+    }
+    else if( !tail_link_ || !other.tail_link_ )
+    {
+        return !tail_link_ && !other.tail_link_;
+    }
+    else
+    {
+        return ( *tail_link_ ) == ( *other.tail_link_ );
+    }
+}
+
+SCENARIO( "Tether::operator==", "[node_view][link]" )
+{
+    auto const n = gen_uuid();
+    auto const t1 = anchor::node( n ) | view2::child( "alpha" ) | view2::parent | to_tether;
+    auto const t2 = anchor::node( n ) | view2::child( "alpha" ) | view2::parent | to_tether;
+    auto const t3 = anchor::node( n ) | view2::child( "beta" ) | view2::parent | to_tether;
+    auto const t4 = anchor::node( gen_uuid() ) | view2::child( "alpha" ) | view2::parent | to_tether;
+
+    REQUIRE( t1.fingerprint() == t2.fingerprint() );
+    REQUIRE( t1 == t2 );
+    REQUIRE( !( t1 == t3 ) );
+    REQUIRE( !( t1 == t4 ) );
+    REQUIRE( !( t1 == ( anchor::node( n ) | to_tether ) ) );
+}
+
 SCENARIO( "Tether::operator<", "[node_view][link]")
 {
     // TODO: Impl. test.
@@ -72,19 +111,31 @@ SCENARIO( "Tether::operator<", "[node_view][link]")
 auto Tether::to_string() const
     -> std::string
 {
-    if( tail_link )
+    if( tail_link_ )
     {
         return fmt::format( "Tether|anchor:{}|chain:{}\n"
-                          , *anchor | act::to_string
-                          , *tail_link | act::to_string );
+                          , *anchor_ | act::to_string
+                          , *tail_link_ | act::to_string );
     }
     else
     {
         return fmt::format( "Tether|anchor:{}\n"
-                          , *anchor | act::to_string );
+                          , *anchor_ | act::to_string );
     }
 }
 
+auto fingerprint_of( Tether const& tether )
+    -> Fingerprint
+{
+    return tether.fingerprint();
+}
+
+auto hash_value( Tether const& tether )
+    -> std::size_t
+{
+    return static_cast< std::size_t >( tether.fingerprint() );
+}
+
 auto operator<<( std::ostream& os
                , Tether const& tether )
     -> std::ostream&
@@ -25,21 +25,30 @@ namespace kmap::view2 {
 
 class Tether 
 {
-public:
-    Anchor::AnchorPtr anchor; // Guaranteed: has_value()
-    Link::LinkPtr tail_link = {};  
+    Anchor::AnchorPtr anchor_; // Guaranteed: has_value()
+    Link::LinkPtr tail_link_ = {};  
+    Fingerprint fingerprint_ = {}; // Computed on construction; anchor_ and tail_link_ are fixed thereafter.
 
+public:
     template< typename AnchorType >
         requires std::derived_from< AnchorType, Anchor >
     Tether( AnchorType const& anc )
-        : anchor{ Anchor::AnchorPtr{ std::make_unique< AnchorType >( anc ) } }
+        : anchor_{ Anchor::AnchorPtr{ std::make_unique< AnchorType >( anc ) } }
+        , fingerprint_{ anchor_->fingerprint() }
     {
     }
     Tether( Anchor::AnchorPtr anc );
     Tether( Anchor::AnchorPtr anc
           , Link::LinkPtr tlink );
 
+    auto anchor() const -> Anchor::AnchorPtr const& { return anchor_; }
+    auto tail_link() const -> Link::LinkPtr const& { return tail_link_; }
+    auto fingerprint() const -> Fingerprint { return fingerprint_; }
     auto operator<( Tether const& other ) const -> bool;
+    /**
+     * @note Differing fingerprints short-circuit; otherwise, the anchor and chain are compared structurally.
+     */
+    auto operator==( Tether const& other ) const -> bool;
     // std::strong_ordering operator<=>( Tether const& other ) const;
 
     auto to_string() const
@@ -99,6 +108,8 @@ public:
     }
 };
 
+auto hash_value( Tether const& tether )
+    -> std::size_t;
 auto operator<<( std::ostream& os
                , kmap::view2::Tether const& tether )
     -> std::ostream&;
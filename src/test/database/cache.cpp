@@ -328,3 +328,173 @@ SCENARIO( "cache push + erase + push sequence", "[cache][db]" )
         }
     }
 }
+
+SCENARIO( "cache journals keys with deltas", "[cache][db]" )
+{
+    GIVEN( "empty cache" )
+    {
+        auto cache = Cache{};
+
+        REQUIRE( !cache.has_delta() );
+
+        GIVEN( "push n,h" )
+        {
+            auto const n = Uuid{ 1 };
+
+            REQUIRE_TRY( cache.push< NodeTable >( n ) );
+            REQUIRE_TRY( cache.push< HeadingTable >( n, "h" ) );
+
+            THEN( "only pushed keys are journaled" )
+            {
+                REQUIRE( cache.has_delta() );
+                REQUIRE( cache.delta_keys< NodeTable >().size() == 1 );
+                REQUIRE( cache.delta_keys< HeadingTable >().size() == 1 );
+                REQUIRE( cache.delta_keys< TitleTable >().empty() );
+            }
+
+            GIVEN( "erase delta-only heading" )
+            {
+                REQUIRE_TRY( cache.erase< HeadingTable >( n ) );
+
+                THEN( "heading key is retracted from journal" )
+                {
+                    REQUIRE( cache.delta_keys< HeadingTable >().empty() );
+                }
+            }
+            GIVEN( "apply_delta_to_cache" )
+            {
+                cache.apply_delta_to_cache< NodeTable >();
+                cache.apply_delta_to_cache< HeadingTable >();
+
+                THEN( "journal is empty" )
+                {
+                    REQUIRE( !cache.has_delta() );
+                }
+
+                GIVEN( "update heading" )
+                {
+                    REQUIRE_TRY( cache.push< HeadingTable >( n, "h2" ) );
+
+                    THEN( "heading key is journaled" )
+                    {
+                        REQUIRE( cache.delta_keys< HeadingTable >().contains( n ) );
+                        REQUIRE( cache.delta_keys< NodeTable >().empty() );
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO( "cache compacts delta chains of repeatedly edited keys", "[cache][db]" )
+{
+    GIVEN( "empty cache" )
+    {
+        auto cache = Cache{};
+        auto const n = Uuid{ 1 };
+
+        REQUIRE_TRY( cache.push< NodeTable >( n ) );
+
+        GIVEN( "created heading, edited repeatedly" )
+        {
+            REQUIRE_TRY( cache.push< HeadingTable >( n, "h1" ) );
+            REQUIRE_TRY( cache.push< HeadingTable >( n, "h2" ) );
+            REQUIRE_TRY( cache.push< HeadingTable >( n, "h3" ) );
+
+            THEN( "a single delta remains: created, with the latest value" )
+            {
+                auto const ds = REQUIRE_TRY( cache.fetch_deltas< HeadingTable >( n ) );
+
+                REQUIRE( ds.size() == 1 );
+                REQUIRE( ds.back().action == DeltaType::created );
+                REQUIRE( ds.back().value == "h3" );
+            }
+            GIVEN( "erase heading" )
+            {
+                REQUIRE_TRY( cache.erase< HeadingTable >( n ) );
+
+                THEN( "heading is cleared, as it was never cached" )
+                {
+                    REQUIRE( !cache.contains< HeadingTable >( n ) );
+                    REQUIRE_RFAIL( cache.fetch_deltas< HeadingTable >( n ) );
+                }
+            }
+        }
+        GIVEN( "cached heading, edited repeatedly" )
+        {
+            REQUIRE_TRY( cache.push< HeadingTable >( n, "h1" ) );
+            cache.apply_delta_to_cache< NodeTable >();
+            cache.apply_delta_to_cache< HeadingTable >();
+
+            REQUIRE_TRY( cache.push< HeadingTable >( n, "h2" ) );
+            REQUIRE_TRY( cache.push< HeadingTable >( n, "h3" ) );
+
+            THEN( "a single delta remains: changed, with the latest value" )
+            {
+                auto const ds = REQUIRE_TRY( cache.fetch_deltas< HeadingTable >( n ) );
+
+                REQUIRE( ds.size() == 1 );
+                REQUIRE( ds.back().action == DeltaType::changed );
+                REQUIRE( ds.back().value == "h3" );
+            }
+            GIVEN( "erase heading" )
+            {
+                REQUIRE_TRY( cache.erase< HeadingTable >( n ) );
+
+                THEN( "a single erased delta remains" )
+                {
+                    auto const ds = REQUIRE_TRY( cache.fetch_deltas< HeadingTable >( n ) );
+
+                    REQUIRE( ds.size() == 1 );
+                    REQUIRE( ds.back().action == DeltaType::erased );
+                    REQUIRE( !cache.contains< HeadingTable >( n ) );
+                }
+            }
+        }
+    }
+}
+
+SCENARIO( "cache values are borrowed in place", "[cache][db]" )
+{
+    GIVEN( "cached heading" )
+    {
+        auto cache = Cache{};
+        auto const n = Uuid{ 1 };
+
+        REQUIRE_TRY( cache.push< NodeTable >( n ) );
+        REQUIRE_TRY( cache.push< HeadingTable >( n, "h" ) );
+        cache.apply_delta_to_cache< NodeTable >();
+        cache.apply_delta_to_cache< HeadingTable >();
+
+        THEN( "ref refers to the cached value" )
+        {
+            std::string const& h = REQUIRE_TRY( cache.fetch_value_ref< HeadingTable >( n ) );
+
+            REQUIRE( h == "h" );
+            REQUIRE( &h == &cache.fetch< HeadingTable >().underlying().find( n )->cache_item.value() );
+        }
+        THEN( "unknown key fails" )
+        {
+            REQUIRE_RFAIL( cache.fetch_value_ref< HeadingTable >( Uuid{ 2 } ) );
+        }
+
+        GIVEN( "update heading" )
+        {
+            REQUIRE_TRY( cache.push< HeadingTable >( n, "h2" ) );
+
+            THEN( "ref refers to the latest delta" )
+            {
+                REQUIRE( REQUIRE_TRY( cache.fetch_value_ref< HeadingTable >( n ) ).get() == "h2" );
+            }
+        }
+        GIVEN( "erase heading" )
+        {
+            REQUIRE_TRY( cache.erase< HeadingTable >( n ) );
+
+            THEN( "ref fails" )
+            {
+                REQUIRE_RFAIL( cache.fetch_value_ref< HeadingTable >( n ) );
+            }
+        }
+    }
+}
@@ -5,6 +5,7 @@
  ******************************************************************************/
 #include "com/database/db.hpp"
 #include "com/database/table_decl.hpp"
+#include "com/database/util.hpp"
 #include "test/master.hpp"
 #include "test/util.hpp"
 
@@ -185,7 +186,7 @@ SCENARIO( "db interacts with disk", "[db][env]" )
                     auto rows = db.execute( select( all_of( nt ) )
                                           . from( nt )
                                           . unconditionally() );
-                    REQUIRE( rows.begin()->uuid == to_string( nid ) );
+                    REQUIRE( rows.begin()->uuid.value() == to_blob( nid ) );
                 }
             }
         }
@@ -461,7 +462,7 @@ SCENARIO( "db interacts with disk", "[db][env]" )
                     auto rows = db.execute( select( all_of( ct ) )
                                           . from( ct )
                                           . unconditionally() );
-                    REQUIRE( rows.begin()->child_uuid == to_string( n2 ) );
+                    REQUIRE( rows.begin()->child_uuid.value() == to_blob( n2 ) );
                 }
             }
         }
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * Author(s): Christopher J. Havlicek
+ *
+ * See LICENSE and CONTACTS.
+ ******************************************************************************/
+#pragma once
+#ifndef KMAP_UTIL_SHARED_VALUE_HPP
+#define KMAP_UTIL_SHARED_VALUE_HPP
+
+#include <contract.hpp>
+
+#include <memory>
+
+namespace kmap {
+
+/**
+ * @brief An immutable, reference-counted value: copies share the pointee rather than clone it.
+ * @note As the pointee can't be modified through any copy, sharing is indistinguishable from copying, as with PolymorphicValue, but O(1).
+ */
+template< typename T >
+class SharedValue
+{
+public:
+    using pointer_type = T;
+
+private:
+    std::shared_ptr< T const > ptr_ = nullptr;
+
+public:
+    SharedValue() = default;
+    SharedValue( std::unique_ptr< T >&& ptr )
+        : ptr_{ std::move( ptr ) }
+    {
+    }
+
+    auto get() const -> T const* { return ptr_.get(); }
+    auto operator*() const -> T const& { BC_ASSERT( ptr_ ); return *ptr_; }
+    auto operator->() const -> T const* { BC_ASSERT( ptr_ ); return ptr_.get(); }
+    explicit operator bool() const{ return !!ptr_; }
+    auto operator<( SharedValue const& other ) const
+    {
+        if( ptr_ && other.ptr_ )
+        {
+            return *ptr_ < *other.ptr_;
+        }
+        else
+        {
+            return ptr_ < other.ptr_;
+        }
+    }
+};
+
+} // namespace kmap
+
+#endif // KMAP_UTIL_SHARED_VALUE_HPP